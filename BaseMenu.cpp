@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "FontManager.h"
 #include "cursor_type.h"
 #include "utflib.h"
+#include "ParsedFile.h"
 
 cvar_t		*ui_showmodels;
 cvar_t		*ui_show_window_stack;
@@ -37,6 +38,11 @@ cvar_t		*ui_borderclip;
 cvar_t		*ui_prefer_won_background;
 cvar_t		*ui_background_stretch;
 cvar_t		*ui_logohorizontal;
+cvar_t		*ui_fillbatch;
+cvar_t		*ui_fillbatch_stats;
+cvar_t		*ui_maxqueries;
+cvar_t		*ui_serverhistory;
+cvar_t		*ui_serverinfo_refresh;
 
 uiStatic_t	uiStatic;
 static CMenuEntry	*s_pEntries = NULL;
@@ -287,6 +293,8 @@ int UI_DrawString( HFont font, int x, int y, int w, int h,
 	if( !string || !string[0] )
 		return x;
 
+	PROFILE_SCOPE( "UI_DrawString" );
+
 	if( flags & ETF_SHADOW )
 	{
 		shadowModulate = PackAlpha( uiColorBlack, UnpackAlpha( color ));
@@ -611,6 +619,10 @@ void UI_UpdateMenu( float flTime )
 	if( !uiStatic.initialized )
 		return;
 
+	PROFILE_FRAME();
+	PROFILE_SCOPE( "UI_UpdateMenu" );
+	UI::DrawRecord::CFrameScope drawRecordFrame;
+
 	static bool loadStuff = true;
 
 	// can't do this in Init, since these are dependent on cvar values
@@ -630,6 +642,7 @@ void UI_UpdateMenu( float flTime )
 	}
 
 	UI_DrawFinalCredits ();
+	UI::FillBatch::Flush();
 
 	// also moved opening main menu here from SetActiveMenu, so
 	// translation strings could will be loaded at this moment
@@ -646,7 +659,10 @@ void UI_UpdateMenu( float flTime )
 
 	// let's use engine credits "feature" for drawing client windows
 	if( uiStatic.client.IsActive( ))
+	{
 		uiStatic.client.Update();
+		UI::FillBatch::Flush();
+	}
 
 	if( !uiStatic.menu.IsActive( ))
 		return;
@@ -684,6 +700,7 @@ void UI_UpdateMenu( float flTime )
 	uiStatic.enableAlphaFactor = enableAlphaFactor;
 
 	uiStatic.menu.Update();
+	UI::FillBatch::Flush();
 }
 
 /*
@@ -895,15 +912,15 @@ void UI_Precache( void )
 	}
 }
 
-void UI_ParseColor( char *&pfile, unsigned int *outColor )
+void UI_ParseColor( CTokenReader &reader, unsigned int *outColor )
 {
 	int color[3] = { 0xFF, 0xFF, 0xFF };
-	char token[1024];
+	const char *token;
 
 	for( int i = 0; i < 3; i++ )
 	{
-		pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ));
-		if( !pfile ) break;
+		token = reader.Next();
+		if( !token ) break;
 		color[i] = atoi( token );
 	}
 
@@ -912,50 +929,51 @@ void UI_ParseColor( char *&pfile, unsigned int *outColor )
 
 void UI_ApplyCustomColors( void )
 {
-	char *afile = (char *)EngFuncs::COM_LoadFile( "gfx/shell/colors.lst" );
-	char *pfile = afile;
-	char token[1024];
+	const CParsedFile *file = UI_LoadParsedFile( "gfx/shell/colors.lst" );
+	const char *token;
 
-	if( !afile )
+	if( !file )
 	{
 		// not error, not warning, just notify
 		Con_Printf( "UI_ApplyCustomColors: colors.lst not found\n" );
 		return;
 	}
 
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) != NULL )
+	CTokenReader reader( file );
+
+	while(( token = reader.Next( )) != NULL )
 	{
 		if( !stricmp( token, "HELP_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiColorHelp );
+			UI_ParseColor( reader, &uiColorHelp );
 		}
 		else if( !stricmp( token, "PROMPT_BG_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiPromptBgColor );
+			UI_ParseColor( reader, &uiPromptBgColor );
 		}
 		else if( !stricmp( token, "PROMPT_TEXT_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiPromptTextColor );
+			UI_ParseColor( reader, &uiPromptTextColor );
 		}
 		else if( !stricmp( token, "PROMPT_FOCUS_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiPromptFocusColor );
+			UI_ParseColor( reader, &uiPromptFocusColor );
 		}
 		else if( !stricmp( token, "INPUT_TEXT_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiInputTextColor );
+			UI_ParseColor( reader, &uiInputTextColor );
 		}
 		else if( !stricmp( token, "INPUT_BG_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiInputBgColor );
+			UI_ParseColor( reader, &uiInputBgColor );
 		}
 		else if( !stricmp( token, "INPUT_FG_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiInputFgColor );
+			UI_ParseColor( reader, &uiInputFgColor );
 		}
 		else if( !stricmp( token, "CON_TEXT_COLOR" ))
 		{
-			UI_ParseColor( pfile, &uiColorConsole );
+			UI_ParseColor( reader, &uiColorConsole );
 		}
 	}
 
@@ -963,8 +981,6 @@ void UI_ApplyCustomColors( void )
 
 	UnpackRGB( r, g, b, uiColorConsole );
 	EngFuncs::SetConsoleDefaultColor( r, g, b );
-
-	EngFuncs::COM_FreeFile( afile );
 }
 
 static void UI_LoadBackgroundMapList( void )
@@ -972,25 +988,24 @@ static void UI_LoadBackgroundMapList( void )
 	if( !EngFuncs::FileExists( "scripts/chapterbackgrounds.txt", true ))
 		return;
 
-	char *afile = (char *)EngFuncs::COM_LoadFile( "scripts/chapterbackgrounds.txt", NULL );
-	char *pfile = afile;
-	char token[1024];
+	const CParsedFile *file = UI_LoadParsedFile( "scripts/chapterbackgrounds.txt" );
+	const char *token;
 
-	if( !afile )
+	if( !file )
 	{
 		Con_Printf( "UI_LoadBackgroundMapList: chapterbackgrounds.txt not found\n" );
 		return;
 	}
 
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) != NULL )
+	CTokenReader reader( file );
+
+	while(( token = reader.Next( )) != NULL )
 	{
 		// skip the numbers (old format list)
 		if( isdigit( token[0] )) continue;
 
 		uiStatic.bgmaps.AddToTail( token );
 	}
-
-	EngFuncs::COM_FreeFile( afile );
 }
 
 static void UI_LoadSounds( void )
@@ -1149,6 +1164,15 @@ void UI_Init( void )
 	ui_prefer_won_background = EngFuncs::CvarRegister( "ui_prefer_won_background", "0", FCVAR_ARCHIVE );
 	ui_background_stretch = EngFuncs::CvarRegister( "ui_background_stretch", "0", FCVAR_ARCHIVE );
 	ui_logohorizontal = EngFuncs::CvarRegister( "ui_logohorizontal", "0", FCVAR_ARCHIVE );
+	ui_fillbatch = EngFuncs::CvarRegister( "ui_fillbatch", "1", 0 );
+	ui_fillbatch_stats = EngFuncs::CvarRegister( "ui_fillbatch_stats", "0", 0 );
+	ui_maxqueries = EngFuncs::CvarRegister( "ui_maxqueries", "4", FCVAR_ARCHIVE );
+	ui_serverhistory = EngFuncs::CvarRegister( "ui_serverhistory", "0", FCVAR_ARCHIVE );
+	ui_serverinfo_refresh = EngFuncs::CvarRegister( "ui_serverinfo_refresh", "5", FCVAR_ARCHIVE );
+
+#ifdef MAINUI_PROFILER
+	UI::Profiler::Init();
+#endif
 
 	// show cl_predict dialog
 	EngFuncs::CvarRegister( "menu_mp_firsttime2", "1", FCVAR_ARCHIVE );
@@ -1203,6 +1227,7 @@ void UI_Shutdown( void )
 	}
 
 	UI_FreeCustomStrings();
+	UI_FlushParsedFiles();
 
 	delete uiStatic.background;
 	delete g_FontMgr;
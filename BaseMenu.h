@@ -62,6 +62,11 @@ extern cvar_t	*ui_borderclip;
 extern cvar_t	*ui_prefer_won_background;
 extern cvar_t	*ui_background_stretch;
 extern cvar_t	*ui_logohorizontal;
+extern cvar_t	*ui_fillbatch;
+extern cvar_t	*ui_fillbatch_stats;
+extern cvar_t	*ui_maxqueries;
+extern cvar_t	*ui_serverhistory;
+extern cvar_t	*ui_serverinfo_refresh;
 
 enum EUISounds
 {
@@ -19,6 +19,7 @@ GNU General Public License for more details.
 #include "BaseMenu.h"
 #include "enginecallback_menu.h"
 #include "CFGScript.h"
+#include "Tokenizer.h"
 
 #define CVAR_USERINFO BIT(1)
 
@@ -27,31 +28,69 @@ const char *cvartypes[] = { NULL, "BOOL" , "NUMBER", "LIST", "STRING" };
 
 struct parserstate_t
 {
-	parserstate_t() : buf( NULL ), filename( NULL ) { token[0] = 0;}
-	char *buf;
-	char token[MAX_STRING];
+	parserstate_t( const char *buf, const char *filename ) : tokens( buf ), filename( filename ) { token[0] = 0;}
+	CTokenizer tokens;
+	char token[MAX_STRING]; // last read or unexpected token
 	const char *filename;
 };
 
+// cvar as it's parsed, before it's added to the table
+struct scrvarparsed_t
+{
+	struct entry_t
+	{
+		char szName[MAX_STRING];
+		float flValue;
+	};
+
+	int flags;
+	char name[MAX_STRING];
+	char value[MAX_STRING];
+	char desc[MAX_STRING];
+	scrvarnumber_t number;
+	cvartype_t type;
+	CUtlVector<entry_t> entries;
+};
+
+/*
+===================
+CSCR_ReadToken
+
+Copy next token, empty at the end of file
+===================
+*/
+static void CSCR_ReadToken( parserstate_t *ps, char *out, int size )
+{
+	tokenspan_t token;
+
+	ps->tokens.Next( token );
+	token.Copy( out, size );
+}
+
 /*
 ===================
 CSCR_ExpectString
 
 Return true if next token is pExpext and skip it
+Token stays peeked on mismatch, so next check doesn't parse it again
 ===================
 */
 bool CSCR_ExpectString( parserstate_t *ps, const char *pExpect, bool skip, bool error )
 {
-	char *tmp = EngFuncs::COM_ParseFile( ps->buf, ps->token, sizeof( ps->token ));
+	tokenspan_t token;
+
+	ps->tokens.Peek( token );
 
-	if( !stricmp( ps->token, pExpect ) )
+	if( token.EqualsNoCase( pExpect ))
 	{
-		ps->buf = tmp;
+		ps->tokens.Next( token );
 		return true;
 	}
 
+	token.Copy( ps->token, sizeof( ps->token ));
+
 	if( skip )
-		ps->buf = tmp;
+		ps->tokens.Next( token );
 
 	if( error )
 		Con_DPrintf( "Syntax error in %s: got \"%s\" instead of \"%s\"\n", ps->filename, ps->token, pExpect );
@@ -87,21 +126,21 @@ cvartype_t CSCR_ParseType( parserstate_t *ps )
 CSCR_ParseSingleCvar
 =========================
 */
-bool CSCR_ParseSingleCvar( parserstate_t *ps, scrvardef_t *result )
+bool CSCR_ParseSingleCvar( parserstate_t *ps, scrvarparsed_t *result )
 {
-	// clean linked list for list
-	result->list.iCount = 0;
-	result->list.pEntries = result->list.pLast = NULL;
-	result->list.pArray = NULL;
+	// scratch is reused for every cvar
+	result->flags = 0;
+	result->number = scrvarnumber_t();
+	result->entries.RemoveAll();
 
 	// read the name
-	ps->buf = EngFuncs::COM_ParseFile( ps->buf, result->name, sizeof( result->name ));
+	CSCR_ReadToken( ps, result->name, sizeof( result->name ));
 
 	if( !CSCR_ExpectString( ps, "{", false, true ) )
 		goto error;
 
 	// read description
-	ps->buf = EngFuncs::COM_ParseFile( ps->buf, result->desc, sizeof( result->desc ));
+	CSCR_ReadToken( ps, result->desc, sizeof( result->desc ));
 
 	if( !CSCR_ExpectString( ps, "{", false, true ) )
 		goto error;
@@ -117,11 +156,11 @@ bool CSCR_ParseSingleCvar( parserstate_t *ps, scrvardef_t *result )
 		break;
 	case T_NUMBER:
 		// min
-		ps->buf = EngFuncs::COM_ParseFile( ps->buf, ps->token, sizeof( ps->token ));
+		CSCR_ReadToken( ps, ps->token, sizeof( ps->token ));
 		result->number.fMin = atof( ps->token );
 
 		// max
-		ps->buf = EngFuncs::COM_ParseFile( ps->buf, ps->token, sizeof( ps->token ));
+		CSCR_ReadToken( ps, ps->token, sizeof( ps->token ));
 		result->number.fMax = atof( ps->token );
 
 		if( !CSCR_ExpectString( ps, "}", false, true ) )
@@ -137,31 +176,21 @@ bool CSCR_ParseSingleCvar( parserstate_t *ps, scrvardef_t *result )
 			// char szName[128];
 			char *szName = ps->token;
 			char szValue[64];
-			scrvarlistentry_t *entry = 0;
 
 			// Read token for each item here
 
 			// ExpectString already moves buffer pointer, so just read from ps->token
-			// ps->buf = EngFuncs::COM_ParseFile( ps->buf, szName, sizeof( szName ));
+			// CSCR_ReadToken( ps, szName, sizeof( szName ));
 			if( !szName[0] )
 				goto error;
 
-			ps->buf = EngFuncs::COM_ParseFile( ps->buf, szValue, sizeof( szValue ));
+			CSCR_ReadToken( ps, szValue, sizeof( szValue ));
 			if( !szValue[0] )
 				goto error;
 
-			entry = new scrvarlistentry_t;
-			entry->next = NULL;
-			entry->szName = StringCopy( szName );
-			entry->flValue = atof( szValue );
-
-			if( !result->list.pEntries )
-				result->list.pEntries = entry;
-			else
-				result->list.pLast->next = entry;
-
-			result->list.pLast = entry;
-			result->list.iCount++;
+			scrvarparsed_t::entry_t &entry = result->entries[result->entries.AddToTail()];
+			Q_strncpy( entry.szName, szName, sizeof( entry.szName ));
+			entry.flValue = atof( szValue );
 		}
 		break;
 	default:
@@ -172,7 +201,7 @@ bool CSCR_ParseSingleCvar( parserstate_t *ps, scrvardef_t *result )
 		goto error;
 
 	// default value
-	ps->buf = EngFuncs::COM_ParseFile( ps->buf, result->value, sizeof( result->value ));
+	CSCR_ReadToken( ps, result->value, sizeof( result->value ));
 
 	if( !CSCR_ExpectString( ps, "}", false, true ) )
 		goto error;
@@ -183,37 +212,8 @@ bool CSCR_ParseSingleCvar( parserstate_t *ps, scrvardef_t *result )
 	if( !CSCR_ExpectString( ps, "}", false, true ) )
 		goto error;
 
-	if( result->type == T_LIST )
-	{
-		scrvarlistentry_t *entry = result->list.pEntries;
-
-		result->list.pArray = new const char*[result->list.iCount];
-		result->list.pModel = new CStringArrayModel( result->list.pArray, result->list.iCount );
-
-		for( int i = 0; entry; entry = entry->next, i++ )
-		{
-			result->list.pArray[i] = L( entry->szName );
-		}
-	}
-
 	return true;
 error:
-	if( result->type == T_LIST )
-	{
-		if( result->list.pArray )
-			delete[] result->list.pArray;
-		if( result->list.pModel )
-			delete result->list.pModel;
-
-		while( result->list.pEntries )
-		{
-			scrvarlistentry_t *next = result->list.pEntries->next;
-			delete[] result->list.pEntries->szName;
-			delete result->list.pEntries;
-
-			result->list.pEntries = next;
-		}
-	}
 	return false;
 }
 
@@ -231,7 +231,7 @@ bool CSCR_ParseHeader( parserstate_t *ps )
 
 	// Parse in the version #
 	// Get the first token.
-	ps->buf = EngFuncs::COM_ParseFile( ps->buf, ps->token, sizeof( ps->token ));
+	CSCR_ReadToken( ps, ps->token, sizeof( ps->token ));
 
 	if( atof( ps->token ) != 1 )
 	{
@@ -242,7 +242,7 @@ bool CSCR_ParseHeader( parserstate_t *ps )
 	if( !CSCR_ExpectString( ps, "DESCRIPTION", false, true ) )
 		return false;
 
-	ps->buf = EngFuncs::COM_ParseFile( ps->buf, ps->token, sizeof( ps->token ));
+	CSCR_ReadToken( ps, ps->token, sizeof( ps->token ));
 
 	if( stricmp( ps->token, "INFO_OPTIONS") && stricmp( ps->token, "SERVER_OPTIONS" ) )
 	{
@@ -256,37 +256,46 @@ bool CSCR_ParseHeader( parserstate_t *ps )
 	return true;
 }
 
+int CScriptCvarTable::AddString( const char *s )
+{
+	int len = strlen( s );
+	int offset = m_strings.AddMultipleToTail( len + 1 );
+
+	memcpy( m_strings.Base() + offset, s, len + 1 );
+	return offset;
+}
+
 /*
 ======================
-CSCR_LoadDefaultCVars
+CScriptCvarTable::Load
 
 Register all cvars declared in config file and set default values
 ======================
 */
-scrvardef_t *CSCR_LoadDefaultCVars( const char *scriptfilename, int *count )
+bool CScriptCvarTable::Load( const char *filename )
 {
 	int length = 0;
 	char *start;
-	parserstate_t state;
 	bool success = false;
-	scrvardef_t *list = 0, *last = 0;
-
-	*count = 0;
-
-	state.filename = scriptfilename;
+	scrvarparsed_t var;
+	CUtlVector<int> offsets; // of var names and descriptions, then of entry names
+	CUtlVector<int> entryOffsets;
+	tokenspan_t extra;
 
-	state.buf = (char*)EngFuncs::COM_LoadFile( scriptfilename, &length );
+	Clear();
 
-	start = state.buf;
+	start = (char*)EngFuncs::COM_LoadFile( filename, &length );
 
-	if( state.buf == 0 || length == 0)
+	if( start == 0 || length == 0)
 	{
 		if( start )
 			EngFuncs::COM_FreeFile( start );
-		return 0;
+		return false;
 	}
 
-	Con_DPrintf( "Reading config script file %s\n", scriptfilename );
+	parserstate_t state( start, filename );
+
+	Con_DPrintf( "Reading config script file %s\n", filename );
 
 	if( !CSCR_ParseHeader( &state ) )
 	{
@@ -296,33 +305,38 @@ scrvardef_t *CSCR_LoadDefaultCVars( const char *scriptfilename, int *count )
 
 	while( !CSCR_ExpectString( &state, "}", false, false ) )
 	{
-		scrvardef_t var;
+		if( !CSCR_ParseSingleCvar( &state, &var ) )
+			break;
 
-		// Create a new object
-		if( CSCR_ParseSingleCvar( &state, &var ) )
+		scrvardef_t &def = m_vars[m_vars.AddToTail()];
+
+		def.flags = var.flags;
+		def.type = var.type;
+		def.value = var.value;
+		def.number = var.number;
+		def.list.iCount = var.entries.Count();
+
+		offsets.AddToTail( AddString( var.name ));
+		offsets.AddToTail( AddString( var.desc ));
+
+		FOR_EACH_VEC( var.entries, i )
 		{
-			scrvardef_t *entry = new scrvardef_t;
-			*entry = var;
+			scrvarlistentry_t &entry = m_entries[m_entries.AddToTail()];
 
-			if( !list )
-			{
-				list = last = entry;
-			}
-			else
-			{
-				last = last->next = entry;
-			}
-			(*count)++;
+			entry.szName = NULL;
+			entry.flValue = var.entries[i].flValue;
+			entryOffsets.AddToTail( AddString( var.entries[i].szName ));
 		}
-		else
-			break;
 
-		if( *count > 1024 )
+		if( m_vars.Count() > 1024 )
 			break;
 	}
 
-	if( EngFuncs::COM_ParseFile( state.buf, state.token, sizeof( state.token )))
+	if( state.tokens.Next( extra ))
+	{
+		extra.Copy( state.token, sizeof( state.token ));
 		Con_DPrintf( "Got extra tokens!\n" );
+	}
 	else
 		success = true;
 
@@ -330,27 +344,76 @@ finish:
 	if( !success )
 	{
 		state.token[ sizeof( state.token ) - 1 ] = 0;
-		if( start && state.buf )
-			Con_DPrintf( "Parse error in %s, byte %d, token %s\n", scriptfilename, (int)( state.buf - start ), state.token );
-		else
-			Con_DPrintf( "Parse error in %s, token %s\n", scriptfilename, state.token );
+		Con_DPrintf( "Parse error in %s, byte %d, token %s\n", filename, (int)( state.tokens.Position() - start ), state.token );
+	}
+	EngFuncs::COM_FreeFile( start );
+
+	// everything is added, strings and entries don't move anymore
+	m_listNames.SetCount( m_entries.Count() );
+
+	FOR_EACH_VEC( m_entries, i )
+	{
+		m_entries[i].szName = m_strings.Base() + entryOffsets[i];
+		m_listNames[i] = L( m_entries[i].szName );
+	}
+
+	int first = 0;
+
+	FOR_EACH_VEC( m_vars, i )
+	{
+		scrvardef_t &def = m_vars[i];
+
+		def.name = m_strings.Base() + offsets[i * 2];
+		def.desc = m_strings.Base() + offsets[i * 2 + 1];
+
+		// first declaration wins, like it did with a linked list
+		if( !m_lookup.HasElement( def.name ))
+			m_lookup.Insert( def.name, i );
+
+		if( def.type == T_LIST )
+		{
+			def.list.pEntries = m_entries.Base() + first;
+			def.list.pModel = new CStringArrayModel( m_listNames.Base() + first, def.list.iCount );
+		}
+
+		first += def.list.iCount;
+	}
+
+	return m_vars.Count() > 0;
+}
+
+void CScriptCvarTable::Clear( void )
+{
+	FOR_EACH_VEC( m_vars, i )
+	{
+		if( m_vars[i].list.pModel )
+			delete m_vars[i].list.pModel;
 	}
-	if( start )
-		EngFuncs::COM_FreeFile( start );
 
-	return list;
+	m_vars.RemoveAll();
+	m_entries.RemoveAll();
+	m_listNames.RemoveAll();
+	m_strings.RemoveAll();
+	m_lookup.RemoveAll();
+}
+
+scrvardef_t *CScriptCvarTable::Find( const char *name )
+{
+	int i = m_lookup.Find( name );
+
+	return m_lookup.IsValidIndex( i ) ? &m_vars[m_lookup[i]] : NULL;
 }
 
 /*
 ======================
-CSCR_SaveToFile
+CScriptCvarTable::Save
 
 Save cvars to script file with specific formatting
 ======================
 */
-void CSCR_SaveToFile( const char *filename, const char *description, scrvardef_t *list )
+void CScriptCvarTable::Save( const char *filename, const char *description ) const
 {
-	if( !filename || !list ) return;
+	if( !filename || !Count() ) return;
 
 	CUtlString buffer;
 
@@ -413,9 +476,10 @@ void CSCR_SaveToFile( const char *filename, const char *description, scrvardef_t
 	buffer.AppendFormat( "DESCRIPTION %s\n", description );
 	buffer.AppendFormat( "{\n" );
 
-	for( scrvardef_t *var = list; var; var = var->next )
+	FOR_EACH_VEC( m_vars, i )
 	{
-		const char *currentValue = var->value;
+		const scrvardef_t *var = &m_vars[i];
+		const char *currentValue = var->value.String();
 
 		buffer.AppendFormat( "\t\"%s\"\n", var->name );
 		buffer.AppendFormat( "\t{\n" );
@@ -436,8 +500,9 @@ void CSCR_SaveToFile( const char *filename, const char *description, scrvardef_t
 			break;
 		case T_LIST:
 			buffer.AppendFormat( "\n\t\t\tLIST" );
-			for( scrvarlistentry_t *entry = var->list.pEntries; entry; entry = entry->next )
+			for( int j = 0; j < var->list.iCount; j++ )
 			{
+				const scrvarlistentry_t *entry = &var->list.pEntries[j];
 				buffer.AppendFormat( "\n\t\t\t\"%s\" \"%g\"", entry->szName, entry->flValue );
 			}
 			break;
@@ -467,32 +532,3 @@ void CSCR_SaveToFile( const char *filename, const char *description, scrvardef_t
 	
 	EngFuncs::COM_SaveFile( filename, buffer.Get(), buffer.Length() );
 }
-
-void CSCR_FreeList( scrvardef_t *list )
-{
-	scrvardef_t *i = list;
-	while( i )
-	{
-		scrvardef_t *next = i->next;
-
-		if( i->type == T_LIST )
-		{
-			if( i->list.pModel )
-				delete i->list.pModel;
-			if( i->list.pArray )
-				delete[] i->list.pArray;
-
-			while( i->list.pEntries )
-			{
-				scrvarlistentry_t *next = i->list.pEntries->next;
-				delete[] i->list.pEntries->szName;
-				delete i->list.pEntries;
-
-				i->list.pEntries = next;
-			}
-		}
-
-		delete i;
-		i = next;
-	}
-}
@@ -19,6 +19,10 @@ GNU General Public License for more details.
 #define MAX_STRING 256
 
 #include "StringArrayModel.h"
+#include "utlvector.h"
+#include "utlstring.h"
+#include "utlhashmap.h"
+#include "generichash.h"
 
 typedef enum
 {
@@ -32,22 +36,16 @@ typedef enum
 
 struct scrvarlistentry_t
 {
-	scrvarlistentry_t() : szName( NULL ), flValue( 0 ), next( NULL ) {}
-
-	char *szName;
+	const char *szName; // interned in the table
 	float flValue;
-
-	scrvarlistentry_t *next;
 };
 
 struct scrvarlist_t
 {
-	scrvarlist_t() : iCount( 0 ), pEntries( NULL ), pLast( NULL ), pArray( NULL ), pModel( NULL ) {}
+	scrvarlist_t() : iCount( 0 ), pEntries( NULL ), pModel( NULL ) {}
 
 	int iCount;
-	scrvarlistentry_t *pEntries;
-	scrvarlistentry_t *pLast;
-	const char **pArray;
+	const scrvarlistentry_t *pEntries; // in the table's flat entry array
 	CStringArrayModel *pModel; // ready model for use in UI
 };
 
@@ -61,23 +59,52 @@ struct scrvarnumber_t
 
 struct scrvardef_t
 {
-	scrvardef_t() : flags( 0 ), number(), list(), type( T_NONE ), next( NULL )
-	{
-		name[0] = value[0] = desc[0] = 0;
-	}
+	scrvardef_t() : flags( 0 ), name( NULL ), desc( NULL ), number(), list(), type( T_NONE ) {}
 
 	int flags;
-	char name[MAX_STRING];
-	char value[MAX_STRING];
-	char desc[MAX_STRING];
+	const char *name; // interned in the table
+	const char *desc;
+	CUtlString value; // changed by menus, so it's not interned
 	scrvarnumber_t number;
 	scrvarlist_t list;
 	cvartype_t type;
-	struct scrvardef_t *next;
 };
 
-scrvardef_t *CSCR_LoadDefaultCVars( const char *scriptfilename, int *count );
-void CSCR_SaveToFile( const char *filename, const char *description, scrvardef_t *list );
-void CSCR_FreeList( scrvardef_t *list );
+/*
+ * Cvars of one script file, parsed once. Vars are in one array in file
+ * order, names and descriptions are in one block of strings and list
+ * entries of all vars are in one array too. Lookup by name is a hash.
+ *
+ * Table doesn't change after loading, so pointers to vars stay valid
+ * until it's cleared or loaded again.
+ */
+class CScriptCvarTable
+{
+public:
+	CScriptCvarTable() { }
+	~CScriptCvarTable() { Clear(); }
+
+	// keeps cvars parsed before an error, returns false if there are none
+	bool Load( const char *filename );
+	void Save( const char *filename, const char *description ) const;
+	void Clear( void );
+
+	int Count( void ) const { return m_vars.Count(); }
+	scrvardef_t &operator[]( int i ) { return m_vars[i]; }
+	const scrvardef_t &operator[]( int i ) const { return m_vars[i]; }
+
+	// case insensitive like engine cvars, NULL if there is no such cvar
+	scrvardef_t *Find( const char *name );
+
+private:
+	// offset of string in m_strings, pointers are set when everything is added
+	int AddString( const char *s );
+
+	CUtlVector<scrvardef_t> m_vars;
+	CUtlVector<scrvarlistentry_t> m_entries;
+	CUtlVector<const char *> m_listNames; // localized entries for models
+	CUtlVector<char> m_strings;
+	CUtlHashMap<const char *, int, CaselessStringEqualFunctor, CaselessStringHashFunctor> m_lookup;
+};
 
 #endif // CFGSCRIPT_H
@@ -0,0 +1,172 @@
+/*
+DrawRecord.cpp -- draw call recording
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "BaseMenu.h"
+#include "DrawRecord.h"
+
+bool UI::DrawRecord::bActive = false;
+
+static CUtlVector<byte> s_buffer;
+static char s_szFilename[256];
+static int s_iFramesLeft;
+static int s_iFrame;
+static bool s_bRequested;
+
+static void WriteByte( int b )
+{
+	s_buffer.AddToTail( (byte)b );
+}
+
+static void WriteShort( int s )
+{
+	s = bound( -32768, s, 32767 );
+	WriteByte( s & 0xFF );
+	WriteByte(( s >> 8 ) & 0xFF );
+}
+
+static void WriteLong( unsigned int l )
+{
+	WriteByte( l & 0xFF );
+	WriteByte(( l >> 8 ) & 0xFF );
+	WriteByte(( l >> 16 ) & 0xFF );
+	WriteByte(( l >> 24 ) & 0xFF );
+}
+
+static void WriteRect( int x, int y, int w, int h )
+{
+	WriteShort( x );
+	WriteShort( y );
+	WriteShort( w );
+	WriteShort( h );
+}
+
+void UI::DrawRecord::BeginFrame( void )
+{
+	if( !s_bRequested )
+		return;
+
+	// start recording on frame boundary
+	if( !bActive )
+	{
+		s_buffer.RemoveAll();
+		s_buffer.AddMultipleToTail( 4, (const byte *)"MUDR" );
+		WriteLong( DRAWRECORD_VERSION );
+		s_iFrame = 0;
+		bActive = true;
+	}
+
+	WriteByte( OP_FRAME );
+	WriteLong( s_iFrame );
+}
+
+void UI::DrawRecord::EndFrame( void )
+{
+	if( !bActive )
+		return;
+
+	s_iFrame++;
+
+	if( --s_iFramesLeft > 0 )
+		return;
+
+	bActive = s_bRequested = false;
+
+	if( EngFuncs::COM_SaveFile( s_szFilename, s_buffer.Base(), s_buffer.Count( )))
+		Con_Printf( "ui_drawrecord: %d frames, %d bytes written to %s\n", s_iFrame, s_buffer.Count(), s_szFilename );
+	else
+		Con_Printf( "ui_drawrecord: can't write %s\n", s_szFilename );
+
+	s_buffer.Purge();
+}
+
+void UI::DrawRecord::Window( const char *name )
+{
+	int len = name ? Q_min( (int)strlen( name ), 255 ) : 0;
+
+	WriteByte( OP_WINDOW );
+	WriteByte( len );
+	if( len )
+		s_buffer.AddMultipleToTail( len, (const byte *)name );
+}
+
+void UI::DrawRecord::PicSet( HIMAGE hPic, int r, int g, int b, int a )
+{
+	WriteByte( OP_PIC_SET );
+	WriteLong( hPic );
+	WriteLong( PackRGBA( r & 0xFF, g & 0xFF, b & 0xFF, a & 0xFF ));
+}
+
+void UI::DrawRecord::PicDraw( int op, int x, int y, int w, int h, const wrect_t *prc )
+{
+	WriteByte( op );
+	WriteRect( x, y, w, h );
+	WriteByte( prc != NULL );
+
+	if( prc )
+	{
+		WriteShort( prc->left );
+		WriteShort( prc->right );
+		WriteShort( prc->top );
+		WriteShort( prc->bottom );
+	}
+}
+
+void UI::DrawRecord::Scissor( int x, int y, int w, int h )
+{
+	WriteByte( OP_SCISSOR );
+	WriteRect( x, y, w, h );
+}
+
+void UI::DrawRecord::NoScissor( void )
+{
+	WriteByte( OP_NOSCISSOR );
+}
+
+void UI::DrawRecord::Fill( int x, int y, int w, int h, int r, int g, int b, int a )
+{
+	WriteByte( OP_FILL );
+	WriteRect( x, y, w, h );
+	WriteLong( PackRGBA( r & 0xFF, g & 0xFF, b & 0xFF, a & 0xFF ));
+}
+
+void UI::DrawRecord::Character( int x, int y, int w, int h, int ch, int ulRGBA, HIMAGE hFont )
+{
+	WriteByte( OP_CHAR );
+	WriteRect( x, y, w, h );
+	WriteLong( ch );
+	WriteLong( ulRGBA );
+	WriteLong( hFont );
+}
+
+static void UI_DrawRecord_f( void )
+{
+	if( EngFuncs::CmdArgc() < 2 )
+	{
+		Con_Printf( "Usage: ui_drawrecord <file> [frames]\n" );
+		return;
+	}
+
+	if( s_bRequested )
+	{
+		Con_Printf( "ui_drawrecord: already recording to %s\n", s_szFilename );
+		return;
+	}
+
+	Q_strncpy( s_szFilename, EngFuncs::CmdArgv( 1 ), sizeof( s_szFilename ));
+	s_iFramesLeft = EngFuncs::CmdArgc() > 2 ? Q_max( 1, atoi( EngFuncs::CmdArgv( 2 ))) : 1;
+	s_bRequested = true;
+}
+
+ADD_COMMAND( ui_drawrecord, UI_DrawRecord_f );
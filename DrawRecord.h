@@ -0,0 +1,81 @@
+/*
+DrawRecord.h -- draw call recording
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef DRAWRECORD_H
+#define DRAWRECORD_H
+
+/*
+ * ui_drawrecord <file> [frames] -- writes every draw call that reaches the
+ * engine during next frames into the file in game directory.
+ * Compare two logs with drawdiff.py.
+ *
+ * File format, all values little endian:
+ *   "MUDR", uint32 version
+ *   records, each starts with uint8 opcode:
+ *   OP_FRAME      int32 frame
+ *   OP_WINDOW     uint8 length, name without terminator
+ *   OP_PIC_SET    int32 hPic, uint32 rgba
+ *   OP_PIC_*      int16 x, y, w, h, uint8 hasRect, [int16 left, right, top, bottom]
+ *   OP_SCISSOR    int16 x, y, w, h
+ *   OP_NOSCISSOR
+ *   OP_FILL       int16 x, y, w, h, uint32 rgba
+ *   OP_CHAR       int16 x, y, w, h, int32 ch, uint32 rgba, int32 hFont
+ *                 hFont 0 is engine console font, h is 0 then
+ */
+#define DRAWRECORD_VERSION 1
+
+namespace UI
+{
+namespace DrawRecord
+{
+enum
+{
+	OP_FRAME = 0,
+	OP_WINDOW,
+	OP_PIC_SET,
+	OP_PIC_DRAW,
+	OP_PIC_DRAWHOLES,
+	OP_PIC_DRAWTRANS,
+	OP_PIC_DRAWADDITIVE,
+	OP_SCISSOR,
+	OP_NOSCISSOR,
+	OP_FILL,
+	OP_CHAR,
+};
+
+extern bool bActive;
+
+void BeginFrame( void );
+void EndFrame( void );
+void Window( const char *name );
+
+void PicSet( HIMAGE hPic, int r, int g, int b, int a );
+void PicDraw( int op, int x, int y, int w, int h, const wrect_t *prc );
+void Scissor( int x, int y, int w, int h );
+void NoScissor( void );
+void Fill( int x, int y, int w, int h, int r, int g, int b, int a );
+void Character( int x, int y, int w, int h, int ch, int ulRGBA, HIMAGE hFont );
+
+// marks one menu frame, put at UI_UpdateMenu
+class CFrameScope
+{
+public:
+	CFrameScope() { BeginFrame(); }
+	~CFrameScope() { EndFrame(); }
+};
+}
+}
+
+#endif // DRAWRECORD_H
@@ -22,6 +22,9 @@ void EngFuncs::PIC_Set( HIMAGE hPic, int r, int g, int b, int a)
 	if( uiStatic.enableAlphaFactor )
 		a *= uiStatic.alphaFactor;
 
+	ENGFUNCS_COUNT( PIC_Set );
+	if( UI::DrawRecord::bActive )
+		UI::DrawRecord::PicSet( hPic, r, g, b, a );
 	engfuncs.pfnPIC_Set( hPic, r, g, b, a );
 }
 
@@ -30,7 +33,7 @@ void EngFuncs::FillRGBA(int x, int y, int width, int height, int r, int g, int b
 	if( uiStatic.enableAlphaFactor )
 		a *= uiStatic.alphaFactor;
 
-	engfuncs.pfnFillRGBA( x, y, width, height, r, g, b, a );
+	UI::FillBatch::AddRect( x, y, width, height, r, g, b, a );
 }
 
 void EngFuncs::DrawLogo( const char *filename, float x, float y, float width, float height )
@@ -38,15 +41,38 @@ void EngFuncs::DrawLogo( const char *filename, float x, float y, float width, fl
 	if( uiStatic.enableAlphaFactor )
 		return;
 
+	UI::FillBatch::Flush();
+	ENGFUNCS_COUNT( DrawLogo );
 	engfuncs.pfnDrawLogo( filename, x, y, width, height );
 }
 
 
 void EngFuncs::DrawCharacter(int x, int y, int width, int height, int ch, int ulRGBA, HIMAGE hFont)
 {
+	UI::FillBatch::Flush();
+	ENGFUNCS_COUNT( DrawCharacter );
+	if( UI::DrawRecord::bActive )
+		UI::DrawRecord::Character( x, y, width, height, ch, ulRGBA, hFont );
 	engfuncs.pfnDrawCharacter( x, y, width, height, ch, ulRGBA, hFont );
 }
 
+int EngFuncs::DrawConsoleCharacter( int x, int y, int ch, unsigned int color )
+{
+	char str[2] = { (char)ch, 0 };
+
+	UI::FillBatch::Flush();
+	ENGFUNCS_COUNT( DrawConsoleString );
+	engfuncs.pfnDrawSetTextColor( Red( color ), Green( color ), Blue( color ), Alpha( color ));
+
+	int width = engfuncs.pfnDrawConsoleString( x, y, str ) - x;
+
+	// size isn't known before it's drawn, nothing else is drawn in between
+	if( UI::DrawRecord::bActive )
+		UI::DrawRecord::Character( x, y, width, 0, ch, color, 0 );
+
+	return width;
+}
+
 static unsigned int color;
 
 void EngFuncs::DrawSetTextColor(int r, int g, int b, int alpha)
@@ -0,0 +1,130 @@
+/*
+FillBatch.cpp -- solid rectangle batching
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "BaseMenu.h"
+#include "FillBatch.h"
+
+#define MAX_PENDING_FILLS 64
+
+struct fillrect_t
+{
+	int x, y, w, h;
+	unsigned int color;
+
+	bool Overlaps( const fillrect_t &o ) const
+	{
+		return x < o.x + o.w && o.x < x + w && y < o.y + o.h && o.y < y + h;
+	}
+
+	// joins the other rect if union of both is a rectangle
+	// translucent rects must only touch, opaque ones may overlap
+	bool TryMerge( const fillrect_t &o )
+	{
+		if( color != o.color )
+			return false;
+
+		bool opaque = UnpackAlpha( color ) == 255;
+
+		if( x == o.x && w == o.w )
+		{
+			if( opaque ? ( o.y <= y + h && y <= o.y + o.h ) : ( o.y == y + h || y == o.y + o.h ))
+			{
+				int bottom = Q_max( y + h, o.y + o.h );
+				y = Q_min( y, o.y );
+				h = bottom - y;
+				return true;
+			}
+		}
+		else if( y == o.y && h == o.h )
+		{
+			if( opaque ? ( o.x <= x + w && x <= o.x + o.w ) : ( o.x == x + w || x == o.x + o.w ))
+			{
+				int right = Q_max( x + w, o.x + o.w );
+				x = Q_min( x, o.x );
+				w = right - x;
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+int UI::FillBatch::iPending = 0;
+
+static fillrect_t s_pending[MAX_PENDING_FILLS];
+static UI::FillBatch::stats_t s_stats;
+
+static void IssueRect( const fillrect_t &rc )
+{
+	int r, g, b, a;
+	UnpackRGBA( r, g, b, a, rc.color );
+
+	ENGFUNCS_COUNT( FillRGBA );
+	if( UI::DrawRecord::bActive )
+		UI::DrawRecord::Fill( rc.x, rc.y, rc.w, rc.h, r, g, b, a );
+	EngFuncs::engfuncs.pfnFillRGBA( rc.x, rc.y, rc.w, rc.h, r, g, b, a );
+	s_stats.issued++;
+}
+
+void UI::FillBatch::FlushPending( void )
+{
+	// reset first, so nested flushes are no-op
+	int count = iPending;
+	iPending = 0;
+
+	for( int i = 0; i < count; i++ )
+		IssueRect( s_pending[i] );
+}
+
+void UI::FillBatch::AddRect( int x, int y, int w, int h, int r, int g, int b, int a )
+{
+	fillrect_t rc;
+	rc.x = x;
+	rc.y = y;
+	rc.w = w;
+	rc.h = h;
+	rc.color = PackRGBA( r & 0xFF, g & 0xFF, b & 0xFF, a & 0xFF );
+
+	s_stats.requested++;
+
+	// degenerate or disabled, keep engine behavior as is
+	if( w <= 0 || h <= 0 || !ui_fillbatch || !ui_fillbatch->value )
+	{
+		Flush();
+		IssueRect( rc );
+		return;
+	}
+
+	// walk back through the queue while it's safe to reorder
+	for( int i = iPending - 1; i >= 0; i-- )
+	{
+		if( s_pending[i].TryMerge( rc ))
+			return;
+
+		if( s_pending[i].Overlaps( rc ))
+			break;
+	}
+
+	if( iPending == MAX_PENDING_FILLS )
+		FlushPending();
+
+	s_pending[iPending++] = rc;
+}
+
+const UI::FillBatch::stats_t &UI::FillBatch::GetStats( void )
+{
+	return s_stats;
+}
@@ -0,0 +1,50 @@
+/*
+FillBatch.h -- solid rectangle batching
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef FILLBATCH_H
+#define FILLBATCH_H
+
+namespace UI
+{
+namespace FillBatch
+{
+// Solid fills are queued instead of being sent to the engine right away.
+// Same colored rectangles that can be joined into one rectangle without
+// changing the picture are merged. Every other draw call flushes the queue
+// first, so drawing order is always preserved.
+struct stats_t
+{
+	// never reset, wrap around, only differences are meaningful
+	unsigned int requested; // FillRGBA calls made by menu code
+	unsigned int issued;    // FillRGBA calls that reached the engine
+};
+
+extern int iPending;
+
+// x, y, w, h in screen space, alpha factor must be already applied
+void AddRect( int x, int y, int w, int h, int r, int g, int b, int a );
+void FlushPending( void );
+
+inline void Flush( void )
+{
+	if( iPending )
+		FlushPending();
+}
+
+const stats_t &GetStats( void );
+}
+}
+
+#endif // FILLBATCH_H
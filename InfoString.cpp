@@ -0,0 +1,271 @@
+/*
+InfoString.cpp -- single pass info string parser
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "InfoString.h"
+
+/*
+===============
+Info_ValueForKey
+
+Searches the string for the given
+key and returns the associated value, or an empty string.
+===============
+*/
+#define MAX_KV_SIZE		128
+const char *Info_ValueForKey( const char *s, const char *key )
+{
+	char	pkey[MAX_KV_SIZE];
+	static	char value[4][MAX_KV_SIZE]; // use two buffers so compares work without stomping on each other
+	static	int valueindex;
+	int	count;
+	char	*o;
+
+	valueindex = (valueindex + 1) % 4;
+	if( *s == '\\' ) s++;
+
+	while( 1 )
+	{
+		count = 0;
+		o = pkey;
+
+		while( count < (MAX_KV_SIZE - 1) && *s != '\\' )
+		{
+			if( !*s ) return "";
+			*o++ = *s++;
+			count++;
+		}
+
+		*o = 0;
+		s++;
+
+		o = value[valueindex];
+		count = 0;
+
+		while( count < (MAX_KV_SIZE - 1) && *s && *s != '\\' )
+		{
+			if( !*s ) return "";
+			*o++ = *s++;
+			count++;
+		}
+		*o = 0;
+
+		if( !strcmp( key, pkey ))
+			return value[valueindex];
+		if( !*s ) return "";
+		s++;
+	}
+}
+
+static const infospan_t s_emptySpan = { "", 0 };
+
+bool infospan_t::Equals( const char *s ) const
+{
+	return !strncmp( str, s, len ) && s[len] == 0;
+}
+
+int infospan_t::ToInt() const
+{
+	// value is followed by a separator or terminator, so atoi stops there
+	return atoi( str );
+}
+
+float infospan_t::ToFloat() const
+{
+	return atof( str );
+}
+
+void infospan_t::Copy( char *out, size_t size ) const
+{
+	size_t n = (size_t)len < size - 1 ? (size_t)len : size - 1;
+
+	memcpy( out, str, n );
+	out[n] = 0;
+}
+
+/*
+===============
+CInfoString::LookupKey
+
+Perfect hash over length and first letter, then one compare to verify.
+Keep in sync with EKnownKey.
+===============
+*/
+CInfoString::EKnownKey CInfoString::LookupKey( const char *key, int len )
+{
+	EKnownKey known;
+	const char *name;
+
+#define KNOWN( k, n ) ( known = (k), name = (n) )
+	switch( len )
+	{
+	case 1: KNOWN( KEY_P, "p" ); break;
+	case 2: KNOWN( KEY_GS, "gs" ); break;
+	case 3: KNOWN( KEY_MAP, "map" ); break;
+	case 4: KNOWN( KEY_HOST, "host" ); break;
+	case 5:
+		switch( key[0] )
+		{
+		case 'n': KNOWN( KEY_NUMCL, "numcl" ); break;
+		case 'm': KNOWN( KEY_MAXCL, "maxcl" ); break;
+		case 'r': KNOWN( KEY_RULES, "rules" ); break;
+		default: return KEY_UNKNOWN;
+		}
+		break;
+	case 7:
+		switch( key[0] )
+		{
+		case 'g': KNOWN( KEY_GAMEDIR, "gamedir" ); break;
+		case 'p': KNOWN( KEY_PLAYERS, "players" ); break;
+		default: return KEY_UNKNOWN;
+		}
+		break;
+	case 8: KNOWN( KEY_PASSWORD, "password" ); break;
+	default: return KEY_UNKNOWN;
+	}
+#undef KNOWN
+
+	return memcmp( key, name, len ) ? KEY_UNKNOWN : known;
+}
+
+bool CInfoStringReader::Next( infospan_t &key, infospan_t &value )
+{
+	const char *s = m_s;
+
+	if( !*s )
+		return false;
+
+	key.str = s;
+	while( *s && *s != '\\' )
+		s++;
+	key.len = s - key.str;
+
+	// key without value isn't a pair, same as Info_ValueForKey
+	if( !*s )
+	{
+		m_s = s;
+		return false;
+	}
+	s++;
+
+	value.str = s;
+	while( *s && *s != '\\' )
+		s++;
+	value.len = s - value.str;
+
+	if( *s )
+		s++;
+
+	m_s = s;
+	return true;
+}
+
+bool CInfoString::Parse( const char *s )
+{
+	CInfoStringReader reader( s );
+	infospan_t key, value;
+
+	m_iCount = 0;
+
+	for( int i = 0; i < KEY_COUNT; i++ )
+		m_known[i] = -1;
+
+	while( reader.Next( key, value ))
+	{
+		if( m_iCount >= MAX_PAIRS )
+			return false;
+
+		m_pairs[m_iCount].key = key;
+		m_pairs[m_iCount].value = value;
+
+		EKnownKey known = LookupKey( key.str, key.len );
+		if( known != KEY_UNKNOWN && m_known[known] < 0 )
+			m_known[known] = m_iCount;
+
+		m_iCount++;
+	}
+
+	return true;
+}
+
+int Info_DecodePlayers( const char *s, infoplayer_t *players, int maxPlayers )
+{
+	CInfoStringReader reader( s );
+	infospan_t key, value;
+	int count = 0;
+
+	for( int i = 0; i < maxPlayers; i++ )
+	{
+		players[i].name = s_emptySpan;
+		players[i].frags = 0;
+		players[i].time = 0.0f;
+	}
+
+	while( reader.Next( key, value ))
+	{
+		// p<index><field>
+		if( key.len < 2 || key.str[0] != 'p' || key.str[1] < '0' || key.str[1] > '9' )
+		{
+			if( key.len == 7 && !memcmp( key.str, "players", 7 ))
+				count = value.ToInt();
+			continue;
+		}
+
+		int index = 0;
+		int i = 1;
+
+		// index comes from network, stop growing it once it's out of range
+		// so long numbers can't overflow it, but skip all the digits
+		for( ; i < key.len && key.str[i] >= '0' && key.str[i] <= '9'; i++ )
+		{
+			if( index < maxPlayers )
+				index = index * 10 + key.str[i] - '0';
+		}
+
+		if( index >= maxPlayers )
+			continue;
+
+		const char *field = key.str + i;
+		int len = key.len - i;
+
+		if( len == 4 && !memcmp( field, "name", 4 ))
+			players[index].name = value;
+		else if( len == 5 && !memcmp( field, "frags", 5 ))
+			players[index].frags = value.ToInt();
+		else if( len == 4 && !memcmp( field, "time", 4 ))
+			players[index].time = value.ToFloat();
+	}
+
+	return count < 0 ? 0 : count > maxPlayers ? maxPlayers : count;
+}
+
+const infospan_t &CInfoString::Value( EKnownKey key ) const
+{
+	int i = m_known[key];
+
+	return i >= 0 ? m_pairs[i].value : s_emptySpan;
+}
+
+const infospan_t &CInfoString::Value( const char *key ) const
+{
+	for( int i = 0; i < m_iCount; i++ )
+	{
+		if( m_pairs[i].key.Equals( key ))
+			return m_pairs[i].value;
+	}
+
+	return s_emptySpan;
+}
@@ -0,0 +1,119 @@
+/*
+InfoString.h -- single pass info string parser
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef INFOSTRING_H
+#define INFOSTRING_H
+
+#include <stddef.h>
+
+// legacy lookup, rescans the string on every call
+// returned value is valid until four more calls
+const char *Info_ValueForKey( const char *s, const char *key );
+
+// part of parsed string, not null terminated
+struct infospan_t
+{
+	const char *str;
+	int len;
+
+	bool IsEmpty() const { return len == 0; }
+	bool Equals( const char *s ) const;
+	int  ToInt() const;
+	float ToFloat() const;
+	void Copy( char *out, size_t size ) const;
+};
+
+// walks \key\value pairs without storing them, so there is no limit on count
+class CInfoStringReader
+{
+public:
+	CInfoStringReader( const char *s ) : m_s( *s == '\\' ? s + 1 : s ) { }
+
+	// returns false at the end, key without value isn't a pair
+	bool Next( infospan_t &key, infospan_t &value );
+
+private:
+	const char *m_s;
+};
+
+// player list response, \players\N\p0name\...\p0frags\...\p0time\...
+struct infoplayer_t
+{
+	infospan_t name;
+	int frags;
+	float time;
+};
+
+// fills players by their index in one pass, missing fields are empty
+// returns player count, never more than maxPlayers
+int Info_DecodePlayers( const char *s, infoplayer_t *players, int maxPlayers );
+
+/*
+ * Splits \key\value\key\value string into spans once, without copying.
+ * Keys the menu cares about are recognized during parsing, so getting
+ * them is just an array lookup. Source string must outlive the parser.
+ */
+class CInfoString
+{
+public:
+	enum EKnownKey
+	{
+		KEY_UNKNOWN = -1,
+		KEY_P = 0,   // protocol
+		KEY_GS,
+		KEY_MAP,
+		KEY_HOST,
+		KEY_NUMCL,
+		KEY_MAXCL,
+		KEY_RULES,
+		KEY_GAMEDIR,
+		KEY_PLAYERS,
+		KEY_PASSWORD,
+		KEY_COUNT
+	};
+
+	enum { MAX_PAIRS = 256 };
+
+	CInfoString() : m_iCount( 0 ) { }
+	CInfoString( const char *s ) { Parse( s ); }
+
+	// returns false if string had more than MAX_PAIRS pairs, rest is ignored
+	bool Parse( const char *s );
+
+	int Count() const { return m_iCount; }
+	const infospan_t &Key( int i ) const { return m_pairs[i].key; }
+	const infospan_t &Value( int i ) const { return m_pairs[i].value; }
+
+	// empty span if key is missing
+	const infospan_t &Value( EKnownKey key ) const;
+
+	// for keys not in EKnownKey, walks the pairs
+	const infospan_t &Value( const char *key ) const;
+
+	static EKnownKey LookupKey( const char *key, int len );
+
+private:
+	struct pair_t
+	{
+		infospan_t key;
+		infospan_t value;
+	};
+
+	pair_t m_pairs[MAX_PAIRS];
+	int m_iCount;
+	short m_known[KEY_COUNT]; // index in m_pairs or -1
+};
+
+#endif // INFOSTRING_H
@@ -18,6 +18,8 @@ GNU General Public License for more details.
 #include "BaseMenu.h"
 #include "Utils.h"
 #include "MenuStrings.h"
+#include "ParsedFile.h"
+#include "Tokenizer.h"
 #include "utlhashmap.h"
 #include "generichash.h"
 #include "utflib.h"
@@ -313,10 +315,23 @@ static void ByteSwapUTF16File( uint16_t *head, size_t len )
 		head[i] = Swap16( head[i] );
 }
 
+static bool Localize_ExpectToken( CTokenizer &tokens, const char *filename, const char *expect, const char *error )
+{
+	tokenspan_t token;
+	char got[64];
+
+	if( tokens.Next( token ) && token.EqualsNoCase( expect ))
+		return true;
+
+	token.Copy( got, sizeof( got ));
+	Con_Printf( "Localize_AddToDict( %s ): %s, got %s\n", filename, error, got );
+	return false;
+}
+
 static void Localize_AddToDictionary( const char *name, const char *lang )
 {
 	char filename[64], token[4096];
-	char *pfile, *afile = nullptr, *pFileBuf;
+	char *afile = nullptr, *pFileBuf;
 	int i = 0, buflen, charlen;
 	bool isUtf16 = false;
 
@@ -380,65 +395,35 @@ static void Localize_AddToDictionary( const char *name, const char *lang )
 			afile += 3;
 	}
 
-	pfile = afile;
-
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ));
-
-	if( stricmp( token, "lang" ))
 	{
-		Con_Printf( "Localize_AddToDict( %s ): invalid header, got %s", filename, token );
-		goto error;
-	}
+		CTokenizer tokens( afile );
+		tokenspan_t key, value;
 
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-
-	if( strcmp( token, "{" ))
-	{
-		Con_Printf( "Localize_AddToDict( %s ): want {, got %s", filename, token );
-		goto error;
-	}
-
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-
-	if( stricmp( token, "Language" ))
-	{
-		Con_Printf( "Localize_AddToDict( %s ): want Language, got %s", filename, token );
-		goto error;
-	}
-
-	// skip language actual name
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-
-	if( stricmp( token, "Tokens" ))
-	{
-		Con_Printf( "Localize_AddToDict( %s ): want Tokens, got %s", filename, token );
-		goto error;
-	}
+		if( !Localize_ExpectToken( tokens, filename, "lang", "invalid header" ) ||
+			!Localize_ExpectToken( tokens, filename, "{", "want {" ) ||
+			!Localize_ExpectToken( tokens, filename, "Language", "want Language" ))
+			goto error;
 
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
+		// skip language actual name
+		tokens.Next( key );
 
-	if( strcmp( token, "{" ))
-	{
-		Con_Printf( "Localize_AddToDict( %s ): want { after Tokens, got %s", filename, token );
-		goto error;
-	}
+		if( !Localize_ExpectToken( tokens, filename, "Tokens", "want Tokens" ) ||
+			!Localize_ExpectToken( tokens, filename, "{", "want { after Tokens" ))
+			goto error;
 
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))))
-	{
-		if( !strcmp( token, "}" ))
-			break;
+		while( tokens.Next( key ))
+		{
+			if( key.Equals( "}" ))
+				break;
 
-		char szLocString[4096];
-		pfile = EngFuncs::COM_ParseFile( pfile, szLocString, sizeof( szLocString ));
+			if( !tokens.Next( value ) || value.Equals( "}" ))
+				break;
 
-		if( !strcmp( szLocString, "}" ))
-			break;
+			char szLocString[4096];
 
-		if( pfile )
-		{
 			// Con_DPrintf("New token: %s %s\n", token, szLocString );
+			key.Copy( token, sizeof( token ));
+			value.Copy( szLocString, sizeof( szLocString ));
 			Localize_ProcessString( token, token );
 			Localize_ProcessString( szLocString, szLocString );
 			Dictionary_Insert( token, szLocString );
@@ -520,15 +505,15 @@ static void Localize_Free( void )
 
 void UI_LoadCustomStrings( void )
 {
-	char *afile = (char *)EngFuncs::COM_LoadFile( "gfx/shell/strings.lst", NULL );
-	char *pfile = afile;
-	char token[1024];
+	const CParsedFile *file = UI_LoadParsedFile( "gfx/shell/strings.lst" );
+	CTokenReader reader( file );
+	const char *token;
 	int string_num;
 
-	if( !afile )
+	if( !file )
 		goto localize_init;
 
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) != NULL )
+	while(( token = reader.Next( )) != NULL )
 	{
 		if( isdigit( token[0] ))
 		{
@@ -542,12 +527,12 @@ void UI_LoadCustomStrings( void )
 		else continue; // invalid declaration ?
 
 		// parse new string
-		pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ));
+		token = reader.Next();
+		if( !token ) break;
+
 		MenuStrings[string_num] = StringCopy( token ); // replace default string with custom
 	}
 
-	EngFuncs::COM_FreeFile( afile );
-
 localize_init:
 	Localize_Init();
 }
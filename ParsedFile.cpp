@@ -0,0 +1,212 @@
+/*
+ParsedFile.cpp -- cache of tokenized text files
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "extdll_menu.h"
+#include "BaseMenu.h"
+#include "ParsedFile.h"
+#include "Tokenizer.h"
+
+#define MAX_PARSED_FILES 16
+#define MAX_PARSED_BYTES ( 1024 * 1024 ) // tokens of all files together
+
+class CParsedFileCache
+{
+public:
+	CParsedFileCache() : m_iUseCounter( 0 ), m_iHits( 0 ), m_iMisses( 0 ) { }
+	~CParsedFileCache() { Flush(); }
+
+	const CParsedFile *Load( const char *path );
+	void Invalidate( const char *path );
+	void Flush( void );
+	void PrintStats( void ) const;
+
+private:
+	int Find( const char *path ) const;
+	int Bytes( void ) const;
+	void Evict( void );
+	static void Parse( CParsedFile *file, const char *text );
+
+	CUtlVector<CParsedFile *> m_files;
+	int m_iUseCounter;
+	int m_iHits;
+	int m_iMisses;
+};
+
+static CParsedFileCache s_ParsedFiles;
+
+int CParsedFileCache::Find( const char *path ) const
+{
+	FOR_EACH_VEC( m_files, i )
+	{
+		if( !stricmp( m_files[i]->m_path.String(), path ))
+			return i;
+	}
+
+	return -1;
+}
+
+int CParsedFileCache::Bytes( void ) const
+{
+	int bytes = 0;
+
+	FOR_EACH_VEC( m_files, i )
+		bytes += m_files[i]->m_text.Count() + m_files[i]->m_offsets.Count() * sizeof( int );
+
+	return bytes;
+}
+
+/*
+=================
+CParsedFileCache::Evict
+
+Drops least recently used files until there is a place for new one.
+=================
+*/
+void CParsedFileCache::Evict( void )
+{
+	while( m_files.Count() && ( m_files.Count() >= MAX_PARSED_FILES || Bytes() > MAX_PARSED_BYTES ))
+	{
+		int oldest = 0;
+
+		FOR_EACH_VEC( m_files, i )
+		{
+			if( m_files[i]->m_iLastUse < m_files[oldest]->m_iLastUse )
+				oldest = i;
+		}
+
+		delete m_files[oldest];
+		m_files.FastRemove( oldest );
+	}
+}
+
+void CParsedFileCache::Parse( CParsedFile *file, const char *text )
+{
+	CTokenizer tokens( text );
+	tokenspan_t token;
+
+	while( tokens.Next( token ))
+	{
+		int offset = file->m_text.AddMultipleToTail( token.len + 1 );
+		int len = token.Copy( file->m_text.Base() + offset, token.len + 1 );
+
+		// resolved escapes make it shorter
+		file->m_text.SetCount( offset + len + 1 );
+		file->m_offsets.AddToTail( offset );
+	}
+}
+
+const CParsedFile *CParsedFileCache::Load( const char *path )
+{
+	int i = Find( path );
+
+	if( i >= 0 )
+	{
+		m_iHits++;
+		m_files[i]->m_iLastUse = ++m_iUseCounter;
+		return m_files[i]->m_bMissing ? NULL : m_files[i];
+	}
+
+	m_iMisses++;
+	Evict();
+
+	CParsedFile *file = new CParsedFile;
+	char *text = (char *)EngFuncs::COM_LoadFile( path );
+
+	file->m_path = path;
+	file->m_bMissing = text == NULL;
+	file->m_iLastUse = ++m_iUseCounter;
+
+	if( text )
+	{
+		Parse( file, text );
+		EngFuncs::COM_FreeFile( text );
+	}
+
+	m_files.AddToTail( file );
+
+	return file->m_bMissing ? NULL : file;
+}
+
+void CParsedFileCache::Invalidate( const char *path )
+{
+	int i = Find( path );
+
+	if( i < 0 )
+		return;
+
+	delete m_files[i];
+	m_files.FastRemove( i );
+}
+
+void CParsedFileCache::Flush( void )
+{
+	FOR_EACH_VEC( m_files, i )
+		delete m_files[i];
+
+	m_files.RemoveAll();
+}
+
+void CParsedFileCache::PrintStats( void ) const
+{
+	int total = m_iHits + m_iMisses;
+
+	Con_Printf( "%i files, %i bytes of tokens\n", m_files.Count(), Bytes() );
+	Con_Printf( "%i hits, %i misses, %.1f%% hit rate\n", m_iHits, m_iMisses, total ? m_iHits * 100.0f / total : 0.0f );
+
+	FOR_EACH_VEC( m_files, i )
+	{
+		const CParsedFile *file = m_files[i];
+
+		if( file->m_bMissing )
+			Con_Printf( "  %s: missing\n", file->m_path.String() );
+		else Con_Printf( "  %s: %i tokens\n", file->m_path.String(), file->Count() );
+	}
+}
+
+const CParsedFile *UI_LoadParsedFile( const char *path )
+{
+	return s_ParsedFiles.Load( path );
+}
+
+void UI_InvalidateParsedFile( const char *path )
+{
+	s_ParsedFiles.Invalidate( path );
+}
+
+void UI_FlushParsedFiles( void )
+{
+	s_ParsedFiles.Flush();
+}
+
+/*
+=================
+UI_ParsedFiles_f
+
+Prints cache hit rate, "flush" argument drops everything,
+for files edited while the game is running.
+=================
+*/
+static void UI_ParsedFiles_f( void )
+{
+	if( EngFuncs::CmdArgc() > 1 && !stricmp( EngFuncs::CmdArgv( 1 ), "flush" ))
+	{
+		UI_FlushParsedFiles();
+		return;
+	}
+
+	s_ParsedFiles.PrintStats();
+}
+
+ADD_COMMAND( menu_parsedfiles, UI_ParsedFiles_f );
@@ -0,0 +1,75 @@
+/*
+ParsedFile.h -- cache of tokenized text files
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef PARSEDFILE_H
+#define PARSEDFILE_H
+
+#include "utlvector.h"
+#include "utlstring.h"
+
+// text file split into tokens by COM_ParseFile rules, all tokens in one buffer
+class CParsedFile
+{
+public:
+	int Count( void ) const { return m_offsets.Count(); }
+	const char *Token( int i ) const { return m_text.Base() + m_offsets[i]; }
+
+private:
+	friend class CParsedFileCache;
+
+	CUtlString m_path;
+	CUtlVector<char> m_text;
+	CUtlVector<int> m_offsets;
+	bool m_bMissing; // file couldn't be loaded, remembered too
+	int m_iLastUse;
+};
+
+// walks tokens the same way COM_ParseFile loop walks the text, NULL file has no tokens
+class CTokenReader
+{
+public:
+	CTokenReader( const CParsedFile *file ) : m_pFile( file ), m_iPos( 0 ) { }
+
+	// NULL at the end of file, where COM_ParseFile would return NULL
+	const char *Next( void )
+	{
+		return m_pFile && m_iPos < m_pFile->Count() ? m_pFile->Token( m_iPos++ ) : NULL;
+	}
+
+	// next token without moving past it
+	const char *Peek( void ) const
+	{
+		return m_pFile && m_iPos < m_pFile->Count() ? m_pFile->Token( m_iPos ) : NULL;
+	}
+
+private:
+	const CParsedFile *m_pFile;
+	int m_iPos;
+};
+
+/*
+ * Tokens of recently used files are kept until the menu is unloaded,
+ * so windows and models reading the same lists again don't load and
+ * parse them again. Engine doesn't tell file time or size without
+ * loading it, so files that change while the game is running must be
+ * invalidated by who changes them.
+ *
+ * Returns NULL if file doesn't exist. Result is valid until next call.
+ */
+const CParsedFile *UI_LoadParsedFile( const char *path );
+void UI_InvalidateParsedFile( const char *path );
+void UI_FlushParsedFiles( void );
+
+#endif // PARSEDFILE_H
@@ -0,0 +1,380 @@
+/*
+Profiler.cpp -- frame time and engine call profiler
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifdef MAINUI_PROFILER
+
+#include "BaseMenu.h"
+#include "Profiler.h"
+#include "con_nprint.h"
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define MAX_PROFILE_FRAMES   128
+#define MAX_PROFILE_EVENTS   512 // per frame
+#define MAX_ENGINE_COUNTERS  128
+#define PROFILE_SUMMARY_ROWS 8
+
+using namespace UI::Profiler;
+
+struct profevent_t
+{
+	const char *name;
+	int depth;
+	double start, end;
+};
+
+struct profframe_t
+{
+	int number;
+	double start, end;
+
+	int numEvents;
+	profevent_t events[MAX_PROFILE_EVENTS];
+
+	int numCounters;
+	int counts[MAX_ENGINE_COUNTERS];
+};
+
+static profframe_t s_frames[MAX_PROFILE_FRAMES];
+static int s_iFrameNumber; // total frames seen, current slot is s_iFrameNumber % MAX_PROFILE_FRAMES
+static int s_iDepth;
+
+// overloaded wrappers have own counters, but share the slot
+static CEngineCallCounter *s_pCounters;
+static const char *s_szCounterNames[MAX_ENGINE_COUNTERS];
+static int s_iNumCounters;
+
+static cvar_t *ui_profile_show;
+
+static double Profiler_Time( void )
+{
+#if defined _WIN32
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER counter;
+
+	if( !freq.QuadPart )
+		QueryPerformanceFrequency( &freq );
+
+	QueryPerformanceCounter( &counter );
+	return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static inline profframe_t &CurrentFrame( void )
+{
+	return s_frames[s_iFrameNumber % MAX_PROFILE_FRAMES];
+}
+
+CEngineCallCounter::CEngineCallCounter( const char *name ) :
+	m_szName( name ), m_iIndex( -1 ), m_iCount( 0 ), m_pNext( s_pCounters )
+{
+	s_pCounters = this;
+
+	for( int i = 0; i < s_iNumCounters; i++ )
+	{
+		if( !strcmp( s_szCounterNames[i], name ))
+		{
+			m_iIndex = i;
+			return;
+		}
+	}
+
+	if( s_iNumCounters < MAX_ENGINE_COUNTERS )
+	{
+		m_iIndex = s_iNumCounters++;
+		s_szCounterNames[m_iIndex] = name;
+	}
+}
+
+CProfileScope::CProfileScope( const char *name ) : m_iEvent( -1 )
+{
+	profframe_t &frame = CurrentFrame();
+
+	if( frame.numEvents < MAX_PROFILE_EVENTS )
+	{
+		m_iEvent = frame.numEvents++;
+
+		profevent_t &ev = frame.events[m_iEvent];
+		ev.name = name ? name : "unnamed";
+		ev.depth = s_iDepth;
+		ev.start = ev.end = Profiler_Time();
+	}
+
+	s_iDepth++;
+}
+
+CProfileScope::~CProfileScope()
+{
+	s_iDepth--;
+
+	if( m_iEvent >= 0 )
+		CurrentFrame().events[m_iEvent].end = Profiler_Time();
+}
+
+static void Profiler_DrawSummary( const profframe_t &frame )
+{
+	con_nprint_t con;
+	con.index = 0;
+	con.time_to_live = 0.01f;
+	con.color[0] = con.color[1] = con.color[2] = 1.0f;
+
+	double total = 0.0, worst = 0.0;
+	// slot after this frame is reset next, so it's never counted,
+	// same frames as ui_profile_dump would write
+	int numFrames = Q_min( s_iFrameNumber + 1, MAX_PROFILE_FRAMES - 1 );
+
+	for( int i = s_iFrameNumber - numFrames + 1; i <= s_iFrameNumber; i++ )
+	{
+		const profframe_t &f = s_frames[i % MAX_PROFILE_FRAMES];
+		double t = f.end - f.start;
+		total += t;
+		worst = Q_max( worst, t );
+	}
+
+	Con_NXPrintf( &con, "mainui frame: %.3f ms (avg %.3f, max %.3f over %d)\n",
+		( frame.end - frame.start ) * 1000.0, total / numFrames * 1000.0, worst * 1000.0, numFrames );
+
+	for( int i = 0; i < frame.numEvents && con.index < PROFILE_SUMMARY_ROWS; i++ )
+	{
+		const profevent_t &ev = frame.events[i];
+
+		if( ev.depth > 2 )
+			continue;
+
+		con.index++;
+		Con_NXPrintf( &con, "%*s%s: %.3f ms\n", ev.depth * 2, "", ev.name, ( ev.end - ev.start ) * 1000.0 );
+	}
+
+	// pick few most called engine functions
+	int calls = 0;
+	int shown[PROFILE_SUMMARY_ROWS];
+	int numShown = 0;
+
+	for( int i = 0; i < frame.numCounters; i++ )
+		calls += frame.counts[i];
+
+	con.index++;
+	Con_NXPrintf( &con, "engine calls: %d\n", calls );
+
+	while( numShown < PROFILE_SUMMARY_ROWS )
+	{
+		int best = -1;
+
+		for( int i = 0; i < frame.numCounters; i++ )
+		{
+			if( !frame.counts[i] )
+				continue;
+
+			bool skip = false;
+			for( int j = 0; j < numShown; j++ )
+			{
+				if( shown[j] == i )
+					skip = true;
+			}
+
+			if( !skip && ( best < 0 || frame.counts[i] > frame.counts[best] ))
+				best = i;
+		}
+
+		if( best < 0 )
+			break;
+
+		shown[numShown++] = best;
+
+		con.index++;
+		Con_NXPrintf( &con, "  %s: %d\n", s_szCounterNames[best], frame.counts[best] );
+	}
+}
+
+CProfileFrame::CProfileFrame()
+{
+	CurrentFrame().start = Profiler_Time();
+}
+
+CProfileFrame::~CProfileFrame()
+{
+	profframe_t &frame = CurrentFrame();
+
+	frame.number = s_iFrameNumber;
+	frame.end = Profiler_Time();
+	frame.numCounters = s_iNumCounters;
+	memset( frame.counts, 0, sizeof( frame.counts ));
+
+	for( CEngineCallCounter *c = s_pCounters; c; c = c->m_pNext )
+	{
+		if( c->m_iIndex >= 0 )
+			frame.counts[c->m_iIndex] += c->m_iCount;
+		c->m_iCount = 0;
+	}
+
+	if( ui_profile_show && ui_profile_show->value )
+		Profiler_DrawSummary( frame );
+
+	// anything recorded between frames (VidInit, input events)
+	// goes to the next one
+	s_iFrameNumber++;
+
+	profframe_t &next = CurrentFrame();
+	next.numEvents = 0;
+	next.numCounters = 0;
+	next.start = next.end = frame.end;
+}
+
+static void Profiler_AppendEscaped( CUtlString &out, const char *str )
+{
+	for( const char *p = str; *p; p++ )
+	{
+		if( *p == '"' || *p == '\\' )
+			out.AppendFormat( "\\%c", *p );
+		else if( (byte)*p < ' ' )
+			continue;
+		else out.AppendFormat( "%c", *p );
+	}
+}
+
+static void Profiler_WriteCSV( CUtlString &out, int first, int last )
+{
+	out.Append( "frame,type,name,depth,start_ms,duration_ms,count\n" );
+
+	for( int i = first; i <= last; i++ )
+	{
+		const profframe_t &frame = s_frames[i % MAX_PROFILE_FRAMES];
+		double base = s_frames[first % MAX_PROFILE_FRAMES].start;
+
+		out.AppendFormat( "%d,frame,,0,%.4f,%.4f,\n", frame.number,
+			( frame.start - base ) * 1000.0, ( frame.end - frame.start ) * 1000.0 );
+
+		for( int j = 0; j < frame.numEvents; j++ )
+		{
+			const profevent_t &ev = frame.events[j];
+
+			out.AppendFormat( "%d,scope,\"", frame.number );
+			Profiler_AppendEscaped( out, ev.name );
+			out.AppendFormat( "\",%d,%.4f,%.4f,\n", ev.depth,
+				( ev.start - base ) * 1000.0, ( ev.end - ev.start ) * 1000.0 );
+		}
+
+		for( int j = 0; j < frame.numCounters; j++ )
+		{
+			if( frame.counts[j] )
+				out.AppendFormat( "%d,engine,%s,,,,%d\n", frame.number, s_szCounterNames[j], frame.counts[j] );
+		}
+	}
+}
+
+static void Profiler_WriteTrace( CUtlString &out, int first, int last )
+{
+	double base = s_frames[first % MAX_PROFILE_FRAMES].start;
+	bool comma = false;
+
+	out.Append( "{\"traceEvents\":[\n" );
+
+	for( int i = first; i <= last; i++ )
+	{
+		const profframe_t &frame = s_frames[i % MAX_PROFILE_FRAMES];
+
+		if( comma ) out.Append( ",\n" );
+		out.AppendFormat( "{\"name\":\"frame %d\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f}",
+			frame.number, ( frame.start - base ) * 1e6, ( frame.end - frame.start ) * 1e6 );
+		comma = true;
+
+		for( int j = 0; j < frame.numEvents; j++ )
+		{
+			const profevent_t &ev = frame.events[j];
+
+			out.Append( ",\n{\"name\":\"" );
+			Profiler_AppendEscaped( out, ev.name );
+			out.AppendFormat( "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f}",
+				( ev.start - base ) * 1e6, ( ev.end - ev.start ) * 1e6 );
+		}
+
+		out.AppendFormat( ",\n{\"name\":\"engine calls\",\"ph\":\"C\",\"pid\":1,\"ts\":%.1f,\"args\":{",
+			( frame.start - base ) * 1e6 );
+
+		bool argComma = false;
+		for( int j = 0; j < frame.numCounters; j++ )
+		{
+			if( !frame.counts[j] )
+				continue;
+
+			out.AppendFormat( "%s\"%s\":%d", argComma ? "," : "", s_szCounterNames[j], frame.counts[j] );
+			argComma = true;
+		}
+		out.Append( "}}" );
+	}
+
+	out.Append( "\n]}\n" );
+}
+
+static void Profiler_Dump_f( void )
+{
+	// one slot is always the current frame, it's not finished
+	int recorded = Q_min( s_iFrameNumber, MAX_PROFILE_FRAMES - 1 );
+	int numFrames = recorded;
+	bool json = false;
+
+	if( EngFuncs::CmdArgc() > 1 )
+		numFrames = bound( 1, atoi( EngFuncs::CmdArgv( 1 )), recorded );
+
+	if( EngFuncs::CmdArgc() > 2 )
+		json = !stricmp( EngFuncs::CmdArgv( 2 ), "json" );
+
+	if( !numFrames )
+	{
+		Con_Printf( "ui_profile_dump: no frames recorded\n" );
+		return;
+	}
+
+	// last finished frame is the one before the current slot
+	int last = s_iFrameNumber - 1;
+	int first = last - numFrames + 1;
+
+	CUtlString out;
+	const char *filename;
+
+	if( json )
+	{
+		Profiler_WriteTrace( out, first, last );
+		filename = "mainui_profile.json";
+	}
+	else
+	{
+		Profiler_WriteCSV( out, first, last );
+		filename = "mainui_profile.csv";
+	}
+
+	if( EngFuncs::COM_SaveFile( filename, out.Get(), out.Length( )))
+		Con_Printf( "ui_profile_dump: %d frames written to %s\n", numFrames, filename );
+	else
+		Con_Printf( "ui_profile_dump: can't write %s\n", filename );
+}
+
+ADD_COMMAND( ui_profile_dump, Profiler_Dump_f );
+
+void UI::Profiler::Init( void )
+{
+	ui_profile_show = EngFuncs::CvarRegister( "ui_profile_show", "0", 0 );
+}
+
+#endif // MAINUI_PROFILER
@@ -0,0 +1,89 @@
+/*
+Profiler.h -- frame time and engine call profiler
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/*
+ * Enabled by MAINUI_PROFILER define, otherwise all macros below are empty.
+ *
+ * PROFILE_FRAME()           -- marks one menu frame, put at UI_UpdateMenu
+ * PROFILE_SCOPE( name )     -- times enclosing scope, name must outlive the frame ring
+ * ENGFUNCS_COUNT( name )    -- counts call of engine function, used by EngFuncs wrappers
+ *
+ * Commands and cvars:
+ * ui_profile_dump [frames] [csv|json] -- dump last frames to mainui_profile.csv or
+ *                                        mainui_profile.json (Chrome trace format)
+ * ui_profile_show 1                    -- on-screen summary of the last frame
+ */
+#ifdef MAINUI_PROFILER
+
+namespace UI
+{
+namespace Profiler
+{
+class CEngineCallCounter
+{
+public:
+	CEngineCallCounter( const char *name );
+
+	void Hit( void ) { m_iCount++; }
+
+	const char *m_szName;
+	int m_iIndex;
+	int m_iCount; // in current frame
+	CEngineCallCounter *m_pNext;
+};
+
+class CProfileScope
+{
+public:
+	CProfileScope( const char *name );
+	~CProfileScope();
+
+private:
+	int m_iEvent;
+};
+
+class CProfileFrame
+{
+public:
+	CProfileFrame();
+	~CProfileFrame();
+};
+
+void Init( void );
+}
+}
+
+#define PROFILE_CONCAT2( a, b ) a ## b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT2( a, b )
+
+#define PROFILE_FRAME() \
+	UI::Profiler::CProfileFrame PROFILE_CONCAT( profileFrame, __LINE__ )
+#define PROFILE_SCOPE( name ) \
+	UI::Profiler::CProfileScope PROFILE_CONCAT( profileScope, __LINE__ )( name )
+#define ENGFUNCS_COUNT( name ) \
+	do { static UI::Profiler::CEngineCallCounter counter( #name ); counter.Hit(); } while( 0 )
+
+#else // MAINUI_PROFILER
+
+#define PROFILE_FRAME()
+#define PROFILE_SCOPE( name )
+#define ENGFUNCS_COUNT( name )
+
+#endif // MAINUI_PROFILER
+
+#endif // PROFILER_H
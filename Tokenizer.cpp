@@ -0,0 +1,233 @@
+/*
+Tokenizer.cpp -- in-place text tokenizer with COM_ParseFile rules
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include <string.h>
+#include "Tokenizer.h"
+
+// character at i with \" resolved, moves past it
+static inline char TokenChar( const tokenspan_t &token, int &i )
+{
+	char c = token.str[i++];
+
+	if( token.escaped && c == '\\' && i < token.len && token.str[i] == '"' )
+		c = token.str[i++];
+
+	return c;
+}
+
+static inline char LowerChar( char c )
+{
+	return c >= 'A' && c <= 'Z' ? c + 'a' - 'A' : c;
+}
+
+bool tokenspan_t::Equals( const char *s ) const
+{
+	int i = 0;
+
+	while( i < len )
+	{
+		if( TokenChar( *this, i ) != *s++ )
+			return false;
+	}
+
+	return *s == 0;
+}
+
+bool tokenspan_t::EqualsNoCase( const char *s ) const
+{
+	int i = 0;
+
+	while( i < len )
+	{
+		if( LowerChar( TokenChar( *this, i )) != LowerChar( *s++ ))
+			return false;
+	}
+
+	return *s == 0;
+}
+
+int tokenspan_t::Copy( char *out, size_t size ) const
+{
+	int n = 0;
+
+	if( !size )
+		return 0;
+
+	if( !escaped )
+	{
+		n = (size_t)len < size - 1 ? len : (int)size - 1;
+		memcpy( out, str, n );
+		out[n] = 0;
+		return n;
+	}
+
+	const char *p = str, *end = str + len;
+
+	// copy runs between backslashes at once
+	while( p < end && (size_t)n < size - 1 )
+	{
+		const char *slash = (const char *)memchr( p, '\\', end - p );
+		int run = ( slash ? slash : end ) - p;
+
+		if( (size_t)( n + run ) > size - 1 )
+			run = (int)size - 1 - n;
+
+		memcpy( out + n, p, run );
+		n += run;
+		p += run;
+
+		if( p < end && (size_t)n < size - 1 )
+		{
+			// \" is a quote, other backslashes stay
+			if( p + 1 < end && p[1] == '"' )
+				p++;
+			out[n++] = *p++;
+		}
+	}
+
+	out[n] = 0;
+	return n;
+}
+
+enum
+{
+	CHAR_SPACE   = ( 1 << 0 ), // and the terminator
+	CHAR_BRACKET = ( 1 << 1 ), // {}()'
+	CHAR_COLON   = ( 1 << 2 ),
+	CHAR_COMMA   = ( 1 << 3 )
+};
+
+static unsigned char s_charClass[256];
+
+static void InitCharClasses( void )
+{
+	for( int i = 0; i <= ' '; i++ )
+		s_charClass[i] = CHAR_SPACE;
+
+	s_charClass[(int)'{'] = s_charClass[(int)'}'] = CHAR_BRACKET;
+	s_charClass[(int)'('] = s_charClass[(int)')'] = CHAR_BRACKET;
+	s_charClass[(int)'\''] = CHAR_BRACKET;
+	s_charClass[(int)':'] = CHAR_COLON;
+	s_charClass[(int)','] = CHAR_COMMA;
+}
+
+CTokenizer::CTokenizer( const char *data, int flags ) :
+	m_pData( data ), m_pPeekEnd( NULL ), m_bPeeked( false ), m_bPeekResult( false )
+{
+	if( !s_charClass[0] )
+		InitCharClasses();
+
+	m_iSingleChars = CHAR_COMMA;
+
+	if( !( flags & PFILE_IGNOREBRACKET ))
+		m_iSingleChars |= CHAR_BRACKET;
+
+	if( flags & PFILE_HANDLECOLON )
+		m_iSingleChars |= CHAR_COLON;
+
+	m_bHashComments = !( flags & PFILE_IGNOREHASHCMT );
+}
+
+/*
+=================
+CTokenizer::Parse
+
+Keep in sync with engine's COM_ParseFileSafe: whitespace is anything
+up to space, // and # comments run to the end of line, \" in quotes
+is a quote and unterminated quotes end with the text.
+=================
+*/
+bool CTokenizer::Parse( const char *&data, tokenspan_t &token ) const
+{
+	int c;
+
+	token.str = data;
+	token.len = 0;
+	token.quoted = token.escaped = false;
+
+	if( !data )
+		return false;
+
+	while( true )
+	{
+		// skip whitespace
+		while(( c = (unsigned char)*data ) <= ' ' )
+		{
+			if( !c )
+			{
+				token.str = data;
+				return false;
+			}
+
+			data++;
+		}
+
+		if(( c == '/' && data[1] == '/' ) || ( c == '#' && m_bHashComments ))
+		{
+			while( *data && *data != '\n' )
+				data++;
+			continue;
+		}
+
+		break;
+	}
+
+	if( c == '"' )
+	{
+		const char *quote;
+
+		token.str = ++data;
+		token.quoted = true;
+
+		// backslash never pairs with one before it,
+		// so every quote right after it is escaped
+		while(( quote = strchr( data, '"' )) != NULL && quote > token.str && quote[-1] == '\\' )
+		{
+			token.escaped = true;
+			data = quote + 1;
+		}
+
+		if( !quote )
+		{
+			// unexpected end of text, the rest is the token
+			data += strlen( data );
+			token.len = data - token.str;
+			return true;
+		}
+
+		token.len = quote - token.str;
+		data = quote + 1;
+		return true;
+	}
+
+	token.str = data;
+
+	if( s_charClass[c] & m_iSingleChars )
+	{
+		token.len = 1;
+		data++;
+		return true;
+	}
+
+	int stop = CHAR_SPACE | m_iSingleChars;
+
+	do
+	{
+		data++;
+	} while( !( s_charClass[(unsigned char)*data] & stop ));
+
+	token.len = data - token.str;
+	return true;
+}
@@ -0,0 +1,98 @@
+/*
+Tokenizer.h -- in-place text tokenizer with COM_ParseFile rules
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h>
+
+// same as engine flags for COM_ParseFileSafe
+#ifndef PFILE_IGNOREBRACKET
+#define PFILE_IGNOREBRACKET (1<<0)
+#define PFILE_HANDLECOLON   (1<<1)
+#define PFILE_IGNOREHASHCMT (1<<2)
+#endif
+
+// token in the parsed text, not null terminated
+struct tokenspan_t
+{
+	const char *str;
+	int len;
+	bool quoted;  // was in quotes, so "}" isn't a brace
+	bool escaped; // has \" inside, compared and copied as "
+
+	bool Equals( const char *s ) const;
+	bool EqualsNoCase( const char *s ) const;
+
+	// cuts to size like COM_ParseFile does, returns copied length
+	int Copy( char *out, size_t size ) const;
+};
+
+/*
+ * Splits text into tokens same way as engine's COM_ParseFile, but
+ * returns spans of the text instead of copying every token, and it's
+ * not a call to the engine per token. Text must outlive the tokenizer.
+ *
+ * Peeked token is kept, so checking what comes next and then taking
+ * it parses it once.
+ */
+class CTokenizer
+{
+public:
+	CTokenizer( const char *data, int flags = 0 );
+
+	// returns false at the end of text, where COM_ParseFile returns NULL,
+	// token is empty then
+	bool Next( tokenspan_t &token )
+	{
+		if( !m_bPeeked )
+			return Parse( m_pData, token );
+
+		m_bPeeked = false;
+		m_pData = m_pPeekEnd;
+		token = m_peeked;
+		return m_bPeekResult;
+	}
+
+	// next token without moving past it
+	bool Peek( tokenspan_t &token )
+	{
+		if( !m_bPeeked )
+		{
+			m_pPeekEnd = m_pData;
+			m_bPeekResult = Parse( m_pPeekEnd, m_peeked );
+			m_bPeeked = true;
+		}
+
+		token = m_peeked;
+		return m_bPeekResult;
+	}
+
+	// where text not taken yet starts, for error messages
+	const char *Position() const { return m_pData; }
+
+private:
+	bool Parse( const char *&data, tokenspan_t &token ) const;
+
+	const char *m_pData;
+	const char *m_pPeekEnd;
+	tokenspan_t m_peeked;
+	int m_iSingleChars; // character classes that are tokens by themselves
+	bool m_bHashComments;
+	bool m_bPeeked;
+	bool m_bPeekResult;
+};
+
+#endif // TOKENIZER_H
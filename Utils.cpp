@@ -204,60 +204,6 @@ void COM_FileBase( const char *in, char *out, size_t size )
 	out[len] = 0;
 }
 
-/*
-===============
-Info_ValueForKey
-
-Searches the string for the given
-key and returns the associated value, or an empty string.
-===============
-*/
-#define MAX_KV_SIZE		128
-const char *Info_ValueForKey( const char *s, const char *key )
-{
-	char	pkey[MAX_KV_SIZE];
-	static	char value[4][MAX_KV_SIZE]; // use two buffers so compares work without stomping on each other
-	static	int valueindex;
-	int	count;
-	char	*o;
-
-	valueindex = (valueindex + 1) % 4;
-	if( *s == '\\' ) s++;
-
-	while( 1 )
-	{
-		count = 0;
-		o = pkey;
-
-		while( count < (MAX_KV_SIZE - 1) && *s != '\\' )
-		{
-			if( !*s ) return "";
-			*o++ = *s++;
-			count++;
-		}
-
-		*o = 0;
-		s++;
-
-		o = value[valueindex];
-		count = 0;
-
-		while( count < (MAX_KV_SIZE - 1) && *s && *s != '\\' )
-		{
-			if( !*s ) return "";
-			*o++ = *s++;
-			count++;
-		}
-		*o = 0;
-
-		if( !strcmp( key, pkey ))
-			return value[valueindex];
-		if( !*s ) return "";
-		s++;
-	}
-}
-
-
 /*
 ===================
 Key_GetKey
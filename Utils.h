@@ -21,6 +21,7 @@ GNU General Public License for more details.
 #include "FontManager.h"
 #include "BMPUtils.h"
 #include "miniutl.h"
+#include "InfoString.h"
 
 //
 // How did I ever live without ASSERT?
@@ -125,6 +126,24 @@ inline unsigned int InterpColor( const unsigned int from, const unsigned int to,
 		InterpVal( Alpha( from ), Alpha( to ), frac ) );
 }
 
+// changed values in server lists are highlighted and fade to normal color
+#define FLASH_FADE_TIME 1.5f // seconds
+
+inline unsigned int FlashColor( const bool better )
+{
+	return better ? PackRGB( 64, 255, 64 ) : PackRGB( 255, 64, 64 );
+}
+
+// returns false when flash has faded out
+inline bool FadeFlashColor( const float age, const unsigned int flash, const unsigned int normal, unsigned int &color )
+{
+	if( age < 0.0f || age >= FLASH_FADE_TIME )
+		return false;
+
+	color = InterpColor( flash, normal, age / FLASH_FADE_TIME );
+	return true;
+}
+
 inline float RemapVal( const float val, const float A, const float B, const float C, const float D)
 {
 	return C + (D - C) * (val - A) / (B - A);
@@ -137,7 +156,6 @@ int colorstrcmp( const char *a, const char *b );
 int ColorStrlen( const char *str );	// returns string length without color symbols
 void COM_FileBase( const char *in, char *out, size_t size );
 int UI_FadeAlpha( int starttime, int endtime );
-const char *Info_ValueForKey( const char *s, const char *key );
 int KEY_GetKey( const char *binding );			// ripped out from engine
 char *StringCopy( const char *input );			// copy string into new memory
 void Com_EscapeCommand( char *newCommand, const char *oldCommand, int len );
@@ -78,6 +78,8 @@ void CWindowStack::Update( )
 	if( !IsActive() )
 		return;
 
+	PROFILE_SCOPE( "CWindowStack::Update" );
+
 	CUtlVector<CMenuBaseWindow *> drawList( 16 );
 	CUtlVector<int> removeList( 16 );
 
@@ -88,7 +90,10 @@ void CWindowStack::Update( )
 
 	FOR_EACH_LL_BACK( stack, i )
 	{
-		stack[i]->Think(); // any window must think
+		{
+			PROFILE_SCOPE( stack[i]->szName );
+			stack[i]->Think(); // any window must think
+		}
 
 		if( i == active )
 			continue; // will be added last
@@ -155,6 +160,19 @@ void CWindowStack::Update( )
 		stack.Remove( removeList[j] );
 	}
 
+	const UI::FillBatch::stats_t &fills = UI::FillBatch::GetStats();
+	bool showFills = ui_fillbatch_stats && ui_fillbatch_stats->value;
+	con_nprint_t fillsCon;
+
+	if( showFills )
+	{
+		fillsCon.index = ui_show_window_stack && ui_show_window_stack->value ? stack.Count() + 2 : 0;
+		fillsCon.time_to_live = 0.01f;
+		fillsCon.color[0] = fillsCon.color[1] = fillsCon.color[2] = 1.0f;
+
+		Con_NXPrintf( &fillsCon, "Fills (requested -> issued):\n" );
+	}
+
 	FOR_EACH_VEC_BACK( drawList, k )
 	{
 		CMenuBaseWindow *window = drawList[k];
@@ -166,7 +184,26 @@ void CWindowStack::Update( )
 		}
 
 		if( !window->eTransitionType )
-			drawList[k]->Draw();
+		{
+			unsigned int requested = fills.requested;
+			unsigned int issued = fills.issued;
+
+			if( UI::DrawRecord::bActive )
+				UI::DrawRecord::Window( window->szName );
+
+			{
+				PROFILE_SCOPE( window->szName );
+				drawList[k]->Draw();
+				UI::FillBatch::Flush();
+			}
+
+			if( showFills )
+			{
+				fillsCon.index++;
+				Con_NXPrintf( &fillsCon, "%s: %u -> %u\n", window->szName,
+					fills.requested - requested, fills.issued - issued );
+			}
+		}
 
 		if( k != drawList.Count() - 1 )
 		{
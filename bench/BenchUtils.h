@@ -0,0 +1,45 @@
+/*
+BenchUtils.h -- helpers shared by benchmarks
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef BENCHUTILS_H
+#define BENCHUTILS_H
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// monotonic time in seconds
+static inline double Bench_Time( void )
+{
+#if defined _WIN32
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER counter;
+
+	if( !freq.QuadPart )
+		QueryPerformanceFrequency( &freq );
+
+	QueryPerformanceCounter( &counter );
+	return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+#endif // BENCHUTILS_H
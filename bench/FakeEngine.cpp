@@ -0,0 +1,1289 @@
+/*
+FakeEngine.cpp -- headless engine interface for mainui_bench
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include <stdarg.h>
+#include <sys/stat.h>
+#include "FakeEngine.h"
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fnmatch.h>
+#endif
+
+#define MAX_FAKE_CVARS    1024
+#define MAX_FAKE_COMMANDS 512
+#define MAX_FAKE_PICS     4096
+#define MAX_FAKE_FILES    8192
+#define MAX_FAKE_ARGS     32
+#define MAX_FAKE_KEYS     256
+#define DEFAULT_PIC_SIZE  64
+
+static fakeconfig_t s_config;
+static fakestats_t s_stats;
+static ui_globalvars_t s_globals;
+static double s_flTime;
+
+#define COUNT( call ) ( s_stats.calls[call]++ )
+
+/*
+=================
+console
+=================
+*/
+static void Fake_Con_Printf( const char *fmt, ... )
+{
+	va_list va;
+
+	COUNT( CALL_OTHER );
+
+	if( !s_config.verbose )
+		return;
+
+	va_start( va, fmt );
+	vprintf( fmt, va );
+	va_end( va );
+}
+
+static void Fake_Con_NPrintf( int pos, const char *fmt, ... )
+{
+	COUNT( CALL_OTHER );
+}
+
+static void Fake_Con_NXPrintf( struct con_nprint_s *info, const char *fmt, ... )
+{
+	COUNT( CALL_OTHER );
+}
+
+static void Fake_HostError( const char *fmt, ... )
+{
+	va_list va;
+
+	va_start( va, fmt );
+	fprintf( stderr, "Host_Error: " );
+	vfprintf( stderr, fmt, va );
+	va_end( va );
+
+	exit( 1 );
+}
+
+/*
+=================
+images
+
+no real textures, only handles and sizes
+=================
+*/
+struct fakepic_t
+{
+	char name[256];
+	int width, height;
+};
+
+static fakepic_t s_pics[MAX_FAKE_PICS];
+static int s_numPics;
+
+static int ReadLittleLong( const byte *p )
+{
+	return p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | ( p[3] << 24 );
+}
+
+static void Fake_ImageSize( const byte *buf, int size, int *width, int *height )
+{
+	*width = *height = DEFAULT_PIC_SIZE;
+
+	if( !buf )
+		return;
+
+	if( size >= 26 && buf[0] == 'B' && buf[1] == 'M' )
+	{
+		*width = ReadLittleLong( buf + 18 );
+		*height = abs( ReadLittleLong( buf + 22 ));
+	}
+	else if( size >= 18 && buf[2] >= 1 && buf[2] <= 11 ) // probably TGA
+	{
+		*width = buf[12] | ( buf[13] << 8 );
+		*height = buf[14] | ( buf[15] << 8 );
+	}
+}
+
+static byte *Fake_ReadFile( const char *filename, int *pLength );
+
+static HIMAGE Fake_PIC_Load( const char *szPicName, const byte *ucRawImage, int ulRawImageSize, int flags )
+{
+	COUNT( CALL_PIC_LOAD );
+
+	if( !szPicName || !szPicName[0] )
+		return 0;
+
+	for( int i = 0; i < s_numPics; i++ )
+	{
+		if( !stricmp( s_pics[i].name, szPicName ))
+			return i + 1;
+	}
+
+	if( s_numPics >= MAX_FAKE_PICS )
+		return 0;
+
+	fakepic_t &pic = s_pics[s_numPics];
+	snprintf( pic.name, sizeof( pic.name ), "%s", szPicName );
+
+	if( ucRawImage )
+	{
+		Fake_ImageSize( ucRawImage, ulRawImageSize, &pic.width, &pic.height );
+	}
+	else
+	{
+		int len = 0;
+		byte *buf = Fake_ReadFile( szPicName, &len );
+
+		Fake_ImageSize( buf, len, &pic.width, &pic.height );
+		free( buf );
+	}
+
+	return ++s_numPics;
+}
+
+static void Fake_PIC_Free( const char *szPicName )
+{
+	COUNT( CALL_PIC_LOAD );
+}
+
+static int Fake_PIC_Width( HIMAGE hPic )
+{
+	COUNT( CALL_PIC_OTHER );
+	return hPic > 0 && hPic <= s_numPics ? s_pics[hPic - 1].width : 0;
+}
+
+static int Fake_PIC_Height( HIMAGE hPic )
+{
+	COUNT( CALL_PIC_OTHER );
+	return hPic > 0 && hPic <= s_numPics ? s_pics[hPic - 1].height : 0;
+}
+
+static void Fake_PIC_Set( HIMAGE hPic, int r, int g, int b, int a )
+{
+	COUNT( CALL_PIC_OTHER );
+}
+
+static void Fake_PIC_Draw( int x, int y, int width, int height, const wrect_t *prc )
+{
+	COUNT( CALL_PIC_DRAW );
+}
+
+static void Fake_PIC_EnableScissor( int x, int y, int width, int height )
+{
+	COUNT( CALL_SCISSOR );
+}
+
+static void Fake_PIC_DisableScissor( void )
+{
+	COUNT( CALL_SCISSOR );
+}
+
+static void Fake_FillRGBA( int x, int y, int width, int height, int r, int g, int b, int a )
+{
+	COUNT( CALL_FILL );
+}
+
+/*
+=================
+cvars
+=================
+*/
+static cvar_t *s_cvars[MAX_FAKE_CVARS];
+static int s_numCvars;
+
+static cvar_t *Fake_FindCvar( const char *szName )
+{
+	for( int i = 0; i < s_numCvars; i++ )
+	{
+		if( !strcmp( s_cvars[i]->name, szName ))
+			return s_cvars[i];
+	}
+
+	return NULL;
+}
+
+static void Fake_SetCvarString( cvar_t *cvar, const char *szValue )
+{
+	free( cvar->string );
+	cvar->string = strdup( szValue ? szValue : "" );
+	cvar->value = atof( cvar->string );
+}
+
+static cvar_t *Fake_RegisterVariable( const char *szName, const char *szValue, int flags )
+{
+	COUNT( CALL_CVAR );
+
+	cvar_t *cvar = Fake_FindCvar( szName );
+	if( cvar )
+	{
+		cvar->flags |= flags;
+		return cvar;
+	}
+
+	if( s_numCvars >= MAX_FAKE_CVARS )
+		Fake_HostError( "too many cvars\n" );
+
+	cvar = (cvar_t *)calloc( 1, sizeof( *cvar ));
+	cvar->name = strdup( szName );
+	cvar->flags = flags;
+	Fake_SetCvarString( cvar, szValue );
+
+	s_cvars[s_numCvars++] = cvar;
+	return cvar;
+}
+
+static float Fake_GetCvarFloat( const char *szName )
+{
+	COUNT( CALL_CVAR );
+
+	cvar_t *cvar = Fake_FindCvar( szName );
+	return cvar ? cvar->value : 0.0f;
+}
+
+static const char *Fake_GetCvarString( const char *szName )
+{
+	COUNT( CALL_CVAR );
+
+	cvar_t *cvar = Fake_FindCvar( szName );
+	return cvar ? cvar->string : "";
+}
+
+static void Fake_CvarSetString( const char *szName, const char *szValue )
+{
+	COUNT( CALL_CVAR );
+
+	cvar_t *cvar = Fake_FindCvar( szName );
+
+	// engine would complain, we just create it
+	if( !cvar )
+		cvar = Fake_RegisterVariable( szName, szValue, 0 );
+	else Fake_SetCvarString( cvar, szValue );
+}
+
+static void Fake_CvarSetValue( const char *szName, float flValue )
+{
+	char buf[64];
+
+	if( flValue == (int)flValue )
+		snprintf( buf, sizeof( buf ), "%d", (int)flValue );
+	else snprintf( buf, sizeof( buf ), "%f", flValue );
+
+	Fake_CvarSetString( szName, buf );
+}
+
+static int Fake_IsCvarReadOnly( const char *name )
+{
+	COUNT( CALL_CVAR );
+	return Fake_FindCvar( name ) ? 0 : -1;
+}
+
+/*
+=================
+commands
+=================
+*/
+struct fakecmd_t
+{
+	char *name;
+	void (*function)( void );
+};
+
+static fakecmd_t s_commands[MAX_FAKE_COMMANDS];
+static int s_numCommands;
+
+static char s_argvBuf[MAX_FAKE_ARGS][256];
+static const char *s_argv[MAX_FAKE_ARGS];
+static char s_args[1024];
+static int s_argc;
+
+static int Fake_AddCommand( const char *cmd_name, void (*function)( void ))
+{
+	COUNT( CALL_OTHER );
+
+	for( int i = 0; i < s_numCommands; i++ )
+	{
+		if( !strcmp( s_commands[i].name, cmd_name ))
+		{
+			s_commands[i].function = function;
+			return 1;
+		}
+	}
+
+	if( s_numCommands >= MAX_FAKE_COMMANDS )
+		return 0;
+
+	s_commands[s_numCommands].name = strdup( cmd_name );
+	s_commands[s_numCommands].function = function;
+	s_numCommands++;
+
+	return 1;
+}
+
+static void Fake_DelCommand( const char *cmd_name )
+{
+	COUNT( CALL_OTHER );
+
+	for( int i = 0; i < s_numCommands; i++ )
+	{
+		if( !strcmp( s_commands[i].name, cmd_name ))
+		{
+			free( s_commands[i].name );
+			s_commands[i] = s_commands[--s_numCommands];
+			return;
+		}
+	}
+}
+
+static int Fake_CmdArgc( void )
+{
+	COUNT( CALL_OTHER );
+	return s_argc;
+}
+
+static const char *Fake_CmdArgv( int argc )
+{
+	COUNT( CALL_OTHER );
+	return argc >= 0 && argc < s_argc ? s_argv[argc] : "";
+}
+
+static const char *Fake_Cmd_Args( void )
+{
+	COUNT( CALL_OTHER );
+	return s_args;
+}
+
+static void Fake_TokenizeCommand( const char *text )
+{
+	const char *p = text;
+
+	s_argc = 0;
+	s_args[0] = 0;
+
+	while( *p && s_argc < MAX_FAKE_ARGS )
+	{
+		while( *p && (byte)*p <= ' ' )
+			p++;
+
+		if( !*p )
+			break;
+
+		if( s_argc == 1 )
+			snprintf( s_args, sizeof( s_args ), "%s", p );
+
+		char *out = s_argvBuf[s_argc];
+		int len = 0;
+
+		if( *p == '"' )
+		{
+			p++;
+			while( *p && *p != '"' )
+			{
+				if( len < (int)sizeof( s_argvBuf[0] ) - 1 )
+					out[len++] = *p;
+				p++;
+			}
+
+			if( *p == '"' )
+				p++;
+		}
+		else
+		{
+			while( *p && (byte)*p > ' ' )
+			{
+				if( len < (int)sizeof( s_argvBuf[0] ) - 1 )
+					out[len++] = *p;
+				p++;
+			}
+		}
+
+		out[len] = 0;
+		s_argv[s_argc] = out;
+		s_argc++;
+	}
+}
+
+bool Fake_ExecuteCommand( const char *cmd )
+{
+	Fake_TokenizeCommand( cmd );
+
+	if( !s_argc )
+		return false;
+
+	for( int i = 0; i < s_numCommands; i++ )
+	{
+		if( !strcmp( s_commands[i].name, s_argv[0] ))
+		{
+			s_commands[i].function();
+			return true;
+		}
+	}
+
+	// not menu command, like "connect" or "internetservers"
+	if( s_config.verbose )
+		printf( "ignored engine command: %s\n", cmd );
+
+	return false;
+}
+
+static void Fake_ClientCmd( int execute_now, const char *szCmdString )
+{
+	char line[1024];
+	const char *p = szCmdString;
+
+	COUNT( CALL_OTHER );
+
+	// split into separate commands
+	while( *p )
+	{
+		int len = 0;
+		bool quoted = false;
+
+		for( ; *p; p++ )
+		{
+			if( *p == '"' )
+				quoted = !quoted;
+			else if( *p == '\n' || ( *p == ';' && !quoted ))
+				break;
+
+			if( len < (int)sizeof( line ) - 1 )
+				line[len++] = *p;
+		}
+
+		line[len] = 0;
+		Fake_ExecuteCommand( line );
+
+		if( *p )
+			p++;
+	}
+}
+
+/*
+=================
+files
+
+everything is served from the data directory
+=================
+*/
+static bool Fake_BuildPath( const char *filename, char *path, size_t size )
+{
+	if( !filename || strstr( filename, ".." ))
+		return false;
+
+	snprintf( path, size, "%s/%s", s_config.dataDir, filename );
+	return true;
+}
+
+static byte *Fake_ReadFile( const char *filename, int *pLength )
+{
+	char path[512];
+	FILE *f;
+	long len;
+	byte *buf;
+
+	if( pLength )
+		*pLength = 0;
+
+	if( !Fake_BuildPath( filename, path, sizeof( path )))
+		return NULL;
+
+	if( !( f = fopen( path, "rb" )))
+		return NULL;
+
+	fseek( f, 0, SEEK_END );
+	len = ftell( f );
+	fseek( f, 0, SEEK_SET );
+
+	buf = (byte *)malloc( len + 1 );
+	if( fread( buf, 1, len, f ) != (size_t)len )
+	{
+		free( buf );
+		fclose( f );
+		return NULL;
+	}
+
+	buf[len] = 0;
+	fclose( f );
+
+	if( pLength )
+		*pLength = (int)len;
+
+	return buf;
+}
+
+static byte *Fake_COM_LoadFile( const char *filename, int *pLength )
+{
+	COUNT( CALL_FILE );
+	return Fake_ReadFile( filename, pLength );
+}
+
+static void Fake_COM_FreeFile( void *buffer )
+{
+	COUNT( CALL_FILE );
+	free( buffer );
+}
+
+static int Fake_COM_SaveFile( const char *filename, const void *data, int len )
+{
+	char path[512];
+	FILE *f;
+
+	COUNT( CALL_FILE );
+
+	// never write into data directory, benchmark must not change it
+	if( !s_config.outputDir )
+		return 1;
+
+	if( !filename || strstr( filename, ".." ))
+		return 0;
+
+	snprintf( path, sizeof( path ), "%s/%s", s_config.outputDir, filename );
+
+	if( !( f = fopen( path, "wb" )))
+		return 0;
+
+	fwrite( data, 1, len, f );
+	fclose( f );
+
+	return 1;
+}
+
+static int Fake_COM_RemoveFile( const char *filepath )
+{
+	COUNT( CALL_FILE );
+	return 1;
+}
+
+static int Fake_FileExists( const char *filename, int gamedironly )
+{
+	char path[512];
+	struct stat st;
+
+	COUNT( CALL_FILE );
+
+	if( !Fake_BuildPath( filename, path, sizeof( path )))
+		return 0;
+
+	return stat( path, &st ) == 0;
+}
+
+static void Fake_GetGameDir( char *szGetGameDir )
+{
+	COUNT( CALL_FILE );
+	strcpy( szGetGameDir, "valve" );
+}
+
+static char *s_files[MAX_FAKE_FILES];
+static int s_numFiles;
+
+static void Fake_AddFile( const char *name )
+{
+	if( s_numFiles < MAX_FAKE_FILES )
+		s_files[s_numFiles++] = strdup( name );
+}
+
+static char **Fake_GetFilesList( const char *pattern, int *numFiles, int gamedironly )
+{
+	char dir[512], path[512];
+	const char *mask;
+
+	COUNT( CALL_FILE );
+
+	// engine keeps the list until next call
+	for( int i = 0; i < s_numFiles; i++ )
+		free( s_files[i] );
+	s_numFiles = 0;
+
+	if( !stricmp( pattern, "save/*.sav" ) && s_config.numSaves > 0 )
+	{
+		for( int i = 0; i < s_config.numSaves; i++ )
+		{
+			snprintf( path, sizeof( path ), "save/bench%04d.sav", i );
+			Fake_AddFile( path );
+		}
+
+		*numFiles = s_numFiles;
+		return s_files;
+	}
+
+	snprintf( dir, sizeof( dir ), "%s", pattern );
+
+	char *slash = strrchr( dir, '/' );
+	if( slash )
+	{
+		*slash = 0;
+		mask = pattern + ( slash - dir ) + 1;
+	}
+	else
+	{
+		dir[0] = 0;
+		mask = pattern;
+	}
+
+	Fake_BuildPath( dir, path, sizeof( path ));
+
+#if defined _WIN32
+	WIN32_FIND_DATAA data;
+	char search[512];
+
+	snprintf( search, sizeof( search ), "%s/%s", path, mask );
+
+	HANDLE h = FindFirstFileA( search, &data );
+	if( h != INVALID_HANDLE_VALUE )
+	{
+		do
+		{
+			snprintf( path, sizeof( path ), "%s%s%s", dir, dir[0] ? "/" : "", data.cFileName );
+			Fake_AddFile( path );
+		} while( FindNextFileA( h, &data ));
+
+		FindClose( h );
+	}
+#else
+	DIR *d = opendir( path );
+	if( d )
+	{
+		struct dirent *ent;
+
+		while(( ent = readdir( d )))
+		{
+			if( ent->d_name[0] == '.' || fnmatch( mask, ent->d_name, FNM_CASEFOLD ))
+				continue;
+
+			snprintf( path, sizeof( path ), "%s%s%s", dir, dir[0] ? "/" : "", ent->d_name );
+			Fake_AddFile( path );
+		}
+
+		closedir( d );
+	}
+#endif
+
+	*numFiles = s_numFiles;
+	return s_files;
+}
+
+static int Fake_SaveIndex( const char *filename )
+{
+	int index;
+
+	if( sscanf( filename, "save/bench%d.sav", &index ) == 1 )
+		return index;
+
+	return -1;
+}
+
+static int Fake_GetSaveComment( const char *savename, char *comment )
+{
+	int index = Fake_SaveIndex( savename );
+
+	COUNT( CALL_FILE );
+
+	if( index < 0 )
+	{
+		comment[0] = 0;
+		return 0;
+	}
+
+	// title, time, date and elapsed time at fixed offsets, like engine does
+	memset( comment, 0, CS_SIZE + CS_TIME * 3 );
+	snprintf( comment, CS_SIZE, "[%s]Black Mesa Inbound #%d", index % 7 ? "" : "autosave", index );
+	snprintf( comment + CS_SIZE, CS_TIME, "%02d:%02d", index / 60 % 24, index % 60 );
+	snprintf( comment + CS_SIZE + CS_TIME, CS_TIME, "%02d/%02d/26", index % 28 + 1, index % 12 + 1 );
+	snprintf( comment + CS_SIZE + CS_TIME * 2, CS_TIME, "%dh %02dm", index / 60, index % 60 );
+
+	return 1;
+}
+
+static int Fake_GetDemoComment( const char *demoname, char *comment )
+{
+	COUNT( CALL_FILE );
+	comment[0] = 0;
+	return 0;
+}
+
+static int Fake_CompareFileTime( const char *filename1, const char *filename2, int *iCompare )
+{
+	int a = Fake_SaveIndex( filename1 ), b = Fake_SaveIndex( filename2 );
+
+	COUNT( CALL_FILE );
+
+	// synthesized saves get older with index
+	*iCompare = a < b ? 1 : a > b ? -1 : 0;
+	return 1;
+}
+
+/*
+=================
+text parser, follows engine's COM_ParseFileSafe
+=================
+*/
+static bool Fake_IsSingleChar( char c, unsigned int flags )
+{
+	if( c == '{' || c == '}' || c == '\'' || c == ',' )
+		return true;
+
+	if( !( flags & PFILE_IGNOREBRACKET ) && ( c == ')' || c == '(' ))
+		return true;
+
+	if( ( flags & PFILE_HANDLECOLON ) && c == ':' )
+		return true;
+
+	return false;
+}
+
+static char *Fake_ParseFile( char *data, char *token, const int size, unsigned int flags, int *plen )
+{
+	int len = 0;
+	int c;
+
+	COUNT( CALL_FILE );
+
+	if( !token || !size )
+	{
+		if( plen ) *plen = 0;
+		return NULL;
+	}
+
+	token[0] = 0;
+
+	if( !data )
+	{
+		if( plen ) *plen = 0;
+		return NULL;
+	}
+
+skipwhite:
+	while(( c = (byte)*data ) <= ' ' )
+	{
+		if( c == 0 )
+		{
+			if( plen ) *plen = 0;
+			return NULL;
+		}
+		data++;
+	}
+
+	// skip // and # comments
+	if(( c == '/' && data[1] == '/' ) || ( c == '#' && !( flags & PFILE_IGNOREHASHCMT )))
+	{
+		while( *data && *data != '\n' )
+			data++;
+		goto skipwhite;
+	}
+
+	if( c == '\"' )
+	{
+		data++;
+
+		while( 1 )
+		{
+			c = (byte)*data;
+
+			// unexpected line end
+			if( !c )
+			{
+				token[len] = 0;
+				if( plen ) *plen = len;
+				return data;
+			}
+
+			data++;
+
+			if( c == '\\' && *data == '"' )
+			{
+				if( len + 1 < size )
+					token[len] = *data;
+				len++;
+				data++;
+				continue;
+			}
+
+			if( c == '\"' )
+			{
+				token[len < size ? len : size - 1] = 0;
+				if( plen ) *plen = len < size ? len : -1;
+				return data;
+			}
+
+			if( len + 1 < size )
+				token[len] = c;
+			len++;
+		}
+	}
+
+	if( Fake_IsSingleChar( c, flags ))
+	{
+		if( size >= 2 )
+		{
+			token[0] = c;
+			token[1] = 0;
+		}
+
+		if( plen ) *plen = 1;
+		return data + 1;
+	}
+
+	do
+	{
+		if( len + 1 < size )
+			token[len] = c;
+
+		data++;
+		len++;
+		c = (byte)*data;
+	} while( c > ' ' && !Fake_IsSingleChar( c, flags ));
+
+	token[len < size ? len : size - 1] = 0;
+	if( plen ) *plen = len < size ? len : -1;
+
+	return data;
+}
+
+static char *Fake_COM_ParseFile( char *data, char *token )
+{
+	return Fake_ParseFile( data, token, 1024, 0, NULL );
+}
+
+/*
+=================
+keys
+=================
+*/
+static char *s_bindings[MAX_FAKE_KEYS];
+
+static const char *Fake_KeynumToString( int keynum )
+{
+	static char buf[16];
+
+	COUNT( CALL_OTHER );
+
+	if( keynum < 0 || keynum >= MAX_FAKE_KEYS )
+		return "<OUT OF RANGE>";
+
+	if( keynum > 32 && keynum < 127 )
+		snprintf( buf, sizeof( buf ), "%c", keynum );
+	else snprintf( buf, sizeof( buf ), "KEY%d", keynum );
+
+	return buf;
+}
+
+static const char *Fake_KeyGetBinding( int keynum )
+{
+	COUNT( CALL_OTHER );
+
+	if( keynum < 0 || keynum >= MAX_FAKE_KEYS )
+		return NULL;
+
+	return s_bindings[keynum];
+}
+
+static void Fake_KeySetBinding( int keynum, const char *binding )
+{
+	COUNT( CALL_OTHER );
+
+	if( keynum < 0 || keynum >= MAX_FAKE_KEYS )
+		return;
+
+	free( s_bindings[keynum] );
+	s_bindings[keynum] = binding && binding[0] ? strdup( binding ) : NULL;
+}
+
+/*
+=================
+network
+=================
+*/
+static const char *Fake_AdrToString( const netadr_t a )
+{
+	static char buf[4][64];
+	static int idx;
+
+	COUNT( CALL_OTHER );
+
+	char *s = buf[idx++ & 3];
+	unsigned short port = (unsigned short)(( a.port >> 8 ) | ( a.port << 8 ));
+
+	snprintf( s, sizeof( buf[0] ), "%d.%d.%d.%d:%d", a.ip[0], a.ip[1], a.ip[2], a.ip[3], port );
+	return s;
+}
+
+static const char *Fake_NetAdrToString( struct netadr_s *a )
+{
+	return Fake_AdrToString( *a );
+}
+
+static int Fake_CompareAdr( const void *a, const void *b )
+{
+	const netadr_t *a1 = (const netadr_t *)a;
+	const netadr_t *a2 = (const netadr_t *)b;
+
+	COUNT( CALL_OTHER );
+
+	// qsort-like, same as NET_CompareAdrSort
+	if( a1->type != a2->type )
+		return (int)a1->type - (int)a2->type;
+
+	int cmp = memcmp( a1->ip, a2->ip, sizeof( a1->ip ));
+	if( cmp )
+		return cmp;
+
+	return (int)a1->port - (int)a2->port;
+}
+
+static int Fake_NetCompareAdr( struct netadr_s *a, struct netadr_s *b )
+{
+	return !Fake_CompareAdr( a, b );
+}
+
+static int Fake_StringToAdr( char *s, struct netadr_s *a )
+{
+	int ip[4], port = 27015;
+
+	COUNT( CALL_OTHER );
+
+	memset( a, 0, sizeof( *a ));
+
+	if( sscanf( s, "%d.%d.%d.%d:%d", &ip[0], &ip[1], &ip[2], &ip[3], &port ) < 4 )
+		return 0;
+
+	a->type = NA_IP;
+	for( int i = 0; i < 4; i++ )
+		a->ip[i] = ip[i];
+	a->port = (unsigned short)((( port & 0xFF ) << 8 ) | (( port >> 8 ) & 0xFF ));
+
+	return 1;
+}
+
+static void Fake_InitNetworking( void ) { }
+static void Fake_NetStatus( struct net_status_s *status ) { memset( status, 0, sizeof( *status )); }
+static void Fake_SendRequest( int context, int request, int flags, double timeout, struct netadr_s *remote_address, net_api_response_func_t response ) { COUNT( CALL_OTHER ); }
+static void Fake_CancelRequest( int context ) { COUNT( CALL_OTHER ); }
+static void Fake_CancelAllRequests( void ) { COUNT( CALL_OTHER ); }
+
+static net_api_t s_netapi =
+{
+	Fake_InitNetworking,
+	Fake_NetStatus,
+	Fake_SendRequest,
+	Fake_CancelRequest,
+	Fake_CancelAllRequests,
+	Fake_NetAdrToString,
+	Fake_NetCompareAdr,
+	Fake_StringToAdr,
+	NULL, // ValueForKey, unused by menu
+	NULL, // RemoveKey
+	NULL, // SetValueForKey
+};
+
+/*
+=================
+game info
+=================
+*/
+static gameinfo2_t s_gameinfo;
+
+static void Fake_SetupGameInfo( void )
+{
+	memset( &s_gameinfo, 0, sizeof( s_gameinfo ));
+	s_gameinfo.gi_version = GAMEINFO_VERSION;
+	strcpy( s_gameinfo.gamefolder, "valve" );
+	strcpy( s_gameinfo.startmap, "c0a0" );
+	strcpy( s_gameinfo.trainmap, "t0a0" );
+	strcpy( s_gameinfo.title, "Half-Life" );
+	strcpy( s_gameinfo.version, "1.0" );
+	strcpy( s_gameinfo.type, "singleplayer_only" );
+	s_gameinfo.gamemode = GAME_NORMAL;
+}
+
+static int Fake_GetGameInfo( GAMEINFO *pgameinfo )
+{
+	COUNT( CALL_OTHER );
+
+	memset( pgameinfo, 0, sizeof( *pgameinfo ));
+	strcpy( pgameinfo->gamefolder, s_gameinfo.gamefolder );
+	strcpy( pgameinfo->startmap, s_gameinfo.startmap );
+	strcpy( pgameinfo->trainmap, s_gameinfo.trainmap );
+	strcpy( pgameinfo->title, s_gameinfo.title );
+	return 1;
+}
+
+static GAMEINFO **Fake_GetGamesList( int *numGames )
+{
+	COUNT( CALL_OTHER );
+	*numGames = 0;
+	return NULL;
+}
+
+static gameinfo2_t *Fake_GetGameInfo2( int gi_version )
+{
+	COUNT( CALL_OTHER );
+	return gi_version == GAMEINFO_VERSION ? &s_gameinfo : NULL;
+}
+
+static gameinfo2_t *Fake_GetModInfo( int gi_version, int mod_index )
+{
+	COUNT( CALL_OTHER );
+	return gi_version == GAMEINFO_VERSION && mod_index == 0 ? &s_gameinfo : NULL;
+}
+
+/*
+=================
+everything else is a stub
+=================
+*/
+static void Fake_PlayLocalSound( const char *szSound ) { COUNT( CALL_OTHER ); }
+static void Fake_DrawLogo( const char *filename, float x, float y, float width, float height ) { COUNT( CALL_PIC_DRAW ); }
+static int Fake_GetLogoWidth( void ) { COUNT( CALL_OTHER ); return 0; }
+static int Fake_GetLogoHeight( void ) { COUNT( CALL_OTHER ); return 0; }
+static float Fake_GetLogoLength( void ) { COUNT( CALL_OTHER ); return 0.0f; }
+static void Fake_DrawCharacter( int x, int y, int width, int height, int ch, int ulRGBA, HIMAGE hFont ) { COUNT( CALL_CHAR ); }
+static int Fake_DrawConsoleString( int x, int y, const char *string ) { COUNT( CALL_CHAR ); return x; }
+static void Fake_DrawSetTextColor( int r, int g, int b, int alpha ) { COUNT( CALL_OTHER ); }
+static void Fake_DrawConsoleStringLen( const char *string, int *length, int *height ) { COUNT( CALL_OTHER ); *length = *height = 0; }
+static void Fake_SetConsoleDefaultColor( int r, int g, int b ) { COUNT( CALL_OTHER ); }
+static struct cl_entity_s *Fake_GetPlayerModel( void ) { COUNT( CALL_OTHER ); return NULL; }
+static void Fake_SetModel( struct cl_entity_s *ed, const char *path ) { COUNT( CALL_OTHER ); }
+static void Fake_ClearScene( void ) { COUNT( CALL_OTHER ); }
+static void Fake_RenderScene( const struct ref_viewpass_s *rvp ) { COUNT( CALL_OTHER ); }
+static int Fake_CreateVisibleEntity( int type, struct cl_entity_s *ent ) { COUNT( CALL_OTHER ); return 0; }
+static int Fake_CreateMapsList( int fRefresh ) { COUNT( CALL_FILE ); return 1; }
+static int Fake_ClientInGame( void ) { COUNT( CALL_OTHER ); return 0; }
+static void Fake_ClientJoin( const struct netadr_s adr ) { COUNT( CALL_OTHER ); }
+static void Fake_KeyClearStates( void ) { COUNT( CALL_OTHER ); }
+static void Fake_SetKeyDest( int dest ) { COUNT( CALL_OTHER ); }
+static int Fake_KeyIsDown( int keynum ) { COUNT( CALL_OTHER ); return 0; }
+static int Fake_KeyGetOverstrikeMode( void ) { COUNT( CALL_OTHER ); return 0; }
+static void Fake_KeySetOverstrikeMode( int fActive ) { COUNT( CALL_OTHER ); }
+static void *Fake_KeyGetState( const char *name ) { COUNT( CALL_OTHER ); return NULL; }
+static void *Fake_MemAlloc( size_t cb, const char *filename, const int fileline ) { COUNT( CALL_OTHER ); return calloc( 1, cb ); }
+static void Fake_MemFree( void *mem, const char *filename, const int fileline ) { COUNT( CALL_OTHER ); free( mem ); }
+static int Fake_CheckGameDll( void ) { COUNT( CALL_OTHER ); return 1; }
+static char *Fake_GetClipboardData( void ) { COUNT( CALL_OTHER ); return NULL; }
+static void Fake_ShellExecute( const char *name, const char *args, int closeEngine ) { COUNT( CALL_OTHER ); }
+static void Fake_WriteServerConfig( const char *name ) { COUNT( CALL_OTHER ); }
+static void Fake_ChangeInstance( const char *newInstance, const char *szFinalMessage ) { COUNT( CALL_OTHER ); }
+static void Fake_PlayBackgroundTrack( const char *introName, const char *loopName ) { COUNT( CALL_OTHER ); }
+static void Fake_HostEndGame( const char *szFinalMessage ) { COUNT( CALL_OTHER ); }
+static float Fake_RandomFloat( float flLow, float flHigh ) { COUNT( CALL_OTHER ); return flLow + ( flHigh - flLow ) * ( rand() / (float)RAND_MAX ); }
+static int Fake_RandomLong( int lLow, int lHigh ) { COUNT( CALL_OTHER ); return lLow + rand() % ( lHigh - lLow + 1 ); }
+static void Fake_SetCursor( void *hCursor ) { COUNT( CALL_OTHER ); }
+static int Fake_IsMapValid( char *filename ) { COUNT( CALL_FILE ); return 1; }
+static void Fake_ProcessImage( int texnum, float gamma, int topColor, int bottomColor ) { COUNT( CALL_OTHER ); }
+
+static const char *Fake_GetModeString( int vid_mode )
+{
+	static const char *modes[] = { "640x480", "800x600", "1024x768", "1280x720", "1920x1080" };
+
+	COUNT( CALL_OTHER );
+
+	if( vid_mode < 0 || vid_mode >= (int)( sizeof( modes ) / sizeof( modes[0] )))
+		return NULL;
+
+	return modes[vid_mode];
+}
+
+static void Fake_EnableTextInput( int enable ) { COUNT( CALL_OTHER ); }
+static int Fake_UtfProcessChar( int ch ) { return ch; }
+static int Fake_UtfMoveLeft( char *str, int pos ) { return pos > 0 ? pos - 1 : 0; }
+static int Fake_UtfMoveRight( char *str, int pos, int length ) { return pos < length ? pos + 1 : length; }
+static int Fake_GetRenderers( unsigned int num, char *short_name, size_t size1, char *long_name, size_t size2 ) { COUNT( CALL_OTHER ); return 0; }
+static double Fake_DoubleTime( void ) { COUNT( CALL_OTHER ); return s_flTime; }
+static void *Fake_GetNativeObject( const char *name ) { COUNT( CALL_OTHER ); return NULL; }
+
+static ui_enginefuncs_t s_engfuncs =
+{
+	Fake_PIC_Load,
+	Fake_PIC_Free,
+	Fake_PIC_Width,
+	Fake_PIC_Height,
+	Fake_PIC_Set,
+	Fake_PIC_Draw,
+	Fake_PIC_Draw, // holes
+	Fake_PIC_Draw, // trans
+	Fake_PIC_Draw, // additive
+	Fake_PIC_EnableScissor,
+	Fake_PIC_DisableScissor,
+	Fake_FillRGBA,
+	Fake_RegisterVariable,
+	Fake_GetCvarFloat,
+	Fake_GetCvarString,
+	Fake_CvarSetString,
+	Fake_CvarSetValue,
+	Fake_AddCommand,
+	Fake_ClientCmd,
+	Fake_DelCommand,
+	Fake_CmdArgc,
+	Fake_CmdArgv,
+	Fake_Cmd_Args,
+	Fake_Con_Printf,
+	Fake_Con_Printf,
+	Fake_Con_NPrintf,
+	Fake_Con_NXPrintf,
+	Fake_PlayLocalSound,
+	Fake_DrawLogo,
+	Fake_GetLogoWidth,
+	Fake_GetLogoHeight,
+	Fake_GetLogoLength,
+	Fake_DrawCharacter,
+	Fake_DrawConsoleString,
+	Fake_DrawSetTextColor,
+	Fake_DrawConsoleStringLen,
+	Fake_SetConsoleDefaultColor,
+	Fake_GetPlayerModel,
+	Fake_SetModel,
+	Fake_ClearScene,
+	Fake_RenderScene,
+	Fake_CreateVisibleEntity,
+	Fake_HostError,
+	Fake_FileExists,
+	Fake_GetGameDir,
+	Fake_CreateMapsList,
+	Fake_ClientInGame,
+	Fake_ClientJoin,
+	Fake_COM_LoadFile,
+	Fake_COM_ParseFile,
+	Fake_COM_FreeFile,
+	Fake_KeyClearStates,
+	Fake_SetKeyDest,
+	Fake_KeynumToString,
+	Fake_KeyGetBinding,
+	Fake_KeySetBinding,
+	Fake_KeyIsDown,
+	Fake_KeyGetOverstrikeMode,
+	Fake_KeySetOverstrikeMode,
+	Fake_KeyGetState,
+	Fake_MemAlloc,
+	Fake_MemFree,
+	Fake_GetGameInfo,
+	Fake_GetGamesList,
+	Fake_GetFilesList,
+	Fake_GetSaveComment,
+	Fake_GetDemoComment,
+	Fake_CheckGameDll,
+	Fake_GetClipboardData,
+	Fake_ShellExecute,
+	Fake_WriteServerConfig,
+	Fake_ChangeInstance,
+	Fake_PlayBackgroundTrack,
+	Fake_HostEndGame,
+	Fake_RandomFloat,
+	Fake_RandomLong,
+	Fake_SetCursor,
+	Fake_IsMapValid,
+	Fake_ProcessImage,
+	Fake_CompareFileTime,
+	Fake_GetModeString,
+	Fake_COM_SaveFile,
+	Fake_COM_RemoveFile,
+};
+
+static ui_extendedfuncs_t s_textfuncs =
+{
+	Fake_EnableTextInput,
+	Fake_UtfProcessChar,
+	Fake_UtfMoveLeft,
+	Fake_UtfMoveRight,
+	Fake_GetRenderers,
+	Fake_DoubleTime,
+	Fake_ParseFile,
+	Fake_AdrToString,
+	Fake_CompareAdr,
+	Fake_GetNativeObject,
+	&s_netapi,
+	Fake_GetGameInfo2,
+	Fake_GetModInfo,
+	Fake_IsCvarReadOnly,
+};
+
+void Fake_Init( const fakeconfig_t &config )
+{
+	s_config = config;
+
+	memset( &s_globals, 0, sizeof( s_globals ));
+	s_globals.scrWidth = config.width;
+	s_globals.scrHeight = config.height;
+	s_globals.maxClients = 32;
+	s_globals.developer = config.verbose;
+
+	Fake_SetupGameInfo();
+
+	// cvars engine would have at this point
+	Fake_RegisterVariable( "host_lowmemorymode", "0", 0 );
+	Fake_RegisterVariable( "name", "Player", 0 );
+	Fake_RegisterVariable( "ui_language", "english", 0 );
+
+	s_stats = fakestats_t();
+}
+
+void Fake_Shutdown( void )
+{
+	for( int i = 0; i < s_numFiles; i++ )
+		free( s_files[i] );
+	s_numFiles = 0;
+
+	for( int i = 0; i < MAX_FAKE_KEYS; i++ )
+	{
+		free( s_bindings[i] );
+		s_bindings[i] = NULL;
+	}
+}
+
+ui_enginefuncs_t *Fake_EngineFuncs( void )
+{
+	return &s_engfuncs;
+}
+
+ui_extendedfuncs_t *Fake_ExtendedFuncs( void )
+{
+	return &s_textfuncs;
+}
+
+ui_globalvars_t *Fake_Globals( void )
+{
+	return &s_globals;
+}
+
+void Fake_SetTime( double time )
+{
+	s_globals.frametime = time - s_flTime;
+	s_globals.time = time;
+	s_flTime = time;
+}
+
+const char *Fake_CallName( int call )
+{
+	static const char *names[CALL_COUNT] =
+	{
+		"pic_load",
+		"pic_draw",
+		"pic_other",
+		"fill",
+		"scissor",
+		"char",
+		"cvar",
+		"file",
+		"other",
+	};
+
+	return call >= 0 && call < CALL_COUNT ? names[call] : "";
+}
+
+fakestats_t &Fake_Stats( void )
+{
+	return s_stats;
+}
@@ -0,0 +1,74 @@
+/*
+FakeEngine.h -- headless engine interface for mainui_bench
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef FAKEENGINE_H
+#define FAKEENGINE_H
+
+#include "extdll_menu.h"
+
+// engine calls are grouped, so report stays readable
+enum
+{
+	CALL_PIC_LOAD = 0, // PIC_Load, PIC_Free
+	CALL_PIC_DRAW,     // PIC_Draw, PIC_DrawHoles, PIC_DrawTrans, PIC_DrawAdditive
+	CALL_PIC_OTHER,    // PIC_Set, PIC_Width, PIC_Height
+	CALL_FILL,         // FillRGBA
+	CALL_SCISSOR,      // PIC_EnableScissor, PIC_DisableScissor
+	CALL_CHAR,         // DrawCharacter, DrawConsoleString
+	CALL_CVAR,
+	CALL_FILE,         // COM_LoadFile, GetFilesList, FileExists, etc
+	CALL_OTHER,
+	CALL_COUNT
+};
+
+struct fakeconfig_t
+{
+	const char *dataDir; // files are served from here, relative to gamedir
+	const char *outputDir; // COM_SaveFile writes here, discarded if NULL
+	int numSaves;        // synthesized save/*.sav entries
+	bool verbose;        // print engine console output
+	int width, height;
+};
+
+struct fakestats_t
+{
+	int calls[CALL_COUNT];
+
+	int Total( void ) const
+	{
+		int total = 0;
+		for( int i = 0; i < CALL_COUNT; i++ )
+			total += calls[i];
+		return total;
+	}
+};
+
+void Fake_Init( const fakeconfig_t &config );
+void Fake_Shutdown( void );
+
+ui_enginefuncs_t *Fake_EngineFuncs( void );
+ui_extendedfuncs_t *Fake_ExtendedFuncs( void );
+ui_globalvars_t *Fake_Globals( void );
+
+// virtual clock, advanced by harness
+void Fake_SetTime( double time );
+
+// runs command registered by menu, like engine console would do
+bool Fake_ExecuteCommand( const char *cmd );
+
+const char *Fake_CallName( int call );
+fakestats_t &Fake_Stats( void );
+
+#endif // FAKEENGINE_H
@@ -0,0 +1,179 @@
+/*
+infostring_bench.cpp -- info string parser throughput
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+/*
+ * Extracts fields the server browser reads from every response, once with
+ * Info_ValueForKey per key and once with single pass CInfoString, and
+ * prints strings per second and MB/s for both.
+ *
+ * Info strings are read one per line from a file, bench/infostrings.txt
+ * has a sample set, server responses dumped from the engine work too.
+ *
+ * infostring_bench [-file path] [-iterations N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BenchUtils.h"
+#include "InfoString.h"
+
+#define MAX_STRINGS 4096
+
+static char *s_strings[MAX_STRINGS];
+static int s_numStrings;
+static size_t s_totalBytes;
+
+// fields browser extracts, keep in sync with CServerStore::SetInfo
+struct fields_t
+{
+	char host[64];
+	char map[64];
+	char gamedir[64];
+	int numcl;
+	int maxcl;
+	bool password;
+	bool gs;
+};
+
+static bool LoadStrings( const char *path )
+{
+	FILE *f = fopen( path, "r" );
+	char line[2048];
+
+	if( !f )
+	{
+		fprintf( stderr, "can't open %s\n", path );
+		return false;
+	}
+
+	while( s_numStrings < MAX_STRINGS && fgets( line, sizeof( line ), f ))
+	{
+		size_t len = strcspn( line, "\r\n" );
+
+		if( !len )
+			continue;
+
+		line[len] = 0;
+		s_strings[s_numStrings++] = strdup( line );
+		s_totalBytes += len;
+	}
+
+	fclose( f );
+	return s_numStrings > 0;
+}
+
+static void ExtractLegacy( const char *s, fields_t &out )
+{
+	strncpy( out.host, Info_ValueForKey( s, "host" ), sizeof( out.host ) - 1 );
+	strncpy( out.map, Info_ValueForKey( s, "map" ), sizeof( out.map ) - 1 );
+	strncpy( out.gamedir, Info_ValueForKey( s, "gamedir" ), sizeof( out.gamedir ) - 1 );
+	out.numcl = atoi( Info_ValueForKey( s, "numcl" ));
+	out.maxcl = atoi( Info_ValueForKey( s, "maxcl" ));
+	out.password = !strcmp( Info_ValueForKey( s, "password" ), "1" );
+	out.gs = !strcmp( Info_ValueForKey( s, "gs" ), "1" );
+}
+
+static void ExtractParsed( const char *s, fields_t &out )
+{
+	CInfoString parsed( s );
+
+	parsed.Value( CInfoString::KEY_HOST ).Copy( out.host, sizeof( out.host ));
+	parsed.Value( CInfoString::KEY_MAP ).Copy( out.map, sizeof( out.map ));
+	parsed.Value( CInfoString::KEY_GAMEDIR ).Copy( out.gamedir, sizeof( out.gamedir ));
+	out.numcl = parsed.Value( CInfoString::KEY_NUMCL ).ToInt();
+	out.maxcl = parsed.Value( CInfoString::KEY_MAXCL ).ToInt();
+	out.password = parsed.Value( CInfoString::KEY_PASSWORD ).Equals( "1" );
+	out.gs = parsed.Value( CInfoString::KEY_GS ).Equals( "1" );
+}
+
+static bool Verify( void )
+{
+	for( int i = 0; i < s_numStrings; i++ )
+	{
+		fields_t a, b;
+
+		memset( &a, 0, sizeof( a ));
+		memset( &b, 0, sizeof( b ));
+
+		ExtractLegacy( s_strings[i], a );
+		ExtractParsed( s_strings[i], b );
+
+		if( memcmp( &a, &b, sizeof( a )))
+		{
+			fprintf( stderr, "results differ for %s\n", s_strings[i] );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void Run( const char *name, void (*extract)( const char *, fields_t & ), int iterations )
+{
+	fields_t fields;
+	int checksum = 0;
+	double start = Bench_Time();
+
+	for( int i = 0; i < iterations; i++ )
+	{
+		for( int j = 0; j < s_numStrings; j++ )
+		{
+			extract( s_strings[j], fields );
+			checksum += fields.numcl + fields.host[0];
+		}
+	}
+
+	double elapsed = Bench_Time() - start;
+	double strings = (double)iterations * s_numStrings;
+
+	printf( "%-16s %12.0f %10.1f %10.1f   (%d)\n", name,
+		strings / elapsed,
+		strings * s_totalBytes / s_numStrings / elapsed / ( 1024.0 * 1024.0 ),
+		elapsed * 1e9 / strings, checksum );
+}
+
+int main( int argc, char **argv )
+{
+	const char *path = "infostrings.txt";
+	int iterations = 20000;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		if( !strcmp( argv[i], "-file" ) && i + 1 < argc )
+			path = argv[++i];
+		else if( !strcmp( argv[i], "-iterations" ) && i + 1 < argc )
+			iterations = atoi( argv[++i] );
+		else
+		{
+			fprintf( stderr, "usage: %s [-file path] [-iterations N]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	if( !LoadStrings( path ))
+		return 1;
+
+	if( !Verify( ))
+		return 1;
+
+	printf( "%d strings, %d bytes average\n", s_numStrings, (int)( s_totalBytes / s_numStrings ));
+	printf( "%-16s %12s %10s %10s\n", "parser", "strings/s", "MB/s", "ns/string" );
+
+	Run( "Info_ValueForKey", ExtractLegacy, iterations );
+	Run( "CInfoString", ExtractParsed, iterations );
+
+	return 0;
+}
@@ -0,0 +1,456 @@
+/*
+mainui_bench.cpp -- headless frame benchmark for menu library
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+/*
+ * Loads menu library against fake engine and scripts a few menu sessions:
+ * main menu, server browser filled with servers, scrolling and sorting,
+ * every server answering again while list is sorted, Load Game with lots
+ * of saves. Prints frame time percentiles and engine
+ * calls per frame for every phase. Nothing is rendered, so no GPU or game
+ * install is needed.
+ *
+ * With -record, last frame of every phase is also written with
+ * ui_drawrecord into the output directory, compare them with drawdiff.py.
+ *
+ * mainui_bench [-lib path] [-data dir] [-record dir] [-servers N] [-saves N] [-v]
+ */
+
+#include "FakeEngine.h"
+#include "BenchUtils.h"
+#include "keydefs.h"
+
+#if !defined _WIN32
+#include <dlfcn.h>
+#endif
+
+#ifndef MAINUI_BENCH_LIBRARY
+#if defined _WIN32
+#define MAINUI_BENCH_LIBRARY "menu.dll"
+#else
+#define MAINUI_BENCH_LIBRARY "./libmenu.so"
+#endif
+#endif
+
+#define BENCH_FRAMETIME    ( 1.0 / 60.0 )
+#define BENCH_MAX_FRAMES   4096
+#define SERVERS_PER_FRAME  100
+
+// server browser layout at 1024x768, see CMenuServerBrowser::_Init
+#define LIST_CENTER_X      700
+#define LIST_CENTER_Y      500
+#define LIST_HEADER_Y      275
+static const int s_sortColumnsX[] = { 440, 700, 800, 900 }; // name, map, players, ping
+
+struct benchframe_t
+{
+	double ms;
+	int calls[CALL_COUNT];
+};
+
+static UI_FUNCTIONS s_menu;
+static UI_EXTENDED_FUNCTIONS s_menuExt;
+static double s_flTime;
+
+static benchframe_t s_frames[BENCH_MAX_FRAMES];
+static int s_numFrames;
+static const char *s_szPhase;
+static bool s_bRecord;
+
+static void *Bench_LoadLibrary( const char *path, void **menuapi, void **extapi )
+{
+#if defined _WIN32
+	HMODULE lib = LoadLibraryA( path );
+	if( !lib )
+		return NULL;
+
+	*menuapi = (void *)GetProcAddress( lib, "GetMenuAPI" );
+	*extapi = (void *)GetProcAddress( lib, "GetExtAPI" );
+#else
+	void *lib = dlopen( path, RTLD_NOW );
+	if( !lib )
+	{
+		fprintf( stderr, "%s\n", dlerror( ));
+		return NULL;
+	}
+
+	*menuapi = dlsym( lib, "GetMenuAPI" );
+	*extapi = dlsym( lib, "GetExtAPI" );
+#endif
+
+	return (void *)lib;
+}
+
+static void Bench_FreeLibrary( void *lib )
+{
+#if defined _WIN32
+	FreeLibrary( (HMODULE)lib );
+#else
+	dlclose( lib );
+#endif
+}
+
+static void Bench_Command( const char *cmd )
+{
+	if( !Fake_ExecuteCommand( cmd ))
+		fprintf( stderr, "warning: menu command %s is not registered\n", cmd );
+}
+
+/*
+=================
+phases and frames
+=================
+*/
+static int Bench_CompareDouble( const void *a, const void *b )
+{
+	double d1 = *(const double *)a, d2 = *(const double *)b;
+	return d1 < d2 ? -1 : d1 > d2 ? 1 : 0;
+}
+
+static double Bench_Percentile( const double *sorted, int count, double p )
+{
+	int idx = (int)( p * ( count - 1 ) + 0.5 );
+	return sorted[idx];
+}
+
+// input and data injection for the frame should happen between Begin and End,
+// so it's included in frame time, like it would be in engine
+static double s_flFrameStart;
+
+static void Bench_BeginFrame( void )
+{
+	memset( &Fake_Stats(), 0, sizeof( fakestats_t ));
+
+	s_flTime += BENCH_FRAMETIME;
+	Fake_SetTime( s_flTime );
+
+	s_flFrameStart = Bench_Time();
+}
+
+static void Bench_EndFrame( void )
+{
+	s_menu.pfnRedraw( (float)s_flTime );
+
+	double end = Bench_Time();
+
+	if( s_numFrames >= BENCH_MAX_FRAMES )
+		return;
+
+	benchframe_t &frame = s_frames[s_numFrames++];
+	frame.ms = ( end - s_flFrameStart ) * 1000.0;
+	memcpy( frame.calls, Fake_Stats().calls, sizeof( frame.calls ));
+}
+
+static void Bench_Frames( int count )
+{
+	for( int i = 0; i < count; i++ )
+	{
+		Bench_BeginFrame();
+		Bench_EndFrame();
+	}
+}
+
+// writes one more frame with ui_drawrecord, it's not part of statistics
+static void Bench_RecordFrame( void )
+{
+	char filename[128], cmd[256];
+
+	snprintf( filename, sizeof( filename ), "%s.mudr", s_szPhase );
+	for( char *p = filename; *p; p++ )
+	{
+		if( *p == ' ' )
+			*p = '_';
+	}
+
+	snprintf( cmd, sizeof( cmd ), "ui_drawrecord \"%s\" 1", filename );
+	Bench_Command( cmd );
+
+	int numFrames = s_numFrames;
+	Bench_BeginFrame();
+	Bench_EndFrame();
+	s_numFrames = numFrames;
+}
+
+static void Bench_Key( int key )
+{
+	s_menu.pfnKeyEvent( key, 1 );
+	s_menu.pfnKeyEvent( key, 0 );
+}
+
+static void Bench_Click( int x, int y )
+{
+	s_menu.pfnMouseMove( x, y );
+	Bench_Key( K_MOUSE1 );
+}
+
+static void Bench_BeginPhase( const char *name )
+{
+	s_szPhase = name;
+	s_numFrames = 0;
+}
+
+static void Bench_EndPhase( void )
+{
+	static double times[BENCH_MAX_FRAMES];
+	double calls[CALL_COUNT] = { 0 };
+	double total = 0;
+
+	if( !s_numFrames )
+		return;
+
+	if( s_bRecord )
+		Bench_RecordFrame();
+
+	for( int i = 0; i < s_numFrames; i++ )
+	{
+		times[i] = s_frames[i].ms;
+
+		for( int j = 0; j < CALL_COUNT; j++ )
+		{
+			calls[j] += s_frames[i].calls[j];
+			total += s_frames[i].calls[j];
+		}
+	}
+
+	qsort( times, s_numFrames, sizeof( times[0] ), Bench_CompareDouble );
+
+	printf( "%-20s %6d %8.3f %8.3f %8.3f %8.3f %9.1f %8.1f %8.1f %8.1f\n", s_szPhase, s_numFrames,
+		Bench_Percentile( times, s_numFrames, 0.5 ),
+		Bench_Percentile( times, s_numFrames, 0.9 ),
+		Bench_Percentile( times, s_numFrames, 0.99 ),
+		times[s_numFrames - 1],
+		total / s_numFrames,
+		calls[CALL_PIC_DRAW] / s_numFrames,
+		calls[CALL_FILL] / s_numFrames,
+		calls[CALL_CHAR] / s_numFrames );
+}
+
+/*
+=================
+sessions
+=================
+*/
+static const char *s_maps[] =
+{
+	"crossfire", "bounce", "datacore", "frenzy", "gasworks", "lambda_bunker",
+	"rapidcore", "snark_pit", "stalkyard", "subtransit", "undertow", "boot_camp"
+};
+
+// generation changes player count, so repeated responses update existing rows
+static void Bench_AddServer( int index, int generation )
+{
+	netadr_t adr;
+	char info[512];
+	unsigned int seed = index * 2654435761u;
+	int maxcl = 8 + seed % 25;
+	int numcl = (( seed >> 8 ) + generation ) % ( maxcl + 1 );
+	int port = 27015 + index % 16;
+
+	memset( &adr, 0, sizeof( adr ));
+	adr.type = NA_IP;
+	adr.ip[0] = 10;
+	adr.ip[1] = ( index >> 16 ) & 0xFF;
+	adr.ip[2] = ( index >> 8 ) & 0xFF;
+	adr.ip[3] = index & 0xFF;
+	adr.port = (unsigned short)((( port & 0xFF ) << 8 ) | (( port >> 8 ) & 0xFF ));
+
+	snprintf( info, sizeof( info ),
+		"\\p\\49\\map\\%s\\dm\\1\\team\\0\\coop\\0\\numcl\\%d\\maxcl\\%d\\gamedir\\valve\\password\\%d\\host\\^%dBench server #%d",
+		s_maps[( seed >> 16 ) % ( sizeof( s_maps ) / sizeof( s_maps[0] ))], numcl, maxcl, index % 50 == 0, index % 8, index );
+
+	s_menu.pfnAddServerToList( adr, info );
+}
+
+static void Bench_MainMenu( void )
+{
+	Bench_BeginPhase( "main menu" );
+
+	s_menu.pfnSetActiveMenu( 1 );
+	Bench_Frames( 120 );
+
+	// hover over the buttons
+	for( int i = 0; i < 120; i++ )
+	{
+		Bench_BeginFrame();
+		s_menu.pfnMouseMove( 100 + i, 300 + i * 2 );
+		Bench_EndFrame();
+	}
+
+	Bench_EndPhase();
+}
+
+static void Bench_ServerBrowser( int numServers )
+{
+	Bench_BeginPhase( "browser open" );
+	Bench_Command( "menu_internetgames" );
+	Bench_Frames( 60 );
+	Bench_EndPhase();
+
+	Bench_BeginPhase( "browser ingest" );
+	for( int i = 0; i < numServers; )
+	{
+		Bench_BeginFrame();
+		for( int j = 0; j < SERVERS_PER_FRAME && i < numServers; j++, i++ )
+			Bench_AddServer( i, 0 );
+		Bench_EndFrame();
+	}
+	Bench_EndPhase();
+
+	Bench_BeginPhase( "browser idle" );
+	Bench_Frames( 120 );
+	Bench_EndPhase();
+
+	Bench_BeginPhase( "browser scroll" );
+	s_menu.pfnMouseMove( LIST_CENTER_X, LIST_CENTER_Y );
+	for( int i = 0; i < 600; i++ )
+	{
+		Bench_BeginFrame();
+
+		if( i < 300 )
+			Bench_Key( K_MWHEELDOWN );
+		else if( i < 400 )
+			Bench_Key( K_PGDN );
+		else
+			Bench_Key( K_MWHEELUP );
+
+		Bench_EndFrame();
+	}
+	Bench_EndPhase();
+
+	Bench_BeginPhase( "browser sort" );
+	for( int i = 0; i < (int)( sizeof( s_sortColumnsX ) / sizeof( s_sortColumnsX[0] )); i++ )
+	{
+		// ascending, then descending
+		for( int j = 0; j < 2; j++ )
+		{
+			Bench_BeginFrame();
+			Bench_Click( s_sortColumnsX[i], LIST_HEADER_Y );
+			Bench_EndFrame();
+
+			Bench_Frames( 10 );
+		}
+	}
+	Bench_EndPhase();
+
+	// every server answers again while list is sorted, like after refresh
+	Bench_BeginPhase( "browser replay" );
+	for( int i = 0; i < numServers; )
+	{
+		Bench_BeginFrame();
+		for( int j = 0; j < SERVERS_PER_FRAME && i < numServers; j++, i++ )
+			Bench_AddServer( i, 1 );
+		Bench_EndFrame();
+	}
+	Bench_EndPhase();
+
+	Bench_Key( K_ESCAPE );
+	Bench_Frames( 30 );
+}
+
+static void Bench_LoadGame( void )
+{
+	Bench_BeginPhase( "loadgame open" );
+	Bench_Command( "menu_loadgame" );
+	Bench_Frames( 60 );
+	Bench_EndPhase();
+
+	Bench_BeginPhase( "loadgame scroll" );
+	for( int i = 0; i < 300; i++ )
+	{
+		Bench_BeginFrame();
+		Bench_Key( i < 200 ? K_DOWNARROW : K_UPARROW );
+		Bench_EndFrame();
+	}
+	Bench_EndPhase();
+
+	Bench_Key( K_ESCAPE );
+	Bench_Frames( 30 );
+}
+
+int main( int argc, char **argv )
+{
+	const char *libpath = MAINUI_BENCH_LIBRARY;
+	fakeconfig_t config;
+	int numServers = 5000;
+
+	config.dataDir = ".";
+	config.outputDir = NULL;
+	config.numSaves = 500;
+	config.verbose = false;
+	config.width = 1024;
+	config.height = 768;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		if( !strcmp( argv[i], "-lib" ) && i + 1 < argc )
+			libpath = argv[++i];
+		else if( !strcmp( argv[i], "-data" ) && i + 1 < argc )
+			config.dataDir = argv[++i];
+		else if( !strcmp( argv[i], "-record" ) && i + 1 < argc )
+		{
+			config.outputDir = argv[++i];
+			s_bRecord = true;
+		}
+		else if( !strcmp( argv[i], "-servers" ) && i + 1 < argc )
+			numServers = atoi( argv[++i] );
+		else if( !strcmp( argv[i], "-saves" ) && i + 1 < argc )
+			config.numSaves = atoi( argv[++i] );
+		else if( !strcmp( argv[i], "-v" ))
+			config.verbose = true;
+		else
+		{
+			fprintf( stderr, "usage: %s [-lib path] [-data dir] [-record dir] [-servers N] [-saves N] [-v]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	void *menuapi, *extapi;
+	void *lib = Bench_LoadLibrary( libpath, &menuapi, &extapi );
+
+	if( !lib || !menuapi || !extapi )
+	{
+		fprintf( stderr, "can't load menu from %s\n", libpath );
+		return 1;
+	}
+
+	Fake_Init( config );
+
+	if( !((MENUAPI)menuapi)( &s_menu, Fake_EngineFuncs(), Fake_Globals( )))
+	{
+		fprintf( stderr, "GetMenuAPI failed\n" );
+		return 1;
+	}
+
+	if( !((UIEXTENEDEDAPI)extapi)( MENU_EXTENDED_API_VERSION, &s_menuExt, Fake_ExtendedFuncs( )))
+	{
+		fprintf( stderr, "GetExtAPI failed\n" );
+		return 1;
+	}
+
+	s_menu.pfnInit();
+	s_menu.pfnVidInit();
+
+	printf( "%-20s %6s %8s %8s %8s %8s %9s %8s %8s %8s\n", "phase", "frames",
+		"p50 ms", "p90 ms", "p99 ms", "max ms", "calls/f", "pics/f", "fills/f", "chars/f" );
+
+	Bench_MainMenu();
+	Bench_ServerBrowser( numServers );
+	Bench_LoadGame();
+
+	s_menu.pfnShutdown();
+	Fake_Shutdown();
+	Bench_FreeLibrary( lib );
+
+	return 0;
+}
@@ -0,0 +1,274 @@
+/*
+serverinfo_bench.cpp -- server info response decoding
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+/*
+ * Decodes synthetic player list and rules responses, like CMenuServerInfo
+ * receives them, with old per-key lookups and strtok and with single pass
+ * decoders from InfoString.h. Players are 64 by default and rules are 200.
+ *
+ * serverinfo_bench [-players N] [-rules N] [-iterations N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BenchUtils.h"
+#include "InfoString.h"
+
+#define MAX_PLAYERS 256
+#define MAX_STRING  65536
+
+static char s_players[MAX_STRING];
+static char s_rules[MAX_STRING];
+
+// what models keep, so both ways copy the same data
+struct player_t
+{
+	char name[128];
+	int frags;
+	float time;
+};
+
+static player_t s_decoded[MAX_PLAYERS];
+static char s_arena[MAX_STRING];
+static int s_checksum;
+
+static void Append( char *buf, const char *fmt, int a, const char *b )
+{
+	size_t len = strlen( buf );
+	snprintf( buf + len, MAX_STRING - len, fmt, a, b );
+}
+
+static void GenerateResponses( int players, int rules )
+{
+	char value[64];
+
+	Append( s_players, "\\players\\%d%s", players, "" );
+
+	for( int i = 0; i < players; i++ )
+	{
+		snprintf( value, sizeof( value ), "^%dPlayer with long name %d", i % 10, i );
+		Append( s_players, "\\p%dname\\%s", i, value );
+
+		snprintf( value, sizeof( value ), "%d", ( i * 37 ) % 100 - 10 );
+		Append( s_players, "\\p%dfrags\\%s", i, value );
+
+		snprintf( value, sizeof( value ), "%f", i * 61.5f );
+		Append( s_players, "\\p%dtime\\%s", i, value );
+	}
+
+	Append( s_rules, "\\rules\\%d%s", rules, "" );
+
+	for( int i = 0; i < rules; i++ )
+	{
+		snprintf( value, sizeof( value ), "%d", i * 13 );
+		Append( s_rules, "\\mp_rule_number_%d\\%s", i, value );
+	}
+}
+
+// CMenuServerInfo::PlayersResponse before single pass decoding
+static void PlayersLegacy( void )
+{
+	int count = atoi( Info_ValueForKey( s_players, "players" ));
+
+	for( int i = 0; i < count && i < MAX_PLAYERS; i++ )
+	{
+		char key[64];
+
+		snprintf( key, sizeof( key ), "p%ifrags", i );
+		s_decoded[i].frags = atoi( Info_ValueForKey( s_players, key ));
+
+		snprintf( key, sizeof( key ), "p%itime", i );
+		s_decoded[i].time = atof( Info_ValueForKey( s_players, key ));
+
+		snprintf( key, sizeof( key ), "p%iname", i );
+		strncpy( s_decoded[i].name, Info_ValueForKey( s_players, key ), sizeof( s_decoded[i].name ) - 1 );
+	}
+
+	s_checksum += count + s_decoded[count - 1].frags;
+}
+
+static void PlayersDecoded( void )
+{
+	static infoplayer_t players[MAX_PLAYERS];
+	int count = Info_DecodePlayers( s_players, players, MAX_PLAYERS );
+
+	for( int i = 0; i < count; i++ )
+	{
+		s_decoded[i].frags = players[i].frags;
+		s_decoded[i].time = players[i].time;
+		players[i].name.Copy( s_decoded[i].name, sizeof( s_decoded[i].name ));
+	}
+
+	s_checksum += count + s_decoded[count - 1].frags;
+}
+
+// CMenuServerInfo::RulesResponse before single pass decoding, it tokenized
+// engine buffer in place, here it works on a copy so it can run again
+static void RulesLegacy( void )
+{
+	static char copy[MAX_STRING];
+	int count = 0;
+
+	strcpy( copy, s_rules );
+	atoi( Info_ValueForKey( copy, "rules" ));
+
+	for( char *p = strtok( copy, "\\" ); p; p = strtok( NULL, "\\" ))
+	{
+		char *rule = strdup( p );
+
+		if(( p = strtok( NULL, "\\" )) == NULL )
+		{
+			free( rule );
+			break;
+		}
+
+		char *value = strdup( p );
+
+		if( strcmp( rule, "rules" ))
+			count++;
+
+		s_checksum += value[0];
+		free( rule );
+		free( value );
+	}
+
+	s_checksum += count;
+}
+
+static void RulesDecoded( void )
+{
+	CInfoStringReader reader( s_rules );
+	infospan_t key, value;
+	int used = 0, count = 0;
+
+	while( reader.Next( key, value ))
+	{
+		if( CInfoString::LookupKey( key.str, key.len ) == CInfoString::KEY_RULES )
+			continue;
+
+		key.Copy( s_arena + used, key.len + 1 );
+		used += key.len + 1;
+
+		value.Copy( s_arena + used, value.len + 1 );
+		s_checksum += s_arena[used];
+		used += value.len + 1;
+
+		count++;
+	}
+
+	s_checksum += count;
+}
+
+static bool Verify( void )
+{
+	static player_t legacy[MAX_PLAYERS];
+
+	PlayersLegacy();
+	memcpy( legacy, s_decoded, sizeof( legacy ));
+	memset( s_decoded, 0, sizeof( s_decoded ));
+	PlayersDecoded();
+
+	return !memcmp( legacy, s_decoded, sizeof( legacy ));
+}
+
+// indices too long for int must not wrap around into the array
+static bool VerifyBadIndices( void )
+{
+	struct
+	{
+		infoplayer_t before;
+		infoplayer_t players[4];
+		infoplayer_t after;
+	} guarded;
+
+	const char *response = "\\players\\2\\p4294967295frags\\777\\p99999999999999999999frags\\777"
+		"\\p4frags\\777\\p1frags\\5\\p0004294967296name\\bad";
+
+	memset( &guarded, 0, sizeof( guarded ));
+	guarded.before.frags = guarded.after.frags = 12345;
+
+	int count = Info_DecodePlayers( response, guarded.players, 4 );
+
+	return count == 2 && guarded.before.frags == 12345 && guarded.after.frags == 12345 &&
+		guarded.players[1].frags == 5 && guarded.players[0].name.IsEmpty();
+}
+
+static void Run( const char *name, void (*decode)( void ), int iterations, size_t bytes )
+{
+	double start = Bench_Time();
+
+	for( int i = 0; i < iterations; i++ )
+		decode();
+
+	double elapsed = Bench_Time() - start;
+
+	printf( "%-16s %10.2f %10.1f\n", name, elapsed * 1e6 / iterations,
+		(double)bytes * iterations / elapsed / ( 1024.0 * 1024.0 ));
+}
+
+int main( int argc, char **argv )
+{
+	int players = 64;
+	int rules = 200;
+	int iterations = 2000;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		if( !strcmp( argv[i], "-players" ) && i + 1 < argc )
+			players = atoi( argv[++i] );
+		else if( !strcmp( argv[i], "-rules" ) && i + 1 < argc )
+			rules = atoi( argv[++i] );
+		else if( !strcmp( argv[i], "-iterations" ) && i + 1 < argc )
+			iterations = atoi( argv[++i] );
+		else
+		{
+			fprintf( stderr, "usage: %s [-players N] [-rules N] [-iterations N]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	if( players < 1 || players > 64 || rules < 0 || rules > 1000 )
+	{
+		fprintf( stderr, "players must be 1..64 and rules 0..1000\n" );
+		return 1;
+	}
+
+	GenerateResponses( players, rules );
+
+	if( !Verify( ))
+	{
+		fprintf( stderr, "decoders disagree\n" );
+		return 1;
+	}
+
+	if( !VerifyBadIndices( ))
+	{
+		fprintf( stderr, "out of range player index was decoded\n" );
+		return 1;
+	}
+
+	printf( "%d players, %d bytes; %d rules, %d bytes\n", players, (int)strlen( s_players ), rules, (int)strlen( s_rules ));
+	printf( "%-16s %10s %10s\n", "decoder", "us/resp", "MB/s" );
+
+	Run( "players legacy", PlayersLegacy, iterations, strlen( s_players ));
+	Run( "players decoded", PlayersDecoded, iterations, strlen( s_players ));
+	Run( "rules legacy", RulesLegacy, iterations, strlen( s_rules ));
+	Run( "rules decoded", RulesDecoded, iterations, strlen( s_rules ));
+
+	printf( "checksum %d\n", s_checksum );
+
+	return 0;
+}
@@ -0,0 +1,486 @@
+/*
+tokenizer_bench.cpp -- config and translation file tokenizing
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+/*
+ * Parses synthetic settings.scr and VGUI translation file like
+ * CSCR_LoadDefaultCVars and Localize_AddToDictionary do, with a copy
+ * of engine's COM_ParseFile and with CTokenizer from Tokenizer.h.
+ * Script has 2000 cvars by default and translation has 5000 strings.
+ *
+ * tokenizer_bench [-cvars N] [-strings N] [-iterations N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "BenchUtils.h"
+#include "Tokenizer.h"
+
+#define MAX_STRING 256
+
+static char *s_script;
+static char *s_translation;
+static int s_checksum;
+
+// engine's COM_ParseFileSafe without flags, one call per token like before
+static char *LegacyParseFile( char *data, char *token, const int size )
+{
+	int c, len = 0;
+
+	token[0] = 0;
+
+	if( !data )
+		return NULL;
+skipwhite:
+	while(( c = (unsigned char)*data ) <= ' ' )
+	{
+		if( c == 0 )
+			return NULL;
+		data++;
+	}
+
+	if(( c == '/' && data[1] == '/' ) || c == '#' )
+	{
+		while( *data && *data != '\n' )
+			data++;
+		goto skipwhite;
+	}
+
+	if( c == '\"' )
+	{
+		data++;
+		while( 1 )
+		{
+			c = (unsigned char)*data;
+
+			if( !c )
+			{
+				token[len] = 0;
+				return data;
+			}
+			data++;
+
+			if( c == '\\' && *data == '"' )
+			{
+				if( len + 1 < size )
+					token[len++] = *data;
+				data++;
+				continue;
+			}
+
+			if( c == '\"' )
+			{
+				token[len] = 0;
+				return data;
+			}
+
+			if( len + 1 < size )
+				token[len++] = c;
+		}
+	}
+
+	if( c == '{' || c == '}' || c == ')' || c == '(' || c == '\'' || c == ',' )
+	{
+		token[0] = c;
+		token[1] = 0;
+		return data + 1;
+	}
+
+	do
+	{
+		if( len + 1 < size )
+			token[len++] = c;
+		data++;
+		c = (unsigned char)*data;
+
+		if( c == '{' || c == '}' || c == ')' || c == '(' || c == '\'' || c == ',' )
+			break;
+	} while( c > 32 );
+
+	token[len] = 0;
+	return data;
+}
+
+// menu calls it through engine's function table
+static char *(*volatile pfnParseFile)( char *data, char *token, const int size ) = LegacyParseFile;
+
+// parserstate_t of CFGScript.cpp before CTokenizer
+struct legacyparser_t
+{
+	legacyparser_t( char *text ) : buf( text ) { token[0] = 0; }
+
+	bool Expect( const char *expect, bool skip )
+	{
+		char *tmp = pfnParseFile( buf, token, sizeof( token ));
+
+		if( !strcasecmp( token, expect ))
+		{
+			buf = tmp;
+			return true;
+		}
+
+		if( skip )
+			buf = tmp;
+
+		return false;
+	}
+
+	bool Read( char *out, int size )
+	{
+		buf = pfnParseFile( buf, out, size );
+		return buf != NULL;
+	}
+
+	char *buf;
+	char token[MAX_STRING];
+};
+
+struct tokenparser_t
+{
+	tokenparser_t( const char *text ) : tokens( text ) { token[0] = 0; }
+
+	bool Expect( const char *expect, bool skip )
+	{
+		tokenspan_t t;
+
+		tokens.Peek( t );
+
+		if( t.EqualsNoCase( expect ))
+		{
+			tokens.Next( t );
+			return true;
+		}
+
+		t.Copy( token, sizeof( token ));
+
+		if( skip )
+			tokens.Next( t );
+
+		return false;
+	}
+
+	bool Read( char *out, int size )
+	{
+		tokenspan_t t;
+		bool result = tokens.Next( t );
+
+		t.Copy( out, size );
+		return result;
+	}
+
+	CTokenizer tokens;
+	char token[MAX_STRING];
+};
+
+static const char *s_types[] = { "BOOL", "NUMBER", "LIST", "STRING" };
+
+// CSCR_ParseSingleCvar without building the list, returns false on error
+template<class P> static bool ParseCvar( P &ps, int &hash )
+{
+	char name[MAX_STRING], desc[MAX_STRING], value[MAX_STRING];
+	int type;
+
+	ps.Read( name, sizeof( name ));
+
+	if( !ps.Expect( "{", false ))
+		return false;
+
+	ps.Read( desc, sizeof( desc ));
+
+	if( !ps.Expect( "{", false ))
+		return false;
+
+	for( type = 0; type < 4; type++ )
+	{
+		if( ps.Expect( s_types[type], false ))
+			break;
+	}
+
+	switch( type )
+	{
+	case 1:
+		ps.Read( ps.token, sizeof( ps.token ));
+		hash += atoi( ps.token );
+		ps.Read( ps.token, sizeof( ps.token ));
+		hash += atoi( ps.token );
+		// fallthrough
+	case 0:
+	case 3:
+		if( !ps.Expect( "}", false ))
+			return false;
+		break;
+	case 2:
+		while( !ps.Expect( "}", true ))
+		{
+			if( !ps.token[0] || !ps.Read( value, sizeof( value )))
+				return false;
+
+			hash += ps.token[0] + value[0];
+		}
+		break;
+	default:
+		return false;
+	}
+
+	if( !ps.Expect( "{", false ))
+		return false;
+
+	ps.Read( value, sizeof( value ));
+
+	if( !ps.Expect( "}", false ))
+		return false;
+
+	ps.Expect( "SetInfo", false );
+
+	if( !ps.Expect( "}", false ))
+		return false;
+
+	hash += name[0] + desc[0] + value[0] + type;
+	return true;
+}
+
+template<class P> static int ParseScript( char *text )
+{
+	P ps( text );
+	int hash = 0;
+
+	if( !ps.Expect( "VERSION", false ))
+		return -1;
+
+	ps.Read( ps.token, sizeof( ps.token ));
+
+	if( !ps.Expect( "DESCRIPTION", false ))
+		return -1;
+
+	ps.Read( ps.token, sizeof( ps.token ));
+
+	if( !ps.Expect( "{", false ))
+		return -1;
+
+	while( !ps.Expect( "}", false ))
+	{
+		if( !ParseCvar( ps, hash ))
+			return -1;
+	}
+
+	return hash;
+}
+
+// Localize_AddToDictionary before CTokenizer, header is checked by count only
+static int TranslationLegacy( char *text )
+{
+	char token[4096], value[4096];
+	int hash = 0;
+
+	for( int i = 0; i < 6; i++ )
+		text = pfnParseFile( text, token, sizeof( token ));
+
+	while(( text = pfnParseFile( text, token, sizeof( token ))))
+	{
+		if( !strcmp( token, "}" ))
+			break;
+
+		text = pfnParseFile( text, value, sizeof( value ));
+
+		if( !strcmp( value, "}" ) || !text )
+			break;
+
+		hash += token[0] + value[0] + (int)strlen( value );
+	}
+
+	return hash;
+}
+
+static int TranslationTokenizer( char *text )
+{
+	char token[4096], value[4096];
+	CTokenizer tokens( text );
+	tokenspan_t k, v;
+	int hash = 0;
+
+	for( int i = 0; i < 6; i++ )
+		tokens.Next( k );
+
+	while( tokens.Next( k ))
+	{
+		if( k.Equals( "}" ) || !tokens.Next( v ) || v.Equals( "}" ))
+			break;
+
+		k.Copy( token, sizeof( token ));
+		int len = v.Copy( value, sizeof( value ));
+
+		hash += token[0] + value[0] + len;
+	}
+
+	return hash;
+}
+
+static char *Generate( size_t size, int count, void (*entry)( char *buf, size_t size, int i ), const char *head, const char *tail )
+{
+	char *text = (char *)malloc( size );
+	size_t len = strlen( head );
+
+	memcpy( text, head, len + 1 );
+
+	for( int i = 0; i < count; i++ )
+	{
+		entry( text + len, size - len, i );
+		len += strlen( text + len );
+	}
+
+	snprintf( text + len, size - len, "%s", tail );
+	return text;
+}
+
+static void ScriptEntry( char *buf, size_t size, int i )
+{
+	switch( i % 4 )
+	{
+	case 0:
+		snprintf( buf, size, "\t\"cvar_bool_%d\"\n\t{\n\t\t\"Option %d\"\n\t\t{ BOOL }\n\t\t{ \"1\" }\n\t}\n\n", i, i );
+		break;
+	case 1:
+		snprintf( buf, size, "\t\"cvar_number_%d\"\n\t{\n\t\t\"Number %d\"\n\t\t{ NUMBER %d %d }\n\t\t{ \"%d\" }\n\t\tSetInfo\n\t}\n\n", i, i, i, i * 2, i + 1 );
+		break;
+	case 2:
+		snprintf( buf, size, "\t\"cvar_list_%d\"\n\t{\n\t\t\"List %d\"\n\t\t{\n\t\t\tLIST\n\t\t\t\"Low\" \"0\"\n\t\t\t\"Medium\" \"1\"\n\t\t\t\"High\" \"2\"\n\t\t}\n\t\t{ \"1\" }\n\t}\n\n", i, i );
+		break;
+	default:
+		snprintf( buf, size, "\t// comment %d\n\t\"cvar_string_%d\"\n\t{\n\t\t\"Name \\\"%d\\\"\"\n\t\t{ STRING }\n\t\t{ \"value %d\" }\n\t}\n\n", i, i, i, i );
+		break;
+	}
+}
+
+static void TranslationEntry( char *buf, size_t size, int i )
+{
+	snprintf( buf, size, "\"GameUI_String_%d\"\t\t\"Translated text number %d with \\\"quotes\\\" and\\nnewline\"\n"
+		"// comment after %d\n", i, i, i );
+}
+
+// both tokenizers see the same tokens in both files
+static bool Verify( const char *text )
+{
+	char *copy = strdup( text ), *p = copy;
+	char legacy[4096], current[4096];
+	CTokenizer tokens( text );
+	tokenspan_t t;
+	bool ok = true;
+
+	while(( p = LegacyParseFile( p, legacy, sizeof( legacy ))))
+	{
+		if( !tokens.Next( t ))
+		{
+			ok = false;
+			break;
+		}
+
+		t.Copy( current, sizeof( current ));
+
+		if( strcmp( legacy, current ) || !t.Equals( legacy ))
+		{
+			ok = false;
+			break;
+		}
+	}
+
+	free( copy );
+	return ok && !tokens.Next( t );
+}
+
+static void Run( const char *name, int (*parse)( char *text ), char *text, int iterations )
+{
+	size_t bytes = strlen( text );
+	double best = 1e9, total = 0;
+
+	// best run is less affected by whatever else machine does
+	for( int i = 0; i < iterations; i++ )
+	{
+		double start = Bench_Time();
+
+		s_checksum += parse( text );
+
+		double elapsed = Bench_Time() - start;
+
+		total += elapsed;
+		if( elapsed < best )
+			best = elapsed;
+	}
+
+	printf( "%-22s %10.2f %10.2f %10.1f\n", name, best * 1e3, total * 1e3 / iterations,
+		(double)bytes / best / ( 1024.0 * 1024.0 ));
+}
+
+int main( int argc, char **argv )
+{
+	int cvars = 2000;
+	int strings = 5000;
+	int iterations = 50;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		if( !strcmp( argv[i], "-cvars" ) && i + 1 < argc )
+			cvars = atoi( argv[++i] );
+		else if( !strcmp( argv[i], "-strings" ) && i + 1 < argc )
+			strings = atoi( argv[++i] );
+		else if( !strcmp( argv[i], "-iterations" ) && i + 1 < argc )
+			iterations = atoi( argv[++i] );
+		else
+		{
+			fprintf( stderr, "usage: %s [-cvars N] [-strings N] [-iterations N]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	if( cvars < 1 || cvars > 100000 || strings < 1 || strings > 100000 || iterations < 1 )
+	{
+		fprintf( stderr, "cvars and strings must be 1..100000\n" );
+		return 1;
+	}
+
+	s_script = Generate( cvars * 200 + 256, cvars, ScriptEntry,
+		"// generated settings.scr\nVERSION 1.0\n\nDESCRIPTION SERVER_OPTIONS\n{\n", "}\n" );
+	s_translation = Generate( strings * 128 + 256, strings, TranslationEntry,
+		"\"lang\"\n{\n\"Language\" \"English\"\n\"Tokens\"\n{\n", "}\n}\n" );
+
+	if( !Verify( s_script ) || !Verify( s_translation ))
+	{
+		fprintf( stderr, "tokenizers disagree\n" );
+		return 1;
+	}
+
+	if( ParseScript<legacyparser_t>( s_script ) != ParseScript<tokenparser_t>( s_script ) ||
+		TranslationLegacy( s_translation ) != TranslationTokenizer( s_translation ))
+	{
+		fprintf( stderr, "parsers disagree\n" );
+		return 1;
+	}
+
+	printf( "settings.scr: %d cvars, %d bytes; translation: %d strings, %d bytes\n",
+		cvars, (int)strlen( s_script ), strings, (int)strlen( s_translation ));
+	printf( "%-22s %10s %10s %10s\n", "parser", "best ms", "mean ms", "best MB/s" );
+
+	Run( "script legacy", ParseScript<legacyparser_t>, s_script, iterations );
+	Run( "script tokenizer", ParseScript<tokenparser_t>, s_script, iterations );
+	Run( "translation legacy", TranslationLegacy, s_translation, iterations );
+	Run( "translation tokenizer", TranslationTokenizer, s_translation, iterations );
+
+	printf( "checksum %d\n", s_checksum );
+
+	free( s_script );
+	free( s_translation );
+
+	return 0;
+}
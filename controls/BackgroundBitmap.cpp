@@ -19,6 +19,7 @@ GNU General Public License for more details.
 #include "BackgroundBitmap.h"
 #include "Utils.h"
 #include "BaseWindow.h"
+#include "ParsedFile.h"
 
 bool CMenuBackgroundBitmap::s_bEnableLogoMovie = false;
 bool CMenuBackgroundBitmap::s_bGameHasSteamBackground = false;
@@ -214,59 +215,57 @@ void CMenuBackgroundBitmap::Draw()
 
 bool CMenuBackgroundBitmap::LoadSteamBackground( bool gamedirOnly )
 {
-	char *afile = NULL, *pfile;
-	char token[4096];
-
-	bool loaded = false;
+	const CParsedFile *file = NULL;
+	const char *token;
 
 	// try 25'th anniversary update background first
 	if( FBitSet( gMenu.m_gameinfo.flags, GFL_HD_BACKGROUND ))
-		afile = (char *)EngFuncs::COM_LoadFile( "resource/HD_BackgroundLayout.txt" );
+		file = UI_LoadParsedFile( "resource/HD_BackgroundLayout.txt" );
 
-	if( !afile )
-		afile = (char *)EngFuncs::COM_LoadFile( "resource/BackgroundLayout.txt" );
+	if( !file )
+		file = UI_LoadParsedFile( "resource/BackgroundLayout.txt" );
 
-	if( !afile )
+	if( !file )
 		return false;
 
-	pfile = afile;
+	CTokenReader reader( file );
 
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-	if( !pfile || strcmp( token, "resolution" )) // resolution at first!
-		goto freefile;
+	token = reader.Next();
+	if( !token || strcmp( token, "resolution" )) // resolution at first!
+		return false;
 
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-	if( !pfile ) goto freefile;
+	token = reader.Next();
+	if( !token ) return false;
 
 	s_SteamBackgroundImageSize.w = atoi( token );
 
-	pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-	if( !pfile ) goto freefile;
+	token = reader.Next();
+	if( !token ) return false;
 
 	s_SteamBackgroundImageSize.h = atoi( token );
 
 	// Now read all tiled background list
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) )))
+	while(( token = reader.Next( )))
 	{
 		bimage_t img;
 
 		if( !EngFuncs::FileExists( token, gamedirOnly ))
-			goto freefile;
+			return false;
 
 		img.hImage = EngFuncs::PIC_Load( token, PIC_NOFLIP_TGA );
 
-		if( !img.hImage ) goto freefile;
+		if( !img.hImage ) return false;
 
 		// ignore "scaled" attribute. What does it mean?
-		pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-		if( !pfile ) goto freefile;
+		token = reader.Next();
+		if( !token ) return false;
 
-		pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-		if( !pfile ) goto freefile;
+		token = reader.Next();
+		if( !token ) return false;
 		img.coord.x = atoi( token );
 
-		pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ) );
-		if( !pfile ) goto freefile;
+		token = reader.Next();
+		if( !token ) return false;
 		img.coord.y = atoi( token );
 
 		img.size.w = EngFuncs::PIC_Width( img.hImage );
@@ -275,11 +274,7 @@ bool CMenuBackgroundBitmap::LoadSteamBackground( bool gamedirOnly )
 		s_SteamBackground.AddToTail( img );
 	}
 
-	loaded = true;
-
-freefile:
-	EngFuncs::COM_FreeFile( afile );
-	return loaded;
+	return true;
 }
 
 bool CMenuBackgroundBitmap::LoadWONBackground( bool gamedirOnly )
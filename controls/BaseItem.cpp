@@ -22,6 +22,10 @@ CMenuBaseItem::CMenuBaseItem
 
 CMenuBaseItem::CMenuBaseItem()
 {
+	// setters below invalidate layout
+	m_pParent = NULL;
+	m_bLayoutDirty = true;
+
 	SetNameAndStatus( "", NULL );
 	SetCharSize( QM_DEFAULTFONT );
 	SetCoord( 0, 0 );
@@ -39,8 +43,6 @@ CMenuBaseItem::CMenuBaseItem()
 	m_iLastFocusTime = 0;
 	m_bPressed = false;
 
-	m_pParent = NULL;
-
 	m_bAllocName = false;
 }
 
@@ -99,6 +101,7 @@ bool CMenuBaseItem::KeyDown( int key )
 
 void CMenuBaseItem::SetCharSize( EFontSizes fs )
 {
+	InvalidateLayout();
 	font = fs + 1; // It's guaranteed that handles will match font sizes
 
 	switch( fs )
@@ -175,10 +178,42 @@ void CMenuBaseItem::CalcPosition()
 	}
 
 	if( !IsAbsolutePositioned() && m_pParent )
+		m_scOffset = m_pParent->GetPositionOffset();
+	else m_scOffset = Point( 0, 0 );
+
+	m_scPos += m_scOffset;
+	m_bLayoutDirty = false;
+}
+
+void CMenuBaseItem::TranslateRenderPosition( Point delta )
+{
+	m_scPos += delta;
+	m_scOffset += delta;
+}
+
+void CMenuBaseItem::InvalidateLayout()
+{
+	// parents only translate their children when they aren't dirty,
+	// so they must do full layout too
+	for( CMenuBaseItem *item = this; item && !item->m_bLayoutDirty; item = item->m_pParent )
+		item->m_bLayoutDirty = true;
+}
+
+void CMenuBaseItem::UpdateRenderOffset()
+{
+	if( m_bLayoutDirty )
 	{
-		Point offset = m_pParent->GetPositionOffset();
-		m_scPos += offset;
+		VidInit();
+		return;
 	}
+
+	if( IsAbsolutePositioned() || !m_pParent )
+		return;
+
+	Point delta = m_pParent->GetPositionOffset() - m_scOffset;
+
+	if( delta.x || delta.y )
+		TranslateRenderPosition( delta );
 }
 
 void CMenuBaseItem::CalcSizes()
@@ -236,6 +271,7 @@ bool CMenuBaseItem::KeyValueData(const char *key, const char *data)
 				coord += 640;
 		}
 		pos.x = coord * REMAP_RATIO;
+		InvalidateLayout();
 	}
 	else if( !strcmp( key, "ypos" ) )
 	{
@@ -253,14 +289,17 @@ bool CMenuBaseItem::KeyValueData(const char *key, const char *data)
 				coord += 480;
 		}
 		pos.y = coord * REMAP_RATIO;
+		InvalidateLayout();
 	}
 	else if( !strcmp( key, "wide" ) )
 	{
 		size.w = atoi( data ) * REMAP_RATIO;
+		InvalidateLayout();
 	}
 	else if( !strcmp( key, "tall" ) )
 	{
 		size.h = atoi( data ) * REMAP_RATIO;
+		InvalidateLayout();
 	}
 	else if( !strcmp( key, "visible" ) )
 	{
@@ -128,6 +128,18 @@ public:
 	// Calculate scale size(item size, char size)
 	void CalcSizes( void );
 
+	// Shift already calculated render position, when only parent offset is changed
+	// Items that keep own absolute coordinates must move them too
+	virtual void TranslateRenderPosition( Point delta );
+
+	// Cheap layout update: moves item after parent offset, like scrolling
+	// Falls back to VidInit, if layout was invalidated
+	void UpdateRenderOffset( void );
+
+	// Forces full layout on next UpdateRenderOffset, for this item and its parents
+	// Geometry setters call it, direct changes of pos or size must too
+	void InvalidateLayout( void );
+
 	// Play sound
 	void PlayLocalSound( const char *name )
 	{
@@ -147,8 +159,8 @@ public:
 	// called when CL_IsActive returns true, otherwise onActivate
 	CEventCallback onReleasedClActive;
 
-	inline void SetCoord( int x, int y )                { pos.x = x; pos.y = y; }
-	inline void SetSize( int w, int h )                 { size.w = w; size.h = h; }
+	inline void SetCoord( int x, int y )                { pos.x = x; pos.y = y; InvalidateLayout(); }
+	inline void SetSize( int w, int h )                 { size.w = w; size.h = h; InvalidateLayout(); }
 	inline void SetRect( int x, int y, int w, int h )   { SetCoord( x, y ); SetSize( w, h ); }
 	inline Point GetRenderPosition() const { return m_scPos; }
 	inline Size  GetRenderSize()     const { return m_scSize; }
@@ -215,6 +227,9 @@ protected:
 	Point m_scPos;
 	Size m_scSize;
 	int m_scChSize;
+
+	Point m_scOffset; // parent offset, included in m_scPos
+	bool  m_bLayoutDirty;
 };
 
 #include "ItemsHolder.h"
@@ -54,6 +54,12 @@ void CMenuCheckBox::VidInit( void )
 	m_scTextSize.h = m_scChSize;
 }
 
+void CMenuCheckBox::TranslateRenderPosition( Point delta )
+{
+	BaseClass::TranslateRenderPosition( delta );
+	m_scTextPos += delta;
+}
+
 bool CMenuCheckBox::KeyUp( int key )
 {
 	const char	*sound = 0;
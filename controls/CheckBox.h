@@ -32,6 +32,7 @@ public:
 
 	CMenuCheckBox();
 	void VidInit() override;
+	void TranslateRenderPosition( Point delta ) override;
 	bool KeyUp( int key ) override;
 	bool KeyDown( int key ) override;
 	void Draw( void ) override;
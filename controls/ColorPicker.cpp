@@ -55,6 +55,15 @@ void CMenuColorPicker::VidInit()
 	RebuildSVTexture();
 }
 
+void CMenuColorPicker::TranslateRenderPosition( Point delta )
+{
+	CMenuBaseItem::TranslateRenderPosition( delta );
+
+	// textures don't depend on position, no need to rebuild them
+	m_svPos += delta;
+	m_huePos += delta;
+}
+
 void CMenuColorPicker::RebuildSVTexture()
 {
 	if( m_svSize.w <= 0 || m_svSize.h <= 0 )
@@ -27,6 +27,7 @@ public:
 	virtual ~CMenuColorPicker();
 
 	void VidInit() override;
+	void TranslateRenderPosition( Point delta ) override;
 	void Draw() override;
 	bool KeyDown( int key ) override;
 	bool KeyUp( int key ) override;
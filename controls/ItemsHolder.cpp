@@ -18,6 +18,7 @@ GNU General Public License for more details.
 #include "PicButton.h"
 #include "ItemsHolder.h"
 #include "Scissor.h"
+#include "ParsedFile.h"
 #include <string.h>
 
 CMenuItemsHolder::CMenuItemsHolder() :
@@ -315,6 +316,15 @@ void CMenuItemsHolder::VidInitItems()
 		m_pItems[i]->VidInit();
 }
 
+void CMenuItemsHolder::TranslateRenderPosition( Point delta )
+{
+	BaseClass::TranslateRenderPosition( delta );
+
+	// children are placed relative to us, move them along
+	FOR_EACH_VEC( m_pItems, i )
+		m_pItems[i]->TranslateRenderPosition( delta );
+}
+
 void CMenuItemsHolder::ToggleInactive()
 {
 	FOR_EACH_VEC( m_pItems, i )
@@ -543,111 +553,98 @@ void CMenuItemsHolder::RemoveItem(CMenuBaseItem &item)
 	}
 }
 
-bool RES_ExpectString( char **data, const char *expect, bool skip = true )
+bool RES_ExpectString( CTokenReader &reader, const char *expect, bool skip = true )
 {
-	char token[1024];
-	char *tmp;
-
-	if( !data || !*data )
-		return true;
-
-	tmp = EngFuncs::COM_ParseFile( *data, token, sizeof( token ) );
-
-	if( skip )
-		*data = tmp;
+	const char *token = skip ? reader.Next() : reader.Peek();
 
-	if( !*data )
-		return true;
+	// end of file only ends skipping
+	if( !token )
+		return skip;
 
-	if( !strncmp( token, expect, 1024 ) )
+	if( !strcmp( token, expect ))
 	{
-		*data = tmp; // skip anyway, if expected string was here
+		if( !skip )
+			reader.Next(); // skip anyway, if expected string was here
 		return true;
 	}
 
 	return false;
 }
 
-inline bool FreeFile( byte *pfile, const bool retval )
-{
-	EngFuncs::COM_FreeFile( pfile );
-	return retval;
-}
-
 bool CMenuItemsHolder::LoadRES(const char *filename)
 {
-	byte *pfile = EngFuncs::COM_LoadFile( filename );
-	char *afile = (char*)pfile;
-	char token[1024];
+	const CParsedFile *file = UI_LoadParsedFile( filename );
+	const char *token;
 
-	if( !pfile )
+	if( !file )
 		return false;
 
-	afile = EngFuncs::COM_ParseFile( afile, token, sizeof( token ) );
+	CTokenReader reader( file );
 
-	Con_DPrintf( "Loading res file from %s, name %s\n", filename, token );
+	token = reader.Next();
 
-	if( !afile )
-		return FreeFile( pfile, false );
+	Con_DPrintf( "Loading res file from %s, name %s\n", filename, token ? token : "" );
 
-	if( !RES_ExpectString( &afile, "{" ) )
+	if( !token )
+		return false;
+
+	if( !RES_ExpectString( reader, "{" ) )
 	{
 		Con_DPrintf( "LoadRES: failed to parse, want '{'\n" );
-		return FreeFile( pfile, false );
+		return false;
 	}
 
 	do
 	{
 		CMenuBaseItem *item;
 
-		afile = EngFuncs::COM_ParseFile( afile, token, sizeof( token ) );
+		token = reader.Next();
 
-		if( !afile )
-			return FreeFile( pfile, false );
+		if( !token )
+			return false;
 
 		item = FindItemByTag( token );
 
-		if( !RES_ExpectString( &afile, "{" ))
+		if( !RES_ExpectString( reader, "{" ))
 		{
 			Con_DPrintf( "LoadRES: failed to parse, want '{', near %s\n", token );
-			return FreeFile( pfile, false );
+			return false;
 		}
 
 		if( item )
 		{
 			do
 			{
-				char key[1024];
-				char value[1024];
+				const char *key, *value;
 
-				afile = EngFuncs::COM_ParseFile( afile, key, sizeof( key ));
-				if( !afile )
-					return FreeFile( pfile, false );
+				key = reader.Next();
+				if( !key )
+					return false;
 
-				afile = EngFuncs::COM_ParseFile( afile, value, sizeof( value ));
-				if( !afile )
-					return FreeFile( pfile, false );
+				value = reader.Next();
+				if( !value )
+					return false;
 
 				item->KeyValueData( key, value );
 			}
-			while( !RES_ExpectString( &afile, "}", false ) );
+			while( !RES_ExpectString( reader, "}", false ) );
 		}
 		else
 		{
 			Con_DPrintf( "LoadRES: cannot find item %s, skipping!\n", token );
 
-			while( !RES_ExpectString( &afile, "}" ) );
+			while( !RES_ExpectString( reader, "}" ) );
 		}
 	}
-	while( !RES_ExpectString( &afile, "}", false ) );
+	while( !RES_ExpectString( reader, "}", false ) );
 
-	if( !RES_ExpectString( &afile, "}" ))
+	if( !RES_ExpectString( reader, "}" ))
 	{
 		Con_DPrintf( "LoadRES: failed to parse, want '{'\n" );
-		return FreeFile( pfile, false );
+		return false;
 	}
 
-	return FreeFile( pfile, true );
+	return true;
 }
 
 void CMenuItemsHolder::RegisterNamedEvent(CEventCallback ev, const char *name)
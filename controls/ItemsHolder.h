@@ -39,6 +39,7 @@ public:
 	void Think( void ) override;
 
 	bool MouseMove( int x, int y ) override;
+	void TranslateRenderPosition( Point delta ) override;
 
 	bool KeyValueData(const char *key, const char *data) override;
 
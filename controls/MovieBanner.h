@@ -30,6 +30,8 @@ class CMenuMovieBanner : public CMenuBaseItem
 {
 public:
 	virtual void VidInit() override;
+	// placed over background, regardless of parent
+	void TranslateRenderPosition( Point delta ) override { }
 	virtual void Draw() override;
 };
 
@@ -78,6 +78,14 @@ void CMenuPlayerModelView::VidInit()
 	ent->player = bDrawAsPlayer; // yes, draw me as playermodel
 }
 
+void CMenuPlayerModelView::TranslateRenderPosition( Point delta )
+{
+	CMenuBaseItem::TranslateRenderPosition( delta );
+
+	refdef.viewport[0] = m_scPos.x;
+	refdef.viewport[1] = m_scPos.y;
+}
+
 bool CMenuPlayerModelView::KeyUp( int key )
 {
 	if( !ent )
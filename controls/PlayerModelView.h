@@ -31,6 +31,7 @@ class CMenuPlayerModelView : public CMenuBaseItem
 public:
 	CMenuPlayerModelView();
 	void VidInit() override;
+	void TranslateRenderPosition( Point delta ) override;
 	void Draw() override;
 	bool KeyDown( int key ) override;
 	bool KeyUp( int key ) override;
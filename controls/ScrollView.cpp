@@ -52,23 +52,28 @@ bool CMenuScrollView::KeyDown( int key )
 		// TODO: overscrolling
 		newPos = bound( 0, newPos, m_iMax - m_scSize.h );
 
-		// recalc
-		if( newPos != m_iPos )
-		{
-			m_iPos = newPos;
-			FOR_EACH_VEC( m_pItems, i )
-			{
-				CMenuBaseItem *pItem = m_pItems[i];
-
-				pItem->VidInit();
-			}
+		if( SetScrollPos( newPos ))
 			CMenuItemsHolder::MouseMove( uiStatic.cursorX, uiStatic.cursorY );
-		}
 	}
 
 	return CMenuItemsHolder::KeyDown( key );
 }
 
+bool CMenuScrollView::SetScrollPos( int newPos )
+{
+	if( newPos == m_iPos )
+		return false;
+
+	m_iPos = newPos;
+
+	// scaled geometry stays the same, only offset is changed
+	// so don't run VidInit on the whole subtree
+	FOR_EACH_VEC( m_pItems, i )
+		m_pItems[i]->UpdateRenderOffset();
+
+	return true;
+}
+
 Point CMenuScrollView::GetPositionOffset() const
 {
 	return Point( 0, -m_iPos ) + BaseClass::GetPositionOffset();
@@ -114,17 +119,7 @@ void CMenuScrollView::Draw()
 		// TODO: overscrolling
 		newPos = bound( 0, newPos, m_iMax - m_scSize.h );
 
-		// recalc
-		if( newPos != m_iPos )
-		{
-			m_iPos = newPos;
-			FOR_EACH_VEC( m_pItems, i )
-			{
-				CMenuBaseItem *pItem = m_pItems[i];
-
-				pItem->VidInit();
-			}
-		}
+		SetScrollPos( newPos );
 		m_HoldingPoint = Point( uiStatic.cursorX, uiStatic.cursorY );
 	}
 
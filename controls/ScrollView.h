@@ -18,6 +18,7 @@ public:
 
 private:
 	bool IsRectVisible( Point pt, Size sz );
+	bool SetScrollPos( int newPos ); // returns true if position was changed
 
 	Point m_scScrollBarPos;
 	Size  m_scScrollBarSize;
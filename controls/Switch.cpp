@@ -138,6 +138,16 @@ void CMenuSwitch::VidInit()
 	m_scTextSize.h = m_scChSize;
 }
 
+void CMenuSwitch::TranslateRenderPosition( Point delta )
+{
+	BaseClass::TranslateRenderPosition( delta );
+
+	for( int i = 0; i < m_switches.Count( ); i++ )
+		m_switches[i].pt += delta;
+
+	m_scTextPos += delta;
+}
+
 bool CMenuSwitch::KeyUp( int key )
 {
 	const char *sound = NULL;
@@ -32,6 +32,7 @@ public:
 	bool KeyDown( int key ) override;
 	bool KeyUp( int key ) override;
 	void VidInit() override;
+	void TranslateRenderPosition( Point delta ) override;
 	void Draw() override;
 	void UpdateEditable() override;
 	void LinkCvar( const char *name ) override
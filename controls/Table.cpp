@@ -21,6 +21,9 @@ GNU General Public License for more details.
 #include "Scissor.h"
 
 #define HEADER_HEIGHT_FRAC 1.75f
+#define SCROLL_FRICTION 4.0f // velocity lost per second, as fraction
+#define SCROLL_MIN_VELOCITY 20.0f // pixels per second, slower kinetic scroll stops
+#define SEARCH_TIMEOUT 1000 // msec between keystrokes, longer pause starts new search
 
 CMenuTable::CMenuTable() : BaseClass(),
 	bFramedHintText( false ),
@@ -30,13 +33,16 @@ CMenuTable::CMenuTable() : BaseClass(),
 	szUpArrow( UI_UPARROW ), szUpArrowFocus( UI_UPARROWFOCUS ), szUpArrowPressed( UI_UPARROWPRESSED ),
 	szDownArrow( UI_DOWNARROW ), szDownArrowFocus( UI_DOWNARROWFOCUS ), szDownArrowPressed( UI_DOWNARROWPRESSED ),
 	iTopItem( 0 ),
-	iScrollBarSliding( false ),
+	m_flScroll( 0.0f ), m_flVelocity( 0.0f ), m_flDragDistance( 0.0f ), m_iLastScrollTime( 0 ),
+	iScrollBarSliding( false ), m_iScrollBarGrab( 0 ), m_iScrollBarRows( -1 ), m_iTrackTop( 0 ), m_iTrackLength( 0 ),
 	iHighlight( -1 ), iCurItem( 0 ), iNumRows( 0 ),
 	m_iLastItemMouseChange( 0 ),
+	m_iSearchLen( 0 ), m_iLastSearchTime( 0 ),
 	m_iSortingColumn( -1 ),
 	m_pModel( NULL )
 {
 	memset( szHeaderTexts, 0, sizeof(szHeaderTexts) );
+	m_szSearch[0] = 0;
 	memset( columns, 0, sizeof(columns) );
 	eFocusAnimation = QM_HIGHLIGHTIFFOCUS;
 	SetCharSize( QM_SMALLFONT );
@@ -56,18 +62,6 @@ void CMenuTable::VidInit()
 
 	iNumRows = ( m_scSize.h - iStrokeWidth * 2 ) / m_scChSize - 1;
 
-	if( !iCurItem )
-	{
-		if( iCurItem < iTopItem )
-			iTopItem = iCurItem;
-		if( iCurItem > iTopItem + iNumRows - 1 )
-			iTopItem = iCurItem - iNumRows + 1;
-		if( iTopItem > m_pModel->GetRows() - iNumRows )
-			iTopItem = m_pModel->GetRows() - iNumRows;
-		if( iTopItem < 0 )
-			iTopItem = 0;
-	}
-
 	flFixedSumm = 0.0f;
 	flDynamicSumm = 0.0f;
 
@@ -113,94 +107,63 @@ void CMenuTable::VidInit()
 	boxPos.y = m_scPos.y + headerSize.h;
 	boxSize.w = headerSize.w;
 	boxSize.h = m_scSize.h - headerSize.h;
+
+	// row height could have changed
+	m_iScrollBarRows = -1;
+	m_flVelocity = 0.0f;
+	m_flScroll = iTopItem * m_scChSize;
+	EnsureVisible( iCurItem );
+}
+
+void CMenuTable::TranslateRenderPosition( Point delta )
+{
+	BaseClass::TranslateRenderPosition( delta );
+
+	upArrow += delta;
+	downArrow += delta;
+	boxPos += delta;
+
+	m_iScrollBarRows = -1;
 }
 
 bool CMenuTable::MouseMove( int x, int y )
 {
-	if( !iScrollBarSliding && FBitSet( iFlags, QMF_HASMOUSEFOCUS ))
+	if( iScrollBarSliding )
 	{
-		float step = Step();
-
-		if( UI_CursorInRect( boxPos, boxSize ))
-		{
-			static float ac_y = 0;
+		int range = m_iTrackLength - sbarSize.h;
 
-			ac_y += cursorDY;
-			cursorDY = 0;
-			if( ac_y > m_scChSize / 2.0f )
-			{
-				iTopItem -= ac_y / m_scChSize - 0.5f;
-				ac_y = 0;
-			}
-			if( ac_y < -m_scChSize / 2.0f )
-			{
-				iTopItem -= ac_y / m_scChSize - 0.5f;
-				ac_y = 0;
-			}
-		}
-		else if( UI_CursorInRect( sbarPos, sbarSize ))
-		{
-			static float ac_y = 0;
+		if( range > 0 )
+			SetScroll(( uiStatic.cursorY - m_iScrollBarGrab - m_iTrackTop ) * MaxScroll() / range );
 
-			ac_y += cursorDY;
-			cursorDY = 0;
-			if( ac_y < -step )
-			{
-				iTopItem += ac_y / step + 0.5f;
-				ac_y = 0;
-			}
-			if( ac_y > step )
-			{
-				iTopItem += ac_y / step + 0.5f;
-				ac_y = 0;
-			}
-		}
+		return true;
 	}
 
-	if( iScrollBarSliding )
+	// dragged content follows the cursor, speed is kept for kinetic scrolling
+	if( g_bCursorDown && cursorDY && FBitSet( iFlags, QMF_HASMOUSEFOCUS ) && UI_CursorInRect( boxPos, boxSize ))
 	{
-		int dist = uiStatic.cursorY - sbarPos.y - (sbarSize.h / 2);
-
-		if((((dist / 2) > (m_scChSize / 2)) || ((dist / 2) < (m_scChSize / 2))) && iTopItem <= (m_pModel->GetRows() - iNumRows ) && iTopItem >= 0)
-		{
-			//_Event( QM_CHANGED );
+		int dt = uiStatic.realTime - m_iLastScrollTime;
+		float velocity = -cursorDY * 1000.0f / Q_max( dt, 1 );
 
-			if((dist / 2) > ( m_scChSize / 2 ) && iTopItem < ( m_pModel->GetRows() - iNumRows - 1 ))
-			{
-				iTopItem++;
-			}
+		// touch events are uneven, average them unless finger has stopped
+		m_flVelocity = dt > 100 ? velocity : ( m_flVelocity + velocity ) * 0.5f;
+		m_flDragDistance += fabs( cursorDY );
+		m_iLastScrollTime = uiStatic.realTime;
 
-			if((dist / 2) < -(m_scChSize / 2) && iTopItem > 0 )
-			{
-				iTopItem--;
-			}
-		}
+		SetScroll( m_flScroll - cursorDY );
+		cursorDY = 0;
 	}
 
-	iTopItem = bound( 0, iTopItem, m_pModel->GetRows() - iNumRows );
-
 	return true;
 }
 
-bool CMenuTable::MoveView(int delta )
+bool CMenuTable::MoveView( int delta )
 {
-	iTopItem += delta;
+	float scroll = m_flScroll;
 
-	if( iTopItem < abs(delta) )
-	{
-		iTopItem = 0;
-		return false;
-	}
-	else if( iTopItem > m_pModel->GetRows() - iNumRows )
-	{
-		if( m_pModel->GetRows() - iNumRows < 0 )
-			iTopItem = 0;
-		else
-			iTopItem = m_pModel->GetRows() - iNumRows;
-		return false;
-	}
+	m_flVelocity = 0.0f;
+	SetScroll( m_flScroll + delta * m_scChSize );
 
-	return true;
+	return m_flScroll != scroll;
 }
 
 bool CMenuTable::MoveCursor(int delta)
@@ -224,28 +187,108 @@ void CMenuTable::SetCurrentIndex( int idx )
 {
 	iCurItem = bound( 0, idx, m_pModel->GetRows() );
 
-	if( iCurItem < iTopItem )
-		iTopItem = iCurItem;
 	if( iNumRows ) // check if already vidinit
+		EnsureVisible( iCurItem );
+	else SetScroll( 0.0f ); // will be recalculated on vidinit
+}
+
+void CMenuTable::SetScroll( float scroll )
+{
+	m_flScroll = bound( 0.0f, scroll, MaxScroll() );
+	iTopItem = m_scChSize > 0 ? (int)( m_flScroll / m_scChSize ) : 0;
+}
+
+float CMenuTable::MaxScroll( void ) const
+{
+	return Q_max( 0.0f, (float)( m_pModel->GetRows() * m_scChSize - boxSize.h ));
+}
+
+void CMenuTable::EnsureVisible( int line )
+{
+	float top = line * m_scChSize;
+	float bottom = top + m_scChSize;
+
+	m_flVelocity = 0.0f;
+
+	if( top < m_flScroll )
+		SetScroll( top );
+	else if( bottom > m_flScroll + boxSize.h )
+		SetScroll( bottom - boxSize.h );
+	else SetScroll( m_flScroll );
+}
+
+void CMenuTable::UpdateMomentum( void )
+{
+	if( g_bCursorDown || iScrollBarSliding || m_flVelocity == 0.0f )
+		return;
+
+	float dt = ( uiStatic.realTime - m_iLastScrollTime ) / 1000.0f;
+
+	// finger stood still before release, or frame took too long
+	if( dt > 0.1f )
 	{
-		if( iCurItem > iTopItem + iNumRows - 1 )
-			iTopItem = iCurItem - iNumRows + 1;
-		if( iTopItem > m_pModel->GetRows() - iNumRows )
-			iTopItem = m_pModel->GetRows() - iNumRows;
-		if( iTopItem < 0 )
-			iTopItem = 0;
-	}
-	else
-	{
-		iTopItem = 0; // will be recalculated on vidinit
+		m_flVelocity = 0.0f;
+		return;
 	}
+
+	if( dt <= 0.0f )
+		return;
+
+	float scroll = m_flScroll;
+
+	m_iLastScrollTime = uiStatic.realTime;
+	SetScroll( m_flScroll + m_flVelocity * dt );
+	m_flVelocity -= m_flVelocity * Q_min( 1.0f, SCROLL_FRICTION * dt );
+
+	// slowed down or hit the end
+	if( fabs( m_flVelocity ) < SCROLL_MIN_VELOCITY || m_flScroll == scroll )
+		m_flVelocity = 0.0f;
 }
 
-float CMenuTable::Step()
+/*
+=================
+CMenuTable::UpdateScrollBar
+
+Thumb size only depends on row count and table size,
+so it's recomputed when one of them changes.
+=================
+*/
+void CMenuTable::UpdateScrollBar( void )
 {
-	float step = (m_pModel->GetRows() <= 1 ) ? 1 : (downArrow.y - upArrow.y - arrow.h) / (float)(m_pModel->GetRows() - 1);
+	int rows = m_pModel->GetRows();
+	float content = rows * m_scChSize;
 
-	return step;
+	m_iScrollBarRows = rows;
+	m_iTrackTop = upArrow.y + arrow.h;
+	m_iTrackLength = downArrow.y - upArrow.y - arrow.h;
+
+	sbarPos.x = upArrow.x + arrow.w * 0.125f;
+	sbarSize.w = arrow.w * 0.75f;
+
+	// as much of the track as the box shows, but still big enough to grab
+	if( content > boxSize.h )
+		sbarSize.h = Q_max( (int)( m_iTrackLength * boxSize.h / content ), Q_min( m_iTrackLength, arrow.h ));
+	else sbarSize.h = m_iTrackLength;
+
+	// rows could be removed from under the view
+	SetScroll( m_flScroll );
+}
+
+int CMenuTable::LineAtCursor( void ) const
+{
+	if( m_scChSize <= 0 || !UI_CursorInRect( boxPos, boxSize ))
+		return -1;
+
+	int line = ( uiStatic.cursorY - boxPos.y + m_flScroll ) / m_scChSize;
+
+	return line < m_pModel->GetRows() ? line : -1;
+}
+
+// printable keys come as Char too, searchable table takes them
+// so holder doesn't fire buttons with the same hotkey
+static inline bool IsSearchKey( const CMenuBaseModel *model, int key )
+{
+	return key > ' ' && key < 127 && model->IsSearchable();
 }
 
 bool CMenuTable::KeyUp( int key )
@@ -256,6 +299,9 @@ bool CMenuTable::KeyUp( int key )
 
 	iScrollBarSliding = false;
 
+	if( IsSearchKey( m_pModel, key ))
+		return true; // predict state
+
 	if( UI::Key::IsLeftMouse( key ))
 	{
 		noscroll = true; // don't scroll to current when mouse used
@@ -277,31 +323,25 @@ bool CMenuTable::KeyUp( int key )
 			}
 			else if( UI_CursorInRect( boxPos, boxSize ))
 			{
-				// test for item select
-				int starty = boxPos.y + iStrokeWidth;
-				int endy = starty + iNumRows * m_scChSize;
-				if( uiStatic.cursorY > starty && uiStatic.cursorY < endy )
-				{
-					int offsety = uiStatic.cursorY - starty;
-					int newCur = iTopItem + offsety / m_scChSize;
+				// test for item select, unless it was a drag
+				int newCur = LineAtCursor();
 
-					if( newCur < m_pModel->GetRows() )
+				if( newCur >= 0 && m_flDragDistance < m_scChSize / 2 )
+				{
+					if( newCur == iCurItem )
 					{
-						if( newCur == iCurItem )
+						if( uiStatic.realTime - m_iLastItemMouseChange < 200 ) // 200 msec to double click
 						{
-							if( uiStatic.realTime - m_iLastItemMouseChange < 200 ) // 200 msec to double click
-							{
-								m_pModel->OnActivateEntry( iCurItem );
-							}
+							m_pModel->OnActivateEntry( iCurItem );
 						}
-						else
-						{
-							iCurItem = newCur;
-							sound = uiStatic.sounds[SND_NULL];
-						}
-
-						m_iLastItemMouseChange = uiStatic.realTime;
 					}
+					else
+					{
+						iCurItem = newCur;
+						sound = uiStatic.sounds[SND_NULL];
+					}
+
+					m_iLastItemMouseChange = uiStatic.realTime;
 				}
 			}
 			else if( bAllowSorting && UI_CursorInRect( m_scPos, headerSize ))
@@ -343,16 +383,7 @@ bool CMenuTable::KeyUp( int key )
 	}
 
 	if( !noscroll )
-	{
-		if( iCurItem < iTopItem )
-			iTopItem = iCurItem;
-		if( iCurItem > iTopItem + iNumRows - 1 )
-			iTopItem = iCurItem - iNumRows + 1;
-		if( iTopItem > m_pModel->GetRows() - iNumRows )
-			iTopItem = m_pModel->GetRows() - iNumRows;
-		if( iTopItem < 0 )
-			iTopItem = 0;
-	}
+		EnsureVisible( iCurItem );
 
 	if( sound )
 	{
@@ -370,6 +401,9 @@ bool CMenuTable::KeyDown( int key )
 	const char *sound = 0;
 	bool noscroll = false;
 
+	if( IsSearchKey( m_pModel, key ))
+		return true; // predict state
+
 	if( UI::Key::IsUpArrow( key ))
 		sound = MoveCursor( -1 ) ? uiStatic.sounds[SND_MOVE] : 0;
 	else if( UI::Key::IsDownArrow( key ))
@@ -406,23 +440,22 @@ bool CMenuTable::KeyDown( int key )
 
 		if( FBitSet( iFlags, QMF_HASMOUSEFOCUS ))
 		{
+			// press stops kinetic scrolling
+			m_flVelocity = 0.0f;
+			m_flDragDistance = 0.0f;
+			m_iLastScrollTime = uiStatic.realTime;
+
 			// test for scrollbar
 			if( UI_CursorInRect( sbarPos, sbarSize ))
+			{
 				iScrollBarSliding = true;
+				m_iScrollBarGrab = uiStatic.cursorY - sbarPos.y;
+			}
 		}
 	}
 
 	if( !noscroll )
-	{
-		if( iCurItem < iTopItem )
-			iTopItem = iCurItem;
-		if( iCurItem > iTopItem + iNumRows - 1 )
-			iTopItem = iCurItem - iNumRows + 1;
-		if( iTopItem > m_pModel->GetRows() - iNumRows )
-			iTopItem = m_pModel->GetRows() - iNumRows;
-		if( iTopItem < 0 )
-			iTopItem = 0;
-	}
+		EnsureVisible( iCurItem );
 
 	if( sound )
 	{
@@ -435,6 +468,56 @@ bool CMenuTable::KeyDown( int key )
 	return sound != NULL;
 }
 
+/*
+=================
+CMenuTable::Char
+
+Type-ahead search, typed letters build a prefix until a pause.
+Same letter typed again goes through lines starting with it.
+=================
+*/
+void CMenuTable::Char( int key )
+{
+	if( key < 32 || ( key == ' ' && !m_iSearchLen ))
+		return;
+
+	if( uiStatic.realTime - m_iLastSearchTime > SEARCH_TIMEOUT )
+		m_iSearchLen = 0;
+
+	m_iLastSearchTime = uiStatic.realTime;
+
+	if( m_iSearchLen < (int)sizeof( m_szSearch ) - 1 )
+	{
+		m_szSearch[m_iSearchLen++] = key;
+		m_szSearch[m_iSearchLen] = 0;
+	}
+
+	bool repeat = true;
+	for( int i = 0; i < m_iSearchLen && repeat; i++ )
+		repeat = m_szSearch[i] == key;
+
+	int line;
+
+	if( repeat )
+	{
+		char prefix[2] = { (char)key, 0 };
+		line = m_pModel->FindNext( prefix, iCurItem );
+	}
+	else
+	{
+		// current line is fine while it still matches
+		line = m_pModel->FindNext( m_szSearch, iCurItem - 1 );
+	}
+
+	if( line < 0 || line == iCurItem )
+		return;
+
+	iCurItem = line;
+	EnsureVisible( iCurItem );
+	_Event( QM_CHANGED );
+	PlayLocalSound( uiStatic.sounds[SND_MOVE] );
+}
+
 void CMenuTable::DrawLine( Point p, const char **psz, size_t size, uint textColor, bool forceCol, uint fillColor )
 {
 	size_t i;
@@ -493,10 +576,49 @@ void CMenuTable::DrawLine( Point p, const char **psz, size_t size, uint textColo
 	}
 }
 
+void CMenuTable::InvalidateRowCache( void )
+{
+	FOR_EACH_VEC( m_rowCache, i )
+		m_rowCache[i].key = -1;
+}
+
+void CMenuTable::UpdateCellColors( cachedcell_t &cell, int line, int column )
+{
+	unsigned int color;
+	bool force = false;
+
+	cell.customColor = m_pModel->GetCellColors( line, column, color, force );
+	cell.forceColor = force;
+	cell.color = color;
+}
+
+void CMenuTable::FillCell( cachedcell_t &cell, int line, int column )
+{
+	const char *str = m_pModel->GetCellText( line, column );
+
+	cell.valid = str != NULL;
+	cell.text = str ? str : "";
+	cell.type = m_pModel->GetCellType( line, column );
+	cell.pic = 0;
+
+	if( str && cell.type != CELL_TEXT && cell.type != CELL_CUSTOM )
+	{
+		cell.pic = m_pModel->GetCellImage( line, column );
+		if( !cell.pic )
+			cell.pic = EngFuncs::PIC_Load( str );
+	}
+	cell.wrapped = m_pModel->IsCellTextWrapped( line, column );
+	cell.animated = m_pModel->IsCellAnimated( line, column );
+
+	UpdateCellColors( cell, line, column );
+}
+
 void CMenuTable::DrawLine( Point p, int line, uint textColor, bool forceCol, uint fillColor )
 {
 	int i;
 	Size sz;
+	cachedrow_t *row = NULL;
+	int key, version;
 
 	sz.h = m_scChSize;
 
@@ -510,8 +632,26 @@ void CMenuTable::DrawLine( Point p, int line, uint textColor, bool forceCol, uin
 
 	if( fillColor )
 	{
-		sz.w = headerSize.w;
-		UI_FillRect( p, sz, fillColor );
+		// fills aren't scissored, rows on box edges are partially visible
+		int top = Q_max( p.y, boxPos.y );
+		int bottom = Q_min( p.y + sz.h, boxPos.y + boxSize.h );
+
+		if( bottom > top )
+			UI_FillRect( p.x, top, headerSize.w, bottom - top, fillColor );
+	}
+
+	if( m_rowCache.Count() && m_pModel->GetRowVersion( line, key, version ))
+	{
+		row = &m_rowCache[line % m_rowCache.Count()];
+
+		if( row->key != key || row->version != version )
+		{
+			row->key = key;
+			row->version = version;
+
+			for( i = 0; i < m_pModel->GetColumns(); i++ )
+				FillCell( row->cells[i], line, i );
+		}
 	}
 
 	for( i = 0; i < m_pModel->GetColumns(); i++, p.x += sz.w )
@@ -525,14 +665,42 @@ void CMenuTable::DrawLine( Point p, int line, uint textColor, bool forceCol, uin
 		else
 			sz.w = ((float)boxSize.w - flFixedSumm) * columns[i].flWidth / flDynamicSumm;
 
-		const char *str = m_pModel->GetCellText( line, i );
-		const ECellType type = m_pModel->GetCellType( line, i );
+		const char *str;
+		ECellType type;
+		HIMAGE pic = 0;
+		bool wrapped, useCustomColors;
+
+		if( row )
+		{
+			cachedcell_t &cell = row->cells[i];
+
+			if( cell.animated )
+			{
+				UpdateCellColors( cell, line, i );
+
+				// fade is over, colors are constant again
+				cell.animated = m_pModel->IsCellAnimated( line, i );
+			}
+
+			str = cell.valid ? cell.text.String() : NULL;
+			type = cell.type;
+			pic = cell.pic;
+			wrapped = cell.wrapped;
+			useCustomColors = cell.customColor;
+			newFillColor = cell.color;
+			forceFillColor = cell.forceColor;
+		}
+		else
+		{
+			str = m_pModel->GetCellText( line, i );
+			type = m_pModel->GetCellType( line, i );
+			wrapped = m_pModel->IsCellTextWrapped( line, i );
+			useCustomColors = m_pModel->GetCellColors( line, i, newFillColor, forceFillColor );
+		}
 
 		if( !str /* && type != CELL_ITEM  */) // headers may be null, cells too
 			continue;
 
-		bool useCustomColors = m_pModel->GetCellColors( line, i, newFillColor, forceFillColor );
-
 		if( useCustomColors )
 		{
 			if( forceFillColor || forceCol )
@@ -546,14 +714,22 @@ void CMenuTable::DrawLine( Point p, int line, uint textColor, bool forceCol, uin
 		{
 		case CELL_TEXT:
 			UI_DrawString( font, p, sz, str, textColor, m_scChSize, m_pModel->GetAlignmentForColumn( i ),
-				textflags | ( m_pModel->IsCellTextWrapped( line, i ) ? 0 : ETF_NOSIZELIMIT ) );
+				textflags | ( wrapped ? 0 : ETF_NOSIZELIMIT ) );
+			break;
+		case CELL_CUSTOM:
+			m_pModel->DrawCell( line, i, p, sz, textColor );
 			break;
 		case CELL_IMAGE_ADDITIVE:
 		case CELL_IMAGE_DEFAULT:
 		case CELL_IMAGE_HOLES:
 		case CELL_IMAGE_TRANS:
 		{
-			HIMAGE pic = EngFuncs::PIC_Load( str );
+			if( !row )
+			{
+				pic = m_pModel->GetCellImage( line, i );
+				if( !pic )
+					pic = EngFuncs::PIC_Load( str );
+			}
 
 			if( !pic )
 				continue;
@@ -611,24 +787,20 @@ void CMenuTable::Draw()
 	int selColor = PackRGB( 80, 56, 24 );
 	int upFocus, downFocus, scrollbarFocus;
 
-	// HACKHACK: recalc iNumRows, to be not greater than iNumItems
-	iNumRows = ( m_scSize.h - iStrokeWidth * 2 ) / m_scChSize - 1;
-	if( iNumRows > m_pModel->GetRows() )
-		iNumRows = m_pModel->GetRows();
+	// partially visible rows at both edges and one spare slot,
+	// so scrolling by a line refills only one row
+	if( m_rowCache.Count() != Q_max( iNumRows, 0 ) + 3 )
+	{
+		m_rowCache.SetCount( Q_max( iNumRows, 0 ) + 3 );
+		InvalidateRowCache();
+	}
 
-	// HACKHACK: normalize iTopItem
-	// remove when there will be per-pixel scrolling
-	iTopItem = bound( 0, iTopItem, m_pModel->GetRows() - 1 );
+	if( m_iScrollBarRows != m_pModel->GetRows() )
+		UpdateScrollBar();
 
-	if( UI_CursorInRect( boxPos, boxSize ) )
-	{
-		int newCur = iTopItem + ( uiStatic.cursorY - boxPos.y ) / m_scChSize;
+	UpdateMomentum();
 
-		if( newCur < m_pModel->GetRows() )
-			iHighlight = newCur;
-		else iHighlight = -1;
-	}
-	else iHighlight = -1;
+	iHighlight = LineAtCursor();
 
 	if( szBackground )
 	{
@@ -670,21 +842,11 @@ void CMenuTable::Draw()
 	}
 
 
-	sbarPos.x = upArrow.x + arrow.w * 0.125f;
-	sbarSize.w = arrow.w * 0.75f;
+	float maxScroll = MaxScroll();
 
-	float step = Step();
-
-	if(((downArrow.y - upArrow.y - arrow.h) - (((m_pModel->GetRows()-1)*m_scChSize)/2)) < 2)
-	{
-		sbarSize.h = (downArrow.y - upArrow.y - arrow.h) - (step * (m_pModel->GetRows() - iNumRows));
-		sbarPos.y = upArrow.y + arrow.h + (step*iTopItem);
-	}
-	else
-	{
-		sbarSize.h = downArrow.y - upArrow.y - arrow.h - (((m_pModel->GetRows()- iNumRows) * m_scChSize) / 2);
-		sbarPos.y = upArrow.y + arrow.h + (((iTopItem) * m_scChSize)/2);
-	}
+	sbarPos.y = m_iTrackTop;
+	if( maxScroll > 0.0f )
+		sbarPos.y += ( m_iTrackLength - sbarSize.h ) * m_flScroll / maxScroll;
 
 	// draw the arrows base
 	UI_FillRect( upArrow.x, upArrow.y + arrow.h,
@@ -745,9 +907,12 @@ void CMenuTable::Draw()
 
 	// prevent the columns out of rectangle bounds
 	UI::Scissor::PushScissor( boxPos, boxSize );
-	y = boxPos.y;
 
-	for( i = iTopItem; i < m_pModel->GetRows() && i < iNumRows + iTopItem; i++, y += m_scChSize )
+	// only rows that intersect the box are asked from model
+	int rows = m_pModel->GetRows();
+	y = boxPos.y - (int)( m_flScroll - iTopItem * m_scChSize );
+
+	for( i = iTopItem; i < rows && y < boxPos.y + boxSize.h; i++, y += m_scChSize )
 	{
 		int color = colorBase; // predict state
 		bool forceCol = false;
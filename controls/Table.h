@@ -18,6 +18,7 @@ GNU General Public License for more details.
 
 #include "BaseItem.h"
 #include "BaseModel.h"
+#include "utlstring.h"
 
 #define MAX_TABLE_COLUMNS 16
 
@@ -52,13 +53,17 @@ public:
 
 	bool KeyUp( int key ) override;
 	bool KeyDown( int key ) override;
+	void Char( int key ) override;
 	void Draw() override;
 	void VidInit() override;
+	void TranslateRenderPosition( Point delta ) override;
 	bool MouseMove( int x, int y ) override;
 	bool MoveView( int delta );
 	bool MoveCursor( int delta );
 	int GetCurrentIndex() { return iCurItem; }
 	void SetCurrentIndex( int idx );
+	int GetTopIndex() const { return iTopItem; } // first row that is at least partially visible
+	int GetVisibleRows() const { return iNumRows; }
 	int GetSortingColumn( void ) { return m_iSortingColumn; }
 	bool IsAscend( void ) { return m_bAscend; }
 	void SetSortingColumn( int column, bool ascend = true )
@@ -95,10 +100,17 @@ public:
 
 	void SetModel( CMenuBaseModel *model )
 	{
+		PROFILE_SCOPE( "CMenuTable::SetModel" );
+
 		m_pModel = model;
 		m_pModel->Update();
+		InvalidateRowCache();
+		m_iScrollBarRows = -1;
 	}
 
+	// forget cached cells, for changes model can't express with row version
+	void InvalidateRowCache( void );
+
 	void SetHeaderText( int num, const char *text )
 	{
 		if( num < MAX_TABLE_COLUMNS && num >= 0 )
@@ -135,11 +147,44 @@ public:
 	CColor iHeaderColor;
 
 private:
-	float Step( void );
+	// scroll is in pixels, from the top of the first row to the top of the box
+	void SetScroll( float scroll );
+	float MaxScroll( void ) const;
+	void EnsureVisible( int line );
+	void UpdateMomentum( void );
+	void UpdateScrollBar( void );
+	int LineAtCursor( void ) const;
 
 	void DrawLine(Point p, const char **psz, size_t size, uint textColor, bool forceCol, uint fillColor = 0);
 	void DrawLine(Point p, int line, uint textColor, bool forceCol, uint fillColor = 0);
 
+	// model answers for one cell
+	struct cachedcell_t
+	{
+		CUtlString text;
+		bool valid; // model returned text
+		ECellType type;
+		HIMAGE pic;
+		bool wrapped;
+		bool animated;
+		bool customColor;
+		bool forceColor;
+		unsigned int color;
+	};
+
+	struct cachedrow_t
+	{
+		int key;
+		int version;
+		cachedcell_t cells[MAX_TABLE_COLUMNS];
+	};
+
+	void FillCell( cachedcell_t &cell, int line, int column );
+	void UpdateCellColors( cachedcell_t &cell, int line, int column );
+
+	// visible rows of versioned models, slot is line modulo count
+	CUtlVector<cachedrow_t> m_rowCache;
+
 	const char	*szHeaderTexts[MAX_TABLE_COLUMNS];
 	struct
 	{
@@ -158,17 +203,31 @@ private:
 	CImage szDownArrowPressed;
 
 	int		iTopItem;
-	int     iNumRows;
+	int     iNumRows; // rows that fit in the box entirely
+
+	float	m_flScroll;
+	float	m_flVelocity; // pixels per second, kinetic scrolling after touch release
+	float	m_flDragDistance; // since press, release after a drag doesn't select
+	int		m_iLastScrollTime; // uiStatic.realTime of last drag or momentum step
 // scrollbar stuff // ADAMIX
 	Point	sbarPos;
 	Size	sbarSize;
 	bool	iScrollBarSliding;
+	int		m_iScrollBarGrab; // cursor offset from the thumb top while sliding
+	int		m_iScrollBarRows; // model rows thumb size is computed for, -1 to recompute
+	int		m_iTrackTop;
+	int		m_iTrackLength;
 // highlight // mittorn
 	int		iHighlight;
 	int		iCurItem;
 
 	int		m_iLastItemMouseChange;
 
+	// type-ahead search
+	char	m_szSearch[32];
+	int		m_iSearchLen;
+	int		m_iLastSearchTime;
+
 	// sorting
 	int m_iSortingColumn;
 	bool m_bAscend;
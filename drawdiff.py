@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+# drawdiff.py -- compare draw call logs written by ui_drawrecord
+# Copyright(C) 2026 a1batross
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# usage: drawdiff.py old.mudr new.mudr
+#        drawdiff.py old_dir new_dir  -- compares every *.mudr with the same name
+# Prints call count deltas per window and the first record where
+# the draw stream differs. Exit code is 1 when logs are not identical.
+
+import os
+import struct
+import sys
+
+MAGIC = b'MUDR'
+VERSION = 1
+
+# keep in sync with DrawRecord.h
+OPS = [
+	# name,        payload format
+	('frame',      '<i'),
+	('window',     None),
+	('pic_set',    '<iI'),
+	('pic_draw',   None),
+	('pic_holes',  None),
+	('pic_trans',  None),
+	('pic_add',    None),
+	('scissor',    '<hhhh'),
+	('noscissor',  ''),
+	('fill',       '<hhhhI'),
+	('char',       '<hhhhiIi'),
+]
+
+PIC_OPS = range(3, 7)
+NO_WINDOW = '<no window>'
+
+def parse(path):
+	with open(path, 'rb') as f:
+		data = f.read()
+
+	if data[:4] != MAGIC:
+		raise ValueError('%s: not a draw record' % path)
+
+	version, = struct.unpack_from('<I', data, 4)
+	if version != VERSION:
+		raise ValueError('%s: unsupported version %d' % (path, version))
+
+	# list of (frame, window, [records])
+	windows = []
+	frame = -1
+	current = None
+	pos = 8
+
+	while pos < len(data):
+		op = data[pos]
+		pos += 1
+
+		if op >= len(OPS):
+			raise ValueError('%s: bad opcode %d at %d' % (path, op, pos - 1))
+
+		if op == 1:
+			length = data[pos]
+			name = data[pos + 1:pos + 1 + length].decode('utf-8', 'replace')
+			pos += 1 + length
+			current = (frame, name, [])
+			windows.append(current)
+			continue
+
+		if op in PIC_OPS:
+			args = struct.unpack_from('<hhhhB', data, pos)
+			pos += 9
+			if args[4]:
+				args = args[:4] + struct.unpack_from('<hhhh', data, pos)
+				pos += 8
+			else:
+				args = args[:4]
+		else:
+			fmt = OPS[op][1]
+			args = struct.unpack_from(fmt, data, pos) if fmt else ()
+			pos += struct.calcsize(fmt) if fmt else 0
+
+		if op == 0:
+			frame = args[0]
+			current = (frame, NO_WINDOW, [])
+			windows.append(current)
+			continue
+
+		current[2].append((op, args))
+
+	return windows
+
+def count(records):
+	counts = [0] * len(OPS)
+	for op, args in records:
+		counts[op] += 1
+	return counts
+
+def format_record(record):
+	op, args = record
+	return '%s%s' % (OPS[op][0], args)
+
+def compare(old_path, new_path):
+	old = parse(old_path)
+	new = parse(new_path)
+
+	print('--- %s' % old_path)
+	print('+++ %s' % new_path)
+
+	identical = True
+	total_old = [0] * len(OPS)
+	total_new = [0] * len(OPS)
+
+	for i in range(max(len(old), len(new))):
+		o = old[i] if i < len(old) else None
+		n = new[i] if i < len(new) else None
+
+		key = o[:2] if o else n[:2]
+		if o and n and o[:2] != n[:2]:
+			print('frame %d: window %s became %s, stream is out of sync' % (o[0], o[1], n[1]))
+			return False
+
+		co = count(o[2]) if o else [0] * len(OPS)
+		cn = count(n[2]) if n else [0] * len(OPS)
+		total_old = [a + b for a, b in zip(total_old, co)]
+		total_new = [a + b for a, b in zip(total_new, cn)]
+
+		orecs = o[2] if o else []
+		nrecs = n[2] if n else []
+
+		if orecs == nrecs:
+			continue
+
+		identical = False
+		print('frame %d, %s: %d -> %d calls' % (key[0], key[1], len(orecs), len(nrecs)))
+
+		for op in range(2, len(OPS)):
+			if co[op] != cn[op]:
+				print('\t%-10s %6d -> %6d (%+d)' % (OPS[op][0], co[op], cn[op], cn[op] - co[op]))
+
+		for j in range(max(len(orecs), len(nrecs))):
+			a = orecs[j] if j < len(orecs) else None
+			b = nrecs[j] if j < len(nrecs) else None
+			if a != b:
+				print('\tfirst difference at call %d:' % j)
+				print('\t- %s' % (format_record(a) if a else '<end>'))
+				print('\t+ %s' % (format_record(b) if b else '<end>'))
+				break
+
+	print('total: %d -> %d calls' % (sum(total_old[2:]), sum(total_new[2:])))
+	for op in range(2, len(OPS)):
+		if total_old[op] or total_new[op]:
+			print('\t%-10s %6d -> %6d (%+d)' % (OPS[op][0], total_old[op], total_new[op], total_new[op] - total_old[op]))
+
+	print('identical' if identical else 'differs')
+	return identical
+
+def main(argv):
+	if len(argv) != 3:
+		print('usage: %s old new' % argv[0])
+		return 2
+
+	old, new = argv[1], argv[2]
+
+	if not os.path.isdir(old):
+		return 0 if compare(old, new) else 1
+
+	identical = True
+	for name in sorted(os.listdir(old)):
+		if not name.endswith('.mudr'):
+			continue
+		if not os.path.exists(os.path.join(new, name)):
+			print('%s: missing in %s' % (name, new))
+			identical = False
+			continue
+		identical = compare(os.path.join(old, name), os.path.join(new, name)) and identical
+		print()
+
+	return 0 if identical else 1
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
@@ -22,6 +22,9 @@ GNU General Public License for more details.
 #include "extdll_menu.h"
 #include "Primitive.h"
 #include "netadr.h"
+#include "FillBatch.h"
+#include "Profiler.h"
+#include "DrawRecord.h"
 
 class EngFuncs
 {
@@ -29,26 +32,31 @@ public:
 	// image handlers
 	static inline HIMAGE PIC_Load( const char *szPicName, const byte *ucRawImage, int ulRawImageSize, int flags = 0)
 	{
+		ENGFUNCS_COUNT( PIC_Load );
 		return engfuncs.pfnPIC_Load( szPicName, ucRawImage, ulRawImageSize, flags );
 	}
 
 	static inline HIMAGE PIC_Load( const char *szPicName, int flags = 0)
 	{
+		ENGFUNCS_COUNT( PIC_Load );
 		return engfuncs.pfnPIC_Load( szPicName, 0, 0, flags );
 	}
 
 	static inline void PIC_Free( const char *szPicName )
 	{
+		ENGFUNCS_COUNT( PIC_Free );
 		engfuncs.pfnPIC_Free( szPicName );
 	}
 
 	static inline int PIC_Width( HIMAGE hPic )
 	{
+		ENGFUNCS_COUNT( PIC_Width );
 		return engfuncs.pfnPIC_Width( hPic );
 	}
 
 	static inline int PIC_Height( HIMAGE hPic )
 	{
+		ENGFUNCS_COUNT( PIC_Height );
 		return engfuncs.pfnPIC_Height( hPic );
 	}
 
@@ -60,21 +68,37 @@ public:
 
 	static inline void PIC_Draw( int x, int y, int width, int height, const wrect_t *prc = NULL )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( PIC_Draw );
+		if( UI::DrawRecord::bActive )
+			UI::DrawRecord::PicDraw( UI::DrawRecord::OP_PIC_DRAW, x, y, width, height, prc );
 		engfuncs.pfnPIC_Draw( x, y, width, height, prc );
 	}
 
 	static inline void PIC_DrawHoles( int x, int y, int width, int height, const wrect_t *prc = NULL )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( PIC_DrawHoles );
+		if( UI::DrawRecord::bActive )
+			UI::DrawRecord::PicDraw( UI::DrawRecord::OP_PIC_DRAWHOLES, x, y, width, height, prc );
 		engfuncs.pfnPIC_DrawHoles( x, y, width, height, prc );
 	}
 
 	static inline void PIC_DrawTrans( int x, int y, int width, int height, const wrect_t *prc = NULL )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( PIC_DrawTrans );
+		if( UI::DrawRecord::bActive )
+			UI::DrawRecord::PicDraw( UI::DrawRecord::OP_PIC_DRAWTRANS, x, y, width, height, prc );
 		engfuncs.pfnPIC_DrawTrans( x, y, width, height, prc );
 	}
 
 	static inline void PIC_DrawAdditive( int x, int y, int width, int height, const wrect_t *prc = NULL )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( PIC_DrawAdditive );
+		if( UI::DrawRecord::bActive )
+			UI::DrawRecord::PicDraw( UI::DrawRecord::OP_PIC_DRAWADDITIVE, x, y, width, height, prc );
 		engfuncs.pfnPIC_DrawAdditive( x, y, width, height, prc );
 	}
 
@@ -140,77 +164,98 @@ public:
 
 	static inline void PIC_EnableScissor( int x, int y, int width, int height )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( PIC_EnableScissor );
+		if( UI::DrawRecord::bActive )
+			UI::DrawRecord::Scissor( x, y, width, height );
 		engfuncs.pfnPIC_EnableScissor( x, y, width, height );
 	}
 
 	static inline void PIC_DisableScissor( void )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( PIC_DisableScissor );
+		if( UI::DrawRecord::bActive )
+			UI::DrawRecord::NoScissor();
 		engfuncs.pfnPIC_DisableScissor();
 	}
 
 	// screen handlers
+	// NOTE: fills are batched, see FillBatch.h
 	static void FillRGBA( int x, int y, int width, int height, int r, int g, int b, int a );
 
 	// cvar handlers
 	static inline cvar_t *CvarRegister( const char *szName, const char *szValue, int flags )
 	{
+		ENGFUNCS_COUNT( CvarRegister );
 		return engfuncs.pfnRegisterVariable( szName, szValue, flags );
 	}
 
 	static inline float GetCvarFloat( const char *szName )
 	{
+		ENGFUNCS_COUNT( GetCvarFloat );
 		return engfuncs.pfnGetCvarFloat( szName );
 	}
 
 	static inline const char *GetCvarString( const char *szName )
 	{
+		ENGFUNCS_COUNT( GetCvarString );
 		return engfuncs.pfnGetCvarString( szName );
 	}
 
 	static inline void CvarSetString( const char *szName, const char *szValue )
 	{
+		ENGFUNCS_COUNT( CvarSetString );
 		engfuncs.pfnCvarSetString( szName, szValue );
 	}
 
 	static inline void CvarSetValue( const char *szName, float flValue )
 	{
+		ENGFUNCS_COUNT( CvarSetValue );
 		engfuncs.pfnCvarSetValue( szName, flValue );
 	}
 
 	// command handlers
 	static inline int Cmd_AddCommand( const char *cmd_name, void (*function)(void) )
 	{
+		ENGFUNCS_COUNT( Cmd_AddCommand );
 		return engfuncs.pfnAddCommand( cmd_name, function );
 	}
 
 	static inline void ClientCmd( bool execute_now, const char *szCmdString )
 	{
+		ENGFUNCS_COUNT( ClientCmd );
 		engfuncs.pfnClientCmd( execute_now, szCmdString );
 	}
 
 	static inline void Cmd_RemoveCommand( const char *cmd_name )
 	{
+		ENGFUNCS_COUNT( Cmd_RemoveCommand );
 		engfuncs.pfnDelCommand( cmd_name );
 	}
 
 	static inline int CmdArgc( void )
 	{
+		ENGFUNCS_COUNT( CmdArgc );
 		return engfuncs.pfnCmdArgc();
 	}
 
 	static inline const char *CmdArgv( int argi )
 	{
+		ENGFUNCS_COUNT( CmdArgv );
 		return engfuncs.pfnCmdArgv( argi );
 	}
 
 	static inline const char *CmdArgs( void )
 	{
+		ENGFUNCS_COUNT( CmdArgs );
 		return engfuncs.pfnCmd_Args();
 	}
 
 	// sound handlers
 	static inline void PlayLocalSound( const char *szSound )
 	{
+		ENGFUNCS_COUNT( PlayLocalSound );
 		engfuncs.pfnPlayLocalSound( szSound );
 	}
 
@@ -219,26 +264,32 @@ public:
 
 	static inline void PrecacheLogo( const char *filename )
 	{
+		ENGFUNCS_COUNT( PrecacheLogo );
 		engfuncs.pfnDrawLogo( filename, 0, 0, 0, 0 );
 	}
 
 	static inline int GetLogoWidth( void )
 	{
+		ENGFUNCS_COUNT( GetLogoWidth );
 		return engfuncs.pfnGetLogoWidth();
 	}
 
 	static inline int GetLogoHeight( void )
 	{
+		ENGFUNCS_COUNT( GetLogoHeight );
 		return engfuncs.pfnGetLogoHeight();
 	}
 
 	static inline float GetLogoLength( void ) // cinematic duration in seconds
 	{
+		ENGFUNCS_COUNT( GetLogoLength );
 		return engfuncs.pfnGetLogoLength();
 	}
 
 	// text message system
 	static void DrawCharacter( int x, int y, int width, int height, int ch, int ulRGBA, HIMAGE hFont );
+	// engine's own console font, returns character width
+	static int DrawConsoleCharacter( int x, int y, int ch, unsigned int color );
 	static int DrawConsoleString( int x, int y, const char *string );
 	static void DrawSetTextColor( int r, int g, int b, int alpha = 255 );
 	static void ConsoleStringLen(  const char *string, int *length, int *height );
@@ -251,30 +302,37 @@ public:
 
 	static inline void SetConsoleDefaultColor( int r, int g, int b ) // color must came from colors.lst
 	{
+		ENGFUNCS_COUNT( SetConsoleDefaultColor );
 		engfuncs.pfnSetConsoleDefaultColor( r, g, b );
 	}
 
 	// custom rendering (for playermodel preview)
 	static inline struct cl_entity_s *GetPlayerModel( void )	// for drawing playermodel previews
 	{
+		ENGFUNCS_COUNT( GetPlayerModel );
 		return engfuncs.pfnGetPlayerModel();
 	}
 
 	static inline void SetModel( struct cl_entity_s *ed, const char *path )
 	{
+		ENGFUNCS_COUNT( SetModel );
 		engfuncs.pfnSetModel( ed, path );
 	}
 
 	static inline void ClearScene( void )
 	{
+		ENGFUNCS_COUNT( ClearScene );
 		engfuncs.pfnClearScene();
 	}
 	static inline void RenderScene( const struct ref_viewpass_s *fd )
 	{
+		UI::FillBatch::Flush();
+		ENGFUNCS_COUNT( RenderScene );
 		engfuncs.pfnRenderScene( fd );
 	}
 	static inline int CL_CreateVisibleEntity( int type, struct cl_entity_s *ent )
 	{
+		ENGFUNCS_COUNT( CL_CreateVisibleEntity );
 		return engfuncs.CL_CreateVisibleEntity( type, ent );
 	}
 
@@ -282,33 +340,39 @@ public:
 	// static inline void HostError( const char *szFmt, ... );
 	static inline int FileExists( const char *filename, bool gamedironly = false )
 	{
+		ENGFUNCS_COUNT( FileExists );
 		return engfuncs.pfnFileExists( filename, gamedironly );
 	}
 
 	static inline void GetGameDir( char *szGetGameDir )
 	{
+		ENGFUNCS_COUNT( GetGameDir );
 		engfuncs.pfnGetGameDir( szGetGameDir );
 	}
 
 	// gameinfo handlers
 	static inline int CreateMapsList( int iRefresh )
 	{
+		ENGFUNCS_COUNT( CreateMapsList );
 		return engfuncs.pfnCreateMapsList( iRefresh );
 	}
 
 	static inline int ClientInGame( void )
 	{
+		ENGFUNCS_COUNT( ClientInGame );
 		return engfuncs.pfnClientInGame();
 	}
 
 	static inline void ClientJoin( const struct netadr_s adr )
 	{
+		ENGFUNCS_COUNT( ClientJoin );
 		engfuncs.pfnClientJoin( adr );
 	}
 
 	// parse txt files
 	static inline byte *COM_LoadFile( const char *filename, int *pLength = 0 )
 	{
+		ENGFUNCS_COUNT( COM_LoadFile );
 		return engfuncs.COM_LoadFile( filename, pLength );
 	}
 
@@ -320,170 +384,203 @@ public:
 
 	static inline void COM_FreeFile( void *buffer )
 	{
+		ENGFUNCS_COUNT( COM_FreeFile );
 		engfuncs.COM_FreeFile( buffer );
 	}
 
 	// keyfuncs
 	static inline void KEY_ClearStates( void ) // call when menu open or close
 	{
+		ENGFUNCS_COUNT( KEY_ClearStates );
 		engfuncs.pfnKeyClearStates();
 	}
 
 	static inline void KEY_SetDest( int dest )
 	{
+		ENGFUNCS_COUNT( KEY_SetDest );
 		engfuncs.pfnSetKeyDest( dest );
 	}
 
 	static inline const char *KeynumToString( int keynum )
 	{
+		ENGFUNCS_COUNT( KeynumToString );
 		return engfuncs.pfnKeynumToString( keynum );
 	}
 
 	static inline const char *KEY_GetBinding( int keynum )
 	{
+		ENGFUNCS_COUNT( KEY_GetBinding );
 		return engfuncs.pfnKeyGetBinding( keynum );
 	}
 
 	static inline void KEY_SetBinding( int keynum, const char *binding )
 	{
+		ENGFUNCS_COUNT( KEY_SetBinding );
 		engfuncs.pfnKeySetBinding( keynum, binding );
 	}
 
 	static inline int KEY_IsDown( int keynum )
 	{
+		ENGFUNCS_COUNT( KEY_IsDown );
 		return engfuncs.pfnKeyIsDown( keynum );
 	}
 
 	static inline int KEY_GetOverstrike( void )
 	{
+		ENGFUNCS_COUNT( KEY_GetOverstrike );
 		return  engfuncs.pfnKeyGetOverstrikeMode();
 	}
 
 	static inline void KEY_SetOverstrike( int fActive )
 	{
+		ENGFUNCS_COUNT( KEY_SetOverstrike );
 		engfuncs.pfnKeySetOverstrikeMode( fActive );
 	}
 
 	static inline void *KEY_GetState( const char *name )			// for mlook, klook etc
 	{
+		ENGFUNCS_COUNT( KEY_GetState );
 		return engfuncs.pfnKeyGetState( name );
 	}
 
 	// engine memory manager
 	static inline void *MemAlloc( size_t cb, const char *filename, const int fileline )
 	{
+		ENGFUNCS_COUNT( MemAlloc );
 		return engfuncs.pfnMemAlloc( cb, filename, fileline );
 	}
 
 	static inline void MemFree( void *mem, const char *filename, const int fileline )
 	{
+		ENGFUNCS_COUNT( MemFree );
 		engfuncs.pfnMemFree( mem, filename, fileline );
 	}
 
 	// collect info from engine
 	static inline gameinfo2_t *GetGameInfo( void )
 	{
+		ENGFUNCS_COUNT( GetGameInfo );
 		return textfuncs.pfnGetGameInfo( GAMEINFO_VERSION );
 	}
 
 	static inline gameinfo2_t *GetModInfo( int i ) // collect info about all mods
 	{
+		ENGFUNCS_COUNT( GetModInfo );
 		return textfuncs.pfnGetModInfo( GAMEINFO_VERSION, i );
 	}
 
 	static inline char **GetFilesList( const char *pattern, int *numFiles, int gamedironly ) // find in files
 	{
+		ENGFUNCS_COUNT( GetFilesList );
 		return engfuncs.pfnGetFilesList( pattern, numFiles, gamedironly );
 	}
 
 	static inline int GetSaveComment( const char *savename, char *comment )
 	{
+		ENGFUNCS_COUNT( GetSaveComment );
 		return  engfuncs.pfnGetSaveComment( savename, comment );
 	}
 
 	static inline int GetDemoComment( const char *demoname, char *comment )
 	{
+		ENGFUNCS_COUNT( GetDemoComment );
 		return  engfuncs.pfnGetDemoComment( demoname, comment );
 	}
 
 	static inline int CheckGameDll( void )	// returns false if hl.dll is missed or invalid
 	{
+		ENGFUNCS_COUNT( CheckGameDll );
 		return engfuncs.pfnCheckGameDll();
 	}
 
 	static inline char *GetClipboardData( void )
 	{
+		ENGFUNCS_COUNT( GetClipboardData );
 		return  engfuncs.pfnGetClipboardData();
 	}
 
 	// engine launcher
 	static inline void ShellExecute( const char *name, const char *args, bool closeEngine )
 	{
+		ENGFUNCS_COUNT( ShellExecute );
 		engfuncs.pfnShellExecute( name, args, closeEngine );
 	}
 
 	static inline void WriteServerConfig( const char *name )
 	{
+		ENGFUNCS_COUNT( WriteServerConfig );
 		engfuncs.pfnWriteServerConfig( name );
 	}
 
 	static inline void PlayBackgroundTrack( const char *introName, const char *loopName )
 	{
+		ENGFUNCS_COUNT( PlayBackgroundTrack );
 		engfuncs.pfnPlayBackgroundTrack( introName, loopName );
 	}
 
 	static inline void StopBackgroundTrack( )
 	{
+		ENGFUNCS_COUNT( StopBackgroundTrack );
 		engfuncs.pfnPlayBackgroundTrack( NULL, NULL );
 	}
 
 	static inline void HostEndGame( const char *szFinalMessage )
 	{
+		ENGFUNCS_COUNT( HostEndGame );
 		engfuncs.pfnHostEndGame( szFinalMessage );
 	}
 
 	static inline float RandomFloat( float flLow, float flHigh )
 	{
+		ENGFUNCS_COUNT( RandomFloat );
 		return engfuncs.pfnRandomFloat( flLow, flHigh );
 	}
 
 	static inline int RandomLong( int lLow, int lHigh )
 	{
+		ENGFUNCS_COUNT( RandomLong );
 		return engfuncs.pfnRandomLong( lLow, lHigh );
 	}
 
 	static inline void SetCursor( void *hCursor ) // change cursor
 	{
+		ENGFUNCS_COUNT( SetCursor );
 		engfuncs.pfnSetCursor( hCursor );
 	}
 
 	static inline int IsMapValid( const char *filename )
 	{
+		ENGFUNCS_COUNT( IsMapValid );
 		return engfuncs.pfnIsMapValid( (char*)filename );
 	}
 
 	static inline void ProcessImage( int texnum, float gamma, int topColor = -1, int bottomColor = -1 )
 	{
+		ENGFUNCS_COUNT( ProcessImage );
 		engfuncs.pfnProcessImage( texnum, gamma, topColor, bottomColor );
 	}
 
 	static inline int CompareFileTime( const char *filename1, const char *filename2, int *iCompare )
 	{
+		ENGFUNCS_COUNT( CompareFileTime );
 		return engfuncs.pfnCompareFileTime( filename1, filename2, iCompare );
 	}
 
 	static inline const char *GetModeString( int mode )
 	{
+		ENGFUNCS_COUNT( GetModeString );
 		return engfuncs.pfnGetModeString( mode );
 	}
 
 	static inline int COM_SaveFile( const char *filename, const void *buffer, int len )
 	{
+		ENGFUNCS_COUNT( COM_SaveFile );
 		return engfuncs.COM_SaveFile( filename, buffer, len );
 	}
 
 	static inline int DeleteFile( const char *filename )
 	{
+		ENGFUNCS_COUNT( DeleteFile );
 		return engfuncs.COM_RemoveFile( filename );
 	}
 
@@ -492,37 +589,44 @@ public:
 
 	static inline void EnableTextInput( int enable )
 	{
+		ENGFUNCS_COUNT( EnableTextInput );
 		if( textfuncs.pfnEnableTextInput )
 			textfuncs.pfnEnableTextInput( enable );
 	}
 
 	static inline bool GetRenderers( int num, char *sz1, size_t s1, char *sz2, size_t s2 )
 	{
+		ENGFUNCS_COUNT( GetRenderers );
 		return textfuncs.pfnGetRenderers( num, sz1, s1, sz2, s2 ) != 0;
 	}
 
 	static inline double DoubleTime()
 	{
+		ENGFUNCS_COUNT( DoubleTime );
 		return textfuncs.pfnDoubleTime();
 	}
 
 	static inline char *COM_ParseFile( char *data, char *token, const int size )
 	{
+		ENGFUNCS_COUNT( COM_ParseFile );
 		return textfuncs.pfnParseFile( data, token, size, 0, nullptr );
 	}
 
 	static inline char *COM_ParseFile( char *data, char *token, const int size, int flags, int *len )
 	{
+		ENGFUNCS_COUNT( COM_ParseFile );
 		return textfuncs.pfnParseFile( data, token, size, flags, len );
 	}
 
 	static inline const char *NET_AdrToString( const netadr_t adr )
 	{
+		ENGFUNCS_COUNT( NET_AdrToString );
 		return textfuncs.pfnAdrToString( adr );
 	}
 
 	static inline int NET_CompareAdr( const void *a, const void *b )
 	{
+		ENGFUNCS_COUNT( NET_CompareAdr );
 		return textfuncs.pfnCompareAdr( a, b );
 	}
 
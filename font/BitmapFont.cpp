@@ -146,9 +146,6 @@ int CBitmapFont::DrawCharacter(int ch, Point pt, int charH, const unsigned int c
 	}
 	else
 	{
-		char str[2] = {(char)ch, 0};
-		EngFuncs::engfuncs.pfnDrawSetTextColor( Red( color ), Green( color ), Blue( color ), Alpha( color ) );
-
-		return EngFuncs::engfuncs.pfnDrawConsoleString( pt.x, pt.y, str ) - pt.x;
+		return EngFuncs::DrawConsoleCharacter( pt.x, pt.y, ch, color );
 	}
 }
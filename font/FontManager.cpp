@@ -473,6 +473,8 @@ void CFontManager::DebugDraw(HFont fontHandle)
 
 HFont CFontBuilder::Create()
 {
+	PROFILE_SCOPE( "CFontBuilder::Create" );
+
 	CBaseFont *font;
 
 	// check existing font at first
@@ -60,8 +60,13 @@ public:
 	CMenuKeysModel keysListModel;
 
 private:
-	void UnbindCommand( const char *command );
+	void UnbindLine( int line );
 	void ResetKeysList( void );
+	void ShowConflict( int key, int line );
+	void ClearConflict( void )
+	{
+		keysList.szStatusText = NULL;
+	}
 	void Cancel( void )
 	{
 		EngFuncs::ClientCmd( true, "exec keyboard\n" );
@@ -77,28 +82,27 @@ private:
 	} msgBox1; // small msgbox
 
 	CMenuYesNoMessageBox msgBox2; // large msgbox
+
+	char m_szConflict[256]; // status text of keys list after key was taken
 };
 
-void CMenuControls::UnbindCommand( const char *command )
+void CMenuControls::UnbindLine( int line )
 {
-	const size_t command_len = strlen( command );
-
-	for( int i = 0; ; i++ )
+	for( int key = keysListModel.NextBoundKey( line, -1 ); key >= 0; key = keysListModel.NextBoundKey( line, key ))
 	{
-		const char *str = EngFuncs::KeynumToString( i );
-
-		if( !strcmp( str, "<OUT OF RANGE>" ))
-			break;
-
-		const char *b = EngFuncs::KEY_GetBinding( i );
-		if( !b )
-			continue;
-
-		if( !strncmp( b, command, command_len ))
-			EngFuncs::KEY_SetBinding( i, "" );
+		EngFuncs::KEY_SetBinding( key, "" );
+		keysListModel.UpdateKey( key );
 	}
 }
 
+// key can only be bound to one action, tell which one lost it
+void CMenuControls::ShowConflict( int key, int line )
+{
+	snprintf( m_szConflict, sizeof( m_szConflict ), L( "%s is no longer bound to %s" ),
+		EngFuncs::KeynumToString( key ), keysListModel.entries[line].display );
+	keysList.szStatusText = m_szConflict;
+}
+
 void CMenuKeysModel::OnActivateEntry(int line)
 {
 	parent->EnterGrabMode();
@@ -111,11 +115,10 @@ void CMenuKeysModel::OnDeleteEntry(int line)
 
 void CMenuControls::ResetKeysList( void )
 {
-	char *afile = (char *)EngFuncs::COM_LoadFile( "gfx/shell/kb_def.lst", NULL );
-	char *pfile = afile;
-	char token[1024];
+	const CParsedFile *file = UI_LoadParsedFile( "gfx/shell/kb_def.lst" );
+	const char *token;
 
-	if( !afile )
+	if( !file )
 	{
 		UI_ShowMessageBox( "UI_Parse_KeysList: kb_act.lst not found\n" );
 		return;
@@ -123,14 +126,16 @@ void CMenuControls::ResetKeysList( void )
 	
 	EngFuncs::ClientCmd( true, "unbindall" );
 
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) != NULL )
+	CTokenReader reader( file );
+
+	while(( token = reader.Next( )) != NULL )
 	{
 		char	key[32];
 
 		Q_strncpy( key, token, sizeof( key ));
 
-		pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ));
-		if( !pfile ) break;	// technically an error
+		token = reader.Next();
+		if( !token ) break;	// technically an error
 
 		char	cmd[4096];
 
@@ -144,8 +149,8 @@ void CMenuControls::ResetKeysList( void )
 		EngFuncs::ClientCmd( true, cmd );
 	}
 
-	EngFuncs::COM_FreeFile( afile );
-	keysListModel.Update();
+	keysListModel.UpdateBindings();
+	ClearConflict();
 }
 
 bool CMenuControls::CGrabKeyMessageBox::KeyUp( int key )
@@ -162,14 +167,21 @@ bool CMenuControls::CGrabKeyMessageBox::KeyUp( int key )
 	}
 	else
 	{
-		const char *bindName = parent->keysListModel.entries[parent->keysList.GetCurrentIndex( )].bind;
+		int line = parent->keysList.GetCurrentIndex( );
+		const char *bindName = parent->keysListModel.entries[line].bind;
+		int conflict = parent->keysListModel.GetKeyLine( key );
 
 		EngFuncs::ClientCmdF( true, "bind \"%s\" \"%s\"\n", EngFuncs::KeynumToString( key ), bindName );
 
+		if( conflict >= 0 && conflict != line )
+			parent->ShowConflict( key, conflict );
+
+		// updates both rows if key is taken from another action
+		parent->keysListModel.UpdateKey( key );
+
 		sound = SND_LAUNCH;
 	}
 
-	parent->keysListModel.Update();
 	Hide();
 	PlayLocalSound( uiStatic.sounds[sound] );
 
@@ -189,11 +201,8 @@ void CMenuControls::UnbindEntry()
 		return; // not a key
 	}
 
-	const char *bindName = keysListModel.entries[keysList.GetCurrentIndex( )].bind;
-
-	UnbindCommand( bindName );
+	UnbindLine( keysList.GetCurrentIndex( ));
 	PlayLocalSound( uiStatic.sounds[SND_REMOVEKEY] );
-	keysListModel.Update();
 
 	// disabled: left command just unbinded
 	// msgBox1.Show();
@@ -208,13 +217,13 @@ void CMenuControls::EnterGrabMode()
 	}
 
 	// entering to grab-mode
-	const char *bindName = keysListModel.entries[keysList.GetCurrentIndex( )].bind;
+	int line = keysList.GetCurrentIndex( );
 
-	int keys[2];
+	ClearConflict();
 
-	CMenuKbActListModel::LookupBoundKeys( bindName, keys );
-	if( keys[1] != -1 )
-		UnbindCommand( bindName );
+	// both slots taken, new key replaces them
+	if( keysListModel.entries[line].keys[1] != -1 )
+		UnbindLine( line );
 
 	msgBox1.Show();
 
@@ -235,6 +244,7 @@ void CMenuControls::_Init( void )
 	keysList.SetupColumn( 0, L( "GameUI_Action" ), 0.50f );
 	keysList.SetupColumn( 1, L( "GameUI_KeyButton" ), 0.25f );
 	keysList.SetupColumn( 2, L( "GameUI_Alternate" ), 0.25f );
+	keysList.onChanged = VoidCb( &CMenuControls::ClearConflict );
 
 	msgBox1.SetMessage( L( "Press a key or button" ) );
 	msgBox1.Link( this );
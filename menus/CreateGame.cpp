@@ -27,7 +27,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "Table.h"
 #include "Action.h"
 #include "YesNoMessageBox.h"
-#include "Table.h"
+#include "SearchIndex.h"
+#include "ParsedFile.h"
 
 #define ART_BANNER		"gfx/shell/head_creategame"
 
@@ -63,8 +64,13 @@ public:
 
 		return NULL;
 	}
+	int FindNext( const char *prefix, int line ) override;
+	bool IsSearchable() const override { return true; }
 
 	CMenuCreateGame *parent;
+
+private:
+	CMenuSearchIndex m_search; // map names, filled on first search
 };
 
 class CMenuCreateGame : public CMenuFramework
@@ -162,14 +168,20 @@ CMenuMapListModel::Update
 */
 void CMenuMapListModel::Update( void )
 {
-	char *afile;
+	PROFILE_SCOPE( "CMenuMapListModel::Update" );
+
+	const CParsedFile *file = NULL;
 
 	if( !uiStatic.needMapListUpdate )
 		return;
 
 	RemoveAll();
+	m_search.Invalidate();
 
-	if( !EngFuncs::CreateMapsList( true ) || (afile = (char *)EngFuncs::COM_LoadFile( "maps.lst", NULL )) == NULL )
+	// list is written again, cached tokens could be old
+	UI_InvalidateParsedFile( "maps.lst" );
+
+	if( !EngFuncs::CreateMapsList( true ) || ( file = UI_LoadParsedFile( "maps.lst" )) == NULL )
 	{
 		parent->done->SetGrayed( true );
 		Con_Printf( "Cmd_GetMapsList: can't open maps.lst\n" );
@@ -183,15 +195,15 @@ void CMenuMapListModel::Update( void )
 		AddToTail( map );
 	}
 
-	char *pfile = afile;
-	char token[1024];
+	CTokenReader reader( file );
+	const char *token;
 
-	while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) != NULL )
+	while(( token = reader.Next( )) != NULL )
 	{
 		map_t map;
 
 		Q_strncpy( map.name, token, sizeof( map.name ));
-		if(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) == NULL )
+		if(( token = reader.Next( )) == NULL )
 		{
 			Q_strncpy( map.desc, map.name, sizeof( map.desc ));
 			AddToTail( map );
@@ -204,10 +216,28 @@ void CMenuMapListModel::Update( void )
 	if( Count( ) <= 1 )
 		parent->done->SetGrayed( true );
 
-	EngFuncs::COM_FreeFile( afile );
 	uiStatic.needMapListUpdate = false;
 }
 
+/*
+=================
+CMenuMapListModel::FindNext
+=================
+*/
+int CMenuMapListModel::FindNext( const char *prefix, int line )
+{
+	if( !m_search.IsValid() )
+	{
+		m_search.Clear();
+
+		// first line is random map, not a name
+		for( int i = 1; i < Count(); i++ )
+			m_search.Add( i, Element( i ).name );
+	}
+
+	return m_search.FindNext( prefix, line, Count() );
+}
+
 /*
 =================
 CMenuCreateGame::Init
@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "PicButton.h"
 #include "Action.h"
 #include "Table.h"
+#include "ColumnarModel.h"
 #include "YesNoMessageBox.h"
 #include "keydefs.h"
 
@@ -36,74 +37,42 @@ enum
 	COLUMN_SIZE,
 };
 
+// what's not shown in the table
 struct mod_t
 {
 	char dir[64];
 	char webSite[256];
-	char type[32];
-	char name[32];
-	char ver[32];
-	char size[32];
-	uint64_t bytes;
-
-	int TypeCmp( const mod_t &other ) const
-	{
-		return stricmp( type, other.type );
-	}
-
-	int NameCmp( const mod_t &other ) const
-	{
-		return stricmp( name, other.name );
-	}
-
-	int SizeCmp( const mod_t &other ) const
-	{
-		if( bytes > other.bytes ) return 1;
-		else if( bytes < other.bytes ) return -1;
-		return 0;
-	}
-
-#define GENERATE_COMPAR_FN( method ) \
-	static int method ## Ascend( const mod_t *a, const mod_t *b ) \
-	{\
-		return a->method( *b );\
-	}\
-	static int method ## Descend( const mod_t *a, const mod_t *b ) \
-	{\
-		return b->method( *a );\
-	}\
-
-	GENERATE_COMPAR_FN( TypeCmp )
-	GENERATE_COMPAR_FN( NameCmp )
-	GENERATE_COMPAR_FN( SizeCmp )
-#undef GENERATE_COMPAR_FN
 };
 
-class CMenuModListModel : public CMenuBaseModel
+class CMenuModListModel : public CMenuColumnarModel
 {
 public:
-	CMenuModListModel() :  m_iSortingColumn(COLUMN_NAME) {}
+	CMenuModListModel()
+	{
+		AddColumn( COLUMN_TYPE_STRING ); // COLUMN_TYPE
+		AddColumn( COLUMN_TYPE_STRING ); // COLUMN_NAME
+		AddColumn( COLUMN_TYPE_STRING ); // COLUMN_VER
+		AddColumn( COLUMN_TYPE_FLOAT );  // COLUMN_SIZE, bytes
+
+		SetSearchColumn( COLUMN_NAME );
+		SetSecondarySort( COLUMN_NAME, true );
+		Sort( COLUMN_NAME, true );
+	}
 
 	void Update() override;
-	int GetColumns() const override { return 4; }
-	int GetRows() const override { return mods.Count(); }
-	const char *GetCellText( int line, int column ) override
+
+	const mod_t &Mod( int line ) const { return mods[Row( line )]; }
+
+protected:
+	void FormatCell( int row, int column, char *buf, size_t size ) const override
 	{
-		switch (column)
-		{
-		case COLUMN_TYPE: return mods[line].type;
-		case COLUMN_NAME: return mods[line].name;
-		case COLUMN_VER: return mods[line].ver;
-		case COLUMN_SIZE: return mods[line].size;
-		default: return NULL;
-		}
+		float bytes = GetFloat( row, column );
+
+		Q_strncpy( buf, bytes > 0 ? Q_memprint( bytes ) : "0.0 Mb", size );
 	}
-	bool Sort( int column, bool ascend ) override;
 
-	CUtlVector<mod_t> mods;
 private:
-	int m_iSortingColumn;
-	bool m_bAscend;
+	CUtlVector<mod_t> mods; // by row
 };
 
 class CMenuCustomGame: public CMenuFramework
@@ -149,16 +118,18 @@ void CMenuCustomGame::UpdateExtras( )
 {
 	int i = modList.GetCurrentIndex();
 
-	if( !modListModel.mods.IsValidIndex( i ))
+	if( !modListModel.IsValidLine( i ))
 		return;
 
-	load->onReleased.pExtra = modListModel.mods[i].dir;
-	load->SetGrayed( !stricmp( modListModel.mods[i].dir, gMenu.m_gameinfo.gamefolder ) );
+	const mod_t &mod = modListModel.Mod( i );
 
-	go2url->onReleased.pExtra = modListModel.mods[i].webSite;
-	go2url->SetGrayed( modListModel.mods[i].webSite[0] == 0 );
+	load->onReleased.pExtra = (void *)mod.dir;
+	load->SetGrayed( !stricmp( mod.dir, gMenu.m_gameinfo.gamefolder ) );
 
-	msgBox.onPositive.pExtra = modListModel.mods[i].dir;
+	go2url->onReleased.pExtra = (void *)mod.webSite;
+	go2url->SetGrayed( mod.webSite[0] == 0 );
+
+	msgBox.onPositive.pExtra = (void *)mod.dir;
 }
 
 /*
@@ -168,71 +139,43 @@ CMenuModListModel::Update
 */
 void CMenuModListModel::Update( void )
 {
-	int i;
+	PROFILE_SCOPE( "CMenuModListModel::Update" );
 
+	RemoveAll();
 	mods.RemoveAll();
 
-	for( i = 0; ; i++ )
+	for( int i = 0; ; i++ )
 	{
 		gameinfo2_t *gi = EngFuncs::GetModInfo( i );
-		mod_t mod;
+		char name[32];
 
 		if( !gi )
 			break;
 
+		int row = AddRow();
+		mod_t &mod = mods[mods.AddToTail()];
+
 		Q_strncpy( mod.dir, gi->gamefolder, sizeof( mod.dir ));
 		Q_strncpy( mod.webSite, gi->game_url, sizeof( mod.webSite ));
-		Q_strncpy( mod.type, gi->type, sizeof( mod.type ));
-		Q_strncpy( mod.ver, gi->version, sizeof( mod.ver ));
 
-		if( ColorStrlen( gi->title ) > sizeof( mod.name ) - 1 ) // NAME_LENGTH
+		if( ColorStrlen( gi->title ) > sizeof( name ) - 1 ) // NAME_LENGTH
 		{
-			size_t s = sizeof( mod.name ) - 4;
+			size_t s = sizeof( name ) - 4;
 
-			Q_strncpy( mod.name, gi->title, s );
+			Q_strncpy( name, gi->title, s );
 
-			mod.name[s] = mod.name[s+1] = mod.name[s+2] = '.';
-			mod.name[s+3] = 0;
+			name[s] = name[s+1] = name[s+2] = '.';
+			name[s+3] = 0;
 		}
-		else Q_strncpy( mod.name, gi->title, sizeof( mod.name ));
+		else Q_strncpy( name, gi->title, sizeof( name ));
 
-		mod.bytes = gi->size;
-		if( gi->size > 0 )
-			Q_strncpy( mod.size, Q_memprint( gi->size ), sizeof( mod.size ));
-		else Q_strncpy( mod.size, "0.0 Mb", sizeof( mod.size ));
-
-		mods.AddToTail( mod );
-	}
-
-	if( i != 0 )
-	{
-		if( m_iSortingColumn != -1 )
-			Sort( m_iSortingColumn, m_bAscend );
-	}
-}
-
-bool CMenuModListModel::Sort(int column, bool ascend)
-{
-	m_iSortingColumn = column;
-	if( column == -1 )
-		return false; // disabled
-
-	m_bAscend = ascend;
-
-	switch( column )
-	{
-		case COLUMN_TYPE:
-			mods.Sort( ascend ? mod_t::TypeCmpAscend : mod_t::TypeCmpDescend );
-			return true;
-		case COLUMN_NAME:
-			mods.Sort( ascend ? mod_t::NameCmpAscend : mod_t::NameCmpDescend );
-			return true;
-		case COLUMN_SIZE:
-			mods.Sort( ascend ? mod_t::SizeCmpAscend : mod_t::SizeCmpDescend );
-			return true;
+		SetString( row, COLUMN_TYPE, gi->type );
+		SetString( row, COLUMN_NAME, name );
+		SetString( row, COLUMN_VER, gi->version );
+		SetFloat( row, COLUMN_SIZE, gi->size );
 	}
 
-	return false;
+	Resort();
 }
 
 /*
@@ -266,7 +209,7 @@ void CMenuCustomGame::_Init( void )
 
 	for( int i = 0; i < modListModel.GetRows(); i++ )
 	{
-		if( !stricmp( modListModel.mods[i].dir, gMenu.m_gameinfo.gamefolder ) )
+		if( !stricmp( modListModel.Mod( i ).dir, gMenu.m_gameinfo.gamefolder ) )
 		{
 			modList.SetCurrentIndex( i );
 			if( modList.onChanged )
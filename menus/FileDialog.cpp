@@ -70,6 +70,8 @@ void CMenuFileDialog::CPreview::Draw()
 
 void CMenuFileDialog::CFileListModel::Update( void )
 {
+	PROFILE_SCOPE( "CFileListModel::Update" );
+
 	char	**filenames;
 	int	i = 0, numFiles, j, k;
 
@@ -192,6 +192,8 @@ CMenuSavesListModel::Update
 */
 void CMenuSavesListModel::Update( void )
 {
+	PROFILE_SCOPE( "CMenuSavesListModel::Update" );
+
 	char **filenames;
 	int numFiles;
 
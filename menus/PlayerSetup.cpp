@@ -196,6 +196,8 @@ UI_PlayerSetup_FindModels
 */
 void CMenuPlayerSetup::CModelListModel::Update( void )
 {
+	PROFILE_SCOPE( "CModelListModel::Update" );
+
 	char	**filenames;
 	int numFiles, i;
 
@@ -228,6 +230,8 @@ CMenuPlayerSetup::FindLogos
 */
 void CMenuPlayerSetup::CLogosListModel::Update( )
 {
+	PROFILE_SCOPE( "CLogosListModel::Update" );
+
 	char	**filenames;
 	int numFiles, i;
 
@@ -17,6 +17,7 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
+#include <time.h>
 #include "Framework.h"
 #include "Bitmap.h"
 #include "YesNoMessageBox.h"
@@ -25,10 +26,14 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "Switch.h"
 #include "Field.h"
 #include "utlvector.h"
+#include "utlhashmap.h"
+#include "generichash.h"
 #include "CheckBox.h"
 #include "SpinControl.h"
 #include "StringArrayModel.h"
+#include "ColumnarModel.h"
 #include "DropDown.h"
+#include "Tokenizer.h"
 
 #define ART_BANNER_INET     "gfx/shell/head_inetgames"
 #define ART_BANNER_LAN      "gfx/shell/head_lan"
@@ -37,8 +42,14 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #define MAX_PING 9.999f
 #define FILTER_MAX_MAPS 16
+#define HISTORY_SAMPLES 32
+#define HISTORY_PING_STEP 4 // ms per quantized ping unit
 #define INTERNET_TAB_COUNT 4  // number of internet tabs; valid indices are 0..3
 
+#define SERVER_CACHE_FILE    "server_cache.bin"
+#define SERVER_CACHE_VERSION 1
+#define SERVER_CACHE_MAX_AGE ( 7 * 24 * 60 * 60 ) // seconds, older servers are dropped
+
 class CMenuServerBrowser;
 
 enum
@@ -49,98 +60,421 @@ enum
 	COLUMN_MAP,
 	COLUMN_PLAYERS,
 	COLUMN_PING,
+	COLUMN_HISTORY, // optional, see ui_serverhistory
 	COLUMN_IP,
 	COLUMN_LAST
 };
 
+// server lists this record is in, see server_t::lists
+enum
+{
+	LIST_INTERNET = 0, // + tab index
+	LIST_LAN = INTERNET_TAB_COUNT,
+	LIST_VIEW, // visible model
+};
+
+// hot part of server record, it's what filtering touches
+// strings and raw info string live in CServerStore
 struct server_t
 {
 	netadr_t adr;
-	char  info[512];
 	float ping;
-	int  numcl;
-	int  maxcl;
-	char name[64];
-	char mapname[64];
-	char clientsstr[64];
-	char pingstr[64];
-	char ipstr[64];
-	bool favorite;
-	bool havePassword;
-	bool isGoldSrc;
-	bool pending_info;
-
+	short numcl;
+	short maxcl;
+
+	int name;    // interned string
+	int mapname; // interned string
+	int info;    // offset in info arena
+	int infoCapacity;
+
+	bool favorite : 1;
+	bool havePassword : 1;
+	bool isGoldSrc : 1;
+	bool pending_info : 1;
+	bool stale : 1; // loaded from cache, didn't answer yet
+	byte lists; // bit per LIST_ enum
+	unsigned int lastSeen; // unix time of last response
+	int version; // bumped on every change, table caches formatted row by it
+
+	short prevNumcl;
 	float prevPing;
 	float pingChangedTime;
-	int   prevNumcl;
 	float playersChangedTime;
 	float mapChangedTime;
 
-	server_t( netadr_t adr, const char *info, bool is_favorite, bool pending_info = false );
-	void UpdateData();
+	server_t( netadr_t adr, bool is_favorite, bool pending_info = false );
 	void SetPing( float ping );
 
-	const char *ToProtocol( void )
+	const char *Name() const;
+	const char *Map() const;
+
+	bool IsInList( int list ) const { return FBitSet( lists, BIT( list )) != 0; }
+
+	const char *ToProtocol( void ) const
 	{
 		if( isGoldSrc ) return "gs";
 		return "49";
 	}
 
-	int NameCmp( const server_t &other ) const
+	int AdrCmp( const server_t &other ) const
 	{
-		return colorstricmp( name, other.name );
+		return EngFuncs::NET_CompareAdr( &adr, &other.adr );
 	}
 
-	int AdrCmp( const server_t &other ) const
+	bool IsEmpty( ) const
 	{
-		return EngFuncs::NET_CompareAdr( &adr, &other.adr );
+		return numcl == 0;
 	}
 
-	int MapCmp( const server_t &other ) const
+	bool IsFull( ) const
 	{
-		return stricmp( mapname, other.mapname );
+		return numcl >= maxcl;
 	}
+};
 
-	int ClientCmp( const server_t &other ) const
+// same rules as engine's NET_CompareAdr, but doesn't go through the engine
+struct NetAdrEqualFunctor
+{
+	bool operator()( const netadr_t &a, const netadr_t &b ) const
 	{
-		if( numcl > other.numcl ) return 1;
-		else if( numcl < other.numcl ) return -1;
-		return 0;
+		netadrtype_t type = NET_NetadrType( &a );
+
+		if( type != NET_NetadrType( &b ))
+			return false;
+
+		switch( type )
+		{
+		case NA_IP:
+			return a.ip4 == b.ip4 && a.port == b.port;
+		case NA_IP6:
+		case NA_MULTICAST_IP6:
+			return !memcmp( a.ip6_0, b.ip6_0, sizeof( a.ip6_0 )) && !memcmp( a.ip6_1, b.ip6_1, sizeof( a.ip6_1 )) && a.port == b.port;
+		default:
+			return true;
+		}
 	}
+};
 
-	int PingCmp( const server_t &other ) const
+struct NetAdrHashFunctor
+{
+	unsigned int operator()( const netadr_t &adr ) const
 	{
-		if( ping > other.ping ) return 1;
-		else if( ping < other.ping ) return -1;
-		return 0;
+		netadrtype_t type = NET_NetadrType( &adr );
+		unsigned int hash = ( type * 0x9E3779B1u ) ^ adr.port;
+
+		switch( type )
+		{
+		case NA_IP:
+			hash ^= adr.ip4 * 0x85EBCA6Bu;
+			break;
+		case NA_IP6:
+		case NA_MULTICAST_IP6:
+			for( size_t i = 0; i < sizeof( adr.ip6_1 ); i++ )
+				hash = ( hash ^ adr.ip6_1[i] ) * 0x01000193u;
+			break;
+		default:
+			return type; // port is ignored in comparison
+		}
+
+		return hash;
 	}
+};
 
-	bool IsEmpty( ) const
+// server list cache, records are used in place once header is checked
+// written in native byte order, it never leaves the machine
+struct servercache_header_t
+{
+	char ident[4]; // "MUSC"
+	int version;
+	int adrSize;    // sizeof( netadr_t ), engine may change it
+	int recordSize;
+	int counts[INTERNET_TAB_COUNT]; // records of each tab, in tab order
+	int stringsSize;
+};
+
+enum
+{
+	SERVERCACHE_GOLDSRC = BIT( 0 ),
+	SERVERCACHE_PASSWORD = BIT( 1 ),
+};
+
+struct servercache_record_t
+{
+	netadr_t adr;
+	float ping;
+	short numcl;
+	short maxcl;
+	int name;    // offset in string pool
+	int mapname; // offset in string pool
+	unsigned int lastSeen;
+	int flags;   // SERVERCACHE_ flags
+};
+
+// last responses of every server, one array per field, indexed by server id
+// samples are quantized to bytes, so thousands of servers take little memory
+class CServerHistory
+{
+public:
+	void Add( int id, float ping, int numcl );
+
+	int Count( int id ) const { return id < m_count.Count() ? m_count[id] : 0; }
+
+	// i = 0 is the oldest sample
+	int PingMs( int id, int i ) const { return m_ping[Slot( id, i )] * HISTORY_PING_STEP; }
+	int Players( int id, int i ) const { return m_players[Slot( id, i )]; }
+
+	// updated with every sample, so sorting doesn't recalculate them
+	int MedianPing( int id ) const { return id < m_median.Count() ? m_median[id] : 0; }
+	int Jitter( int id ) const { return id < m_jitter.Count() ? m_jitter[id] : 0; }
+
+private:
+	int Slot( int id, int i ) const
 	{
-		return numcl == 0;
+		int first = m_count[id] < HISTORY_SAMPLES ? 0 : m_head[id];
+
+		return id * HISTORY_SAMPLES + ( first + i ) % HISTORY_SAMPLES;
 	}
 
-	bool IsFull( ) const
+	CUtlVector<byte> m_ping;    // HISTORY_SAMPLES per server
+	CUtlVector<byte> m_players; // HISTORY_SAMPLES per server
+	CUtlVector<byte> m_head;    // slot for next sample
+	CUtlVector<byte> m_count;
+	CUtlVector<short> m_median; // ms
+	CUtlVector<short> m_jitter; // ms, mean difference between neighbour samples
+};
+
+// every server seen during this session, tabs and visible model refer to them by index
+class CServerStore
+{
+public:
+	CServerStore() : m_iNumStrings( 0 ), m_iInfoWaste( 0 ) { }
+
+	int Count() const { return m_servers.Count(); }
+	server_t &operator[]( int id ) { return m_servers[id]; }
+	const server_t &operator[]( int id ) const { return m_servers[id]; }
+
+	// returns -1 if not found
+	int Find( const netadr_t &adr ) const
 	{
-		return numcl >= maxcl;
+		int i = m_index.Find( adr );
+
+		return m_index.IsValidIndex( i ) ? m_index[i] : -1;
+	}
+
+	// placeholder until server answers, existing record is kept as is
+	int AddPending( netadr_t adr, const char *info, bool is_favorite );
+
+	// stores server response, creates record if needed
+	int Update( netadr_t adr, const char *info, const CInfoString &parsed, float ping );
+
+	// stale record from server cache, existing record is kept as is
+	int AddCached( const servercache_record_t &record, const char *strings );
+
+	const char *String( int handle ) const { return m_strings.Base() + handle; }
+	const char *Info( int id ) const { return m_infos.Base() + m_servers[id].info; }
+	const CServerHistory &History() const { return m_history; }
+
+private:
+	int Add( netadr_t adr, bool pending_info );
+	void SetInfo( int id, const char *info, const CInfoString &parsed );
+	void CompactInfos( void );
+	int Intern( const infospan_t &s );
+	static unsigned int HashSpan( const infospan_t &s );
+
+	CUtlVector<server_t> m_servers;
+	CUtlHashMap<netadr_t, int, NetAdrEqualFunctor, NetAdrHashFunctor> m_index;
+
+	// interned strings, open addressing table of offsets in m_strings
+	CUtlVector<char> m_strings;
+	CUtlVector<int>  m_stringTable;
+	int m_iNumStrings;
+
+	// raw info strings, slot is reused while new string fits
+	CUtlVector<char> m_infos;
+	int m_iInfoWaste;
+
+	CServerHistory m_history;
+};
+
+static CServerStore s_Servers;
+
+// filter dropdown values, see CMenuServerBrowser::_Init
+struct serverfilter_t
+{
+	serverfilter_t() : ping( MAX_PING ), empty( 0 ), full( 0 )
+	{
+		map[0] = 0;
+	}
+
+	bool Matches( const server_t &server ) const
+	{
+		if( server.ping > ping )
+			return false;
+
+		if( empty == '1' && !server.IsEmpty( ))
+			return false;
+		if( empty == '0' && server.IsEmpty( ))
+			return false;
+
+		if( full == '1' && !server.IsFull( ))
+			return false;
+		if( full == '0' && server.IsFull( ))
+			return false;
+
+		if( map[0] && colorstricmp( map, server.Map( )) != 0 )
+			return false;
+
+		return true;
+	}
+
+	float ping;  // seconds
+	char empty;  // '1', '0' or 0 for any
+	char full;   // same
+	char map[64];
+};
+
+struct IntEqualFunctor
+{
+	bool operator()( int a, int b ) const { return a == b; }
+};
+
+struct IntHashFunctor
+{
+	unsigned int operator()( int i ) const { return (unsigned int)i * 0x9E3779B1u; }
+};
+
+// filter attributes of servers in one list, so changing filters doesn't walk
+// every record: ping buckets and empty/full flags are bitsets over server ids,
+// servers on the same map are linked together
+class CServerFilterIndex
+{
+public:
+	CServerFilterIndex() : m_iMapsGeneration( 0 ) { }
+
+	// adds server or refreshes its attributes from the record
+	void Insert( int id );
+	void RemoveAll();
+
+	// ids of servers passing the filter, in no particular order
+	void Select( const serverfilter_t &filter, CUtlVector<int> &out ) const;
+
+	// map slots with most players first, maps without servers are skipped
+	void TopMaps( int count, CUtlVector<int> &out ) const;
+	const char *MapName( int slot ) const { return s_Servers.String( m_maps[slot].name ); }
+	int MapPlayers( int slot ) const { return m_maps[slot].players; }
+
+	// changes whenever map counts do
+	int MapsGeneration() const { return m_iMapsGeneration; }
+
+private:
+	enum { PING_BUCKETS = 6 };
+	static const float s_flPingBuckets[PING_BUCKETS];
+
+	struct entry_t
+	{
+		bool member;
+		byte bucket;
+		short players;
+		int map; // slot in m_maps or -1
+		int prevInMap;
+		int nextInMap;
+	};
+
+	struct mapstat_t
+	{
+		int name; // interned string
+		int head; // first server id
+		int servers;
+		int players;
+	};
+
+	static int PingBucket( float ping );
+	static void SetBit( CUtlVector<unsigned int> &bits, int id, bool value );
+	static bool GetBit( const CUtlVector<unsigned int> &bits, int id )
+	{
+		return ( bits[id >> 5] & BIT( id & 31 )) != 0;
+	}
+	static unsigned int FlagMask( unsigned int bits, char flag )
+	{
+		if( flag == '1' ) return bits;
+		if( flag == '0' ) return ~bits;
+		return ~0u;
+	}
+
+	static void SwapItems( CUtlVector<int> &v, int a, int b )
+	{
+		int t = v[a];
+		v[a] = v[b];
+		v[b] = t;
+	}
+
+	bool Test( int id, const serverfilter_t &filter, int lastBucket ) const;
+	bool LessPopular( int a, int b ) const;
+	void SiftDown( CUtlVector<int> &heap, int i, int count ) const;
+	void Link( int id, int name, int players );
+	void Unlink( int id );
+
+	CUtlVector<entry_t> m_entries; // by server id
+	CUtlVector<unsigned int> m_member;
+	CUtlVector<unsigned int> m_ping[PING_BUCKETS];
+	CUtlVector<unsigned int> m_empty;
+	CUtlVector<unsigned int> m_full;
+
+	CUtlVector<mapstat_t> m_maps;
+	CUtlHashMap<int, int, IntEqualFunctor, IntHashFunctor> m_mapIndex; // interned name -> slot
+	int m_iMapsGeneration;
+};
+
+// ids of servers in one tab, in arrival order
+class CServerList
+{
+public:
+	CServerList() : m_iList( LIST_INTERNET ) { }
+
+	void SetList( int list ) { m_iList = list; }
+
+	int Count() const { return m_ids.Count(); }
+	int operator[]( int i ) const { return m_ids[i]; }
+
+	bool Contains( const netadr_t &adr ) const
+	{
+		int id = s_Servers.Find( adr );
+
+		return id >= 0 && s_Servers[id].IsInList( m_iList );
+	}
+
+	void Add( int id )
+	{
+		if( s_Servers[id].IsInList( m_iList ))
+			return;
+
+		SetBits( s_Servers[id].lists, BIT( m_iList ));
+		m_ids.AddToTail( id );
+		m_index.Insert( id );
+	}
+
+	// record has changed, reindex it if it's ours
+	void Refresh( int id )
+	{
+		if( s_Servers[id].IsInList( m_iList ))
+			m_index.Insert( id );
+	}
+
+	void RemoveAll()
+	{
+		FOR_EACH_VEC( m_ids, i )
+			ClearBits( s_Servers[m_ids[i]].lists, BIT( m_iList ));
+
+		m_ids.RemoveAll();
+		m_index.RemoveAll();
 	}
 
-#define GENERATE_COMPAR_FN( method ) \
-	static int method ## Ascend( const void *a, const void *b ) \
-	{\
-		return (( const server_t *)a)->method( *(( const server_t *)b) );\
-	}\
-	static int method ## Descend( const void *a, const void *b ) \
-	{\
-		return (( const server_t *)b)->method( *(( const server_t *)a) );\
-	}\
-
-	GENERATE_COMPAR_FN( NameCmp )
-	GENERATE_COMPAR_FN( AdrCmp )
-	GENERATE_COMPAR_FN( MapCmp )
-	GENERATE_COMPAR_FN( ClientCmp )
-	GENERATE_COMPAR_FN( PingCmp )
-#undef GENERATE_COMPAR_FN
+	const CServerFilterIndex &Index() const { return m_index; }
+
+private:
+	int m_iList;
+	CUtlVector<int> m_ids;
+	CServerFilterIndex m_index;
 };
 
 struct favlist_entry_t
@@ -182,139 +516,277 @@ struct favlist_entry_t
 	bool favorited;
 };
 
-struct filterMap_t
+struct AdrStringEqualFunctor
+{
+	bool operator()( const CUtlString &a, const CUtlString &b ) const
+	{
+		return !strcmp( a.String(), b.String() );
+	}
+};
+
+struct AdrStringHashFunctor
+{
+	unsigned int operator()( const CUtlString &s ) const
+	{
+		return HashString( s.String() );
+	}
+};
+
+// favorites and history, indexed by normalized address string
+class CServerAddressList
 {
-	char name[64];
+public:
+	int Count() const { return m_entries.Count(); }
 
-	filterMap_t( ): filterMap_t( "" ) {}
+	favlist_entry_t &operator[]( int i ) { return m_entries[i]; }
+	const favlist_entry_t &operator[]( int i ) const { return m_entries[i]; }
 
-	filterMap_t( const filterMap_t &obj )
+	// returns first entry with this address, or -1
+	int Find( const char *sadr ) const
 	{
-		count = obj.count;
-		Q_strncpy( name, obj.name, sizeof( name ) );
-		Q_strncpy( display, obj.display, sizeof( display ) );
+		char key[sizeof( favlist_entry_t::sadr )];
+
+		Normalize( sadr, key, sizeof( key ));
+
+		int i = m_index.Find( CUtlString( key ));
+
+		return m_index.IsValidIndex( i ) ? m_index[i] : -1;
 	}
 
-	filterMap_t( const char *s, unsigned short c = 0 )
+	int Find( const char *sadr, const char *prot ) const
 	{
-		count = c;
-		Q_strncpy( name, s, sizeof( name ) );
-		UpdateDisplay( );
+		int i = Find( sadr );
+
+		if( i < 0 )
+			return -1;
+
+		char key[sizeof( favlist_entry_t::sadr )];
+		Normalize( sadr, key, sizeof( key ));
+
+		// same address with different protocols is rare, so just walk the rest
+		for( ; i < m_entries.Count(); i++ )
+		{
+			char entry[sizeof( favlist_entry_t::sadr )];
+			Normalize( m_entries[i].sadr, entry, sizeof( entry ));
+
+			if( !strcmp( key, entry ) && !strcmp( m_entries[i].prot, prot ))
+				return i;
+		}
+
+		return -1;
 	}
 
-	inline bool operator==( const char *s ) const
+	void AddToTail( const favlist_entry_t &entry )
 	{
-		return colorstricmp( name, s ) == 0;
+		int i = m_entries.AddToTail( entry );
+
+		char key[sizeof( favlist_entry_t::sadr )];
+		Normalize( entry.sadr, key, sizeof( key ));
+
+		if( !m_index.HasElement( CUtlString( key )))
+			m_index.Insert( CUtlString( key ), i );
 	}
 
-	void AddCount( unsigned short c )
+	void Remove( int i )
 	{
-		count += c;
-		UpdateDisplay();
+		m_entries.Remove( i );
+		Reindex();
 	}
 
-	const char *GetDisplay( ) const
+	void RemoveAll()
 	{
-		return display;
+		m_entries.RemoveAll();
+		m_index.RemoveAll();
 	}
 
-	static int CmpName( const filterMap_t *a, const filterMap_t *b )
+	// "1.2.3.4" and "1.2.3.4:27015" are the same server, case doesn't matter
+	static void Normalize( const char *sadr, char *out, size_t size )
 	{
-		return colorstricmp( a->name, b->name );
+		size_t len = 0;
+
+		while( *sadr == ' ' || *sadr == '\t' )
+			sadr++;
+
+		for( ; *sadr && len < size - 1; sadr++ )
+			out[len++] = tolower( *sadr );
+
+		while( len > 0 && ( out[len - 1] == ' ' || out[len - 1] == '\t' ))
+			len--;
+
+		out[len] = 0;
+
+		if( !strchr( out, ':' ) && len + 6 < size )
+			memcpy( out + len, ":27015", 7 );
 	}
 
-	static int CmpCount( const filterMap_t *a, const filterMap_t *b )
+private:
+	void Reindex()
 	{
-		unsigned short ca = a->count;
-		unsigned short cb = b->count;
-		return ca < cb ? -1 : (ca > cb ? 1 : 0);
+		m_index.RemoveAll();
+
+		FOR_EACH_VEC( m_entries, i )
+		{
+			char key[sizeof( favlist_entry_t::sadr )];
+			Normalize( m_entries[i].sadr, key, sizeof( key ));
+
+			if( !m_index.HasElement( CUtlString( key )))
+				m_index.Insert( CUtlString( key ), i );
+		}
 	}
 
-	static int CmpCountInvert( const filterMap_t *a, const filterMap_t *b )
+	CUtlVector<favlist_entry_t> m_entries;
+	CUtlHashMap<CUtlString, int, AdrStringEqualFunctor, AdrStringHashFunctor> m_index;
+};
+
+// paces ui_queryserver commands, so answers don't arrive in one burst
+// and each server's ping is measured from its own query
+class CServerQueryScheduler
+{
+public:
+	enum
+	{
+		QUERY_RETRIES = 2,
+	};
+
+	CServerQueryScheduler()
 	{
-		unsigned short ca = a->count;
-		unsigned short cb = b->count;
-		return ca < cb ? 1 : (ca > cb ? -1 : 0);
+		for( int i = 0; i < QUEUE_COUNT; i++ )
+			m_iQueueHead[i] = 0;
 	}
 
+	// queues query, entry that was already sent is queried again
+	void Queue( const favlist_entry_t &entry, const netadr_t &adr, bool favorite );
+	void RemoveAll();
+
+	// returns when query to this server was sent, or -1 if it's not ours
+	double Answered( const netadr_t &adr );
+
+	// sends queries for this frame, servers with these ids go first
+	void Frame( const CUtlVector<int> &visible );
+
 private:
-	char display[128];
-	unsigned short count;
+	enum
+	{
+		QUERY_WAITING = 0,
+		QUERY_SENT,
+		QUERY_ANSWERED,
+		QUERY_TIMEDOUT,
+	};
 
-	void UpdateDisplay()
+	enum
 	{
-		snprintf( display, sizeof( display ), "(%d) %s", count, name );
-	}
+		QUEUE_FAVORITES = 0,
+		QUEUE_OTHER,
+		QUEUE_COUNT
+	};
+
+	struct query_t
+	{
+		query_t( const favlist_entry_t &entry, const netadr_t &adr, bool favorite ) :
+			entry( entry ), adr( adr ), favorite( favorite ), sendTime( -1.0 ), retries( 0 ), state( QUERY_WAITING ) { }
+
+		favlist_entry_t entry;
+		netadr_t adr;
+		bool favorite;
+		double sendTime;
+		int retries;
+		int state;
+	};
+
+	bool Send( int i, double now );
+	void Push( int i );
+
+	CUtlVector<query_t> m_queries;
+	CUtlHashMap<netadr_t, int, NetAdrEqualFunctor, NetAdrHashFunctor> m_index;
+
+	// waiting queries, in queue order, consumed from head
+	CUtlVector<int> m_queues[QUEUE_COUNT];
+	int m_iQueueHead[QUEUE_COUNT];
+
+	CUtlVector<int> m_inFlight;
 };
 
-class CMenuGameListModel : public CMenuBaseModel
+// visible rows, copied from server store when server changes, so sorting
+// and drawing touch only the servers that are shown
+class CMenuGameListModel : public CMenuColumnarModel
 {
 public:
 	CMenuGameListModel( CMenuServerBrowser *parent ) :
-		CMenuBaseModel(), parent( parent ), m_iSortingColumn(-1)
+		parent( parent ), m_pSource( NULL ), m_hLock( 0 ), m_hFavorite( 0 )
 	{
-		filterPing = MAX_PING * 1000.0f;
-		filterEmpty = 0;
-		filterFull = 0;
+		AddColumn( COLUMN_TYPE_IMAGE, CELL_IMAGE_ADDITIVE ); // COLUMN_PASSWORD
+		AddColumn( COLUMN_TYPE_IMAGE, CELL_IMAGE_ADDITIVE ); // COLUMN_FAVORITE
+		AddColumn( COLUMN_TYPE_STRING );           // COLUMN_NAME
+		AddColumn( COLUMN_TYPE_STRING );           // COLUMN_MAP
+		AddColumn( COLUMN_TYPE_INT );              // COLUMN_PLAYERS, numcl << 16 | maxcl
+		AddColumn( COLUMN_TYPE_FLOAT );            // COLUMN_PING, seconds
+		AddColumn( COLUMN_TYPE_INT, CELL_CUSTOM ); // COLUMN_HISTORY, jitter << 16 | median ping
+		AddColumn( COLUMN_TYPE_STRING );           // COLUMN_IP
+
+		SetSearchColumn( COLUMN_NAME );
+
+		// servers with the same name, map or player count, closest first
+		SetSecondarySort( COLUMN_PING, true );
 	}
 
 	void Update() override;
 
-	int GetColumns() const override
-	{
-		return COLUMN_LAST; // havePassword, game, mapname, maxcl, ping, (hidden)ip
-	}
+	void DrawCell( int line, int column, Point pos, Size size, unsigned int color ) override;
 
-	int GetRows() const override
+	// record also has state that isn't in columns, like stale flag
+	bool GetRowVersion( int line, int &key, int &version ) const override
 	{
-		return servers.Count();
+		key = ServerId( line );
+		version = Server( line ).version;
+		return true;
 	}
 
-	ECellType GetCellType( int line, int column ) override
+	bool IsCellAnimated( int line, int column ) const override
 	{
-		if( column == COLUMN_PASSWORD || column == COLUMN_FAVORITE )
-			return CELL_IMAGE_ADDITIVE;
-		return CELL_TEXT;
-	}
+		const server_t &s = Server( line );
+		float changedTime;
 
-	const char *GetCellText( int line, int column ) override
-	{
 		switch( column )
 		{
-		case COLUMN_PASSWORD: return servers[line].havePassword ? ART_BANNER_LOCK : NULL;
-		case COLUMN_FAVORITE: return servers[line].favorite ? ART_BANNER_FAVORITE : NULL;
-		case COLUMN_NAME: return servers[line].name;
-		case COLUMN_MAP: return servers[line].mapname;
-		case COLUMN_PLAYERS: return servers[line].clientsstr;
-		case COLUMN_PING: return servers[line].pingstr;
-		case COLUMN_IP: return servers[line].ipstr;
-		default: return NULL;
+		case COLUMN_PING: changedTime = s.pingChangedTime; break;
+		case COLUMN_PLAYERS: changedTime = s.playersChangedTime; break;
+		case COLUMN_MAP: changedTime = s.mapChangedTime; break;
+		default: return false;
 		}
+
+		return changedTime > 0.0f && EngFuncs::DoubleTime() - changedTime < FLASH_FADE_TIME;
 	}
 
 	bool GetCellColors( int line, int column, unsigned int &textColor, bool &force) const override
 	{
-		const server_t &s = servers[line];
-		const float fadeTime = 1.5f;
-		const uint green = PackRGB( 64, 255, 64 );
-		const uint red = PackRGB( 255, 64, 64 );
-
+		const server_t &s = Server( line );
 		float changedTime = 0.0f;
-		uint flashColor = green;
+		uint flashColor;
+
+		// cached data is shown dimmed until server answers
+		if( s.stale )
+		{
+			if( column == COLUMN_PASSWORD || column == COLUMN_FAVORITE )
+				return false;
+
+			textColor = uiColorHelp;
+			force = false;
+			return true;
+		}
 
 		switch( column )
 		{
 		case COLUMN_PING:
 			changedTime = s.pingChangedTime;
-			flashColor = s.ping < s.prevPing ? green : red;
+			flashColor = FlashColor( s.ping < s.prevPing );
 			break;
 		case COLUMN_PLAYERS:
 			changedTime = s.playersChangedTime;
-			flashColor = s.numcl > s.prevNumcl ? green : red;
+			flashColor = FlashColor( s.numcl > s.prevNumcl );
 			break;
 		case COLUMN_MAP:
 			changedTime = s.mapChangedTime;
-			flashColor = green;
+			flashColor = FlashColor( true );
 			break;
 		default:
 			return false;
@@ -323,11 +795,9 @@ public:
 		if( changedTime <= 0.0f )
 			return false;
 
-		float age = EngFuncs::DoubleTime() - changedTime;
-		if( age >= fadeTime )
+		if( !FadeFlashColor( EngFuncs::DoubleTime() - changedTime, flashColor, uiPromptTextColor, textColor ))
 			return false;
 
-		textColor = InterpColor( flashColor, uiPromptTextColor, age / fadeTime );
 		force = true;
 		return true;
 	}
@@ -336,44 +806,77 @@ public:
 
 	void Flush()
 	{
-		filterMaps.RemoveAll();
-		servers.RemoveAll();
+		Clear();
+
 		serversRefreshTime = gpGlobals->time;
 	}
 
 	bool IsHavePassword( int line )
 	{
-		return servers[line].havePassword;
+		return Server( line ).havePassword;
 	}
 
-	void AddServerToList( netadr_t adr, const char *info, bool is_favorite );
+	server_t &Server( int line ) { return s_Servers[ServerId( line )]; }
+	const server_t &Server( int line ) const { return s_Servers[ServerId( line )]; }
+	int ServerId( int line ) const { return m_serverIds[Row( line )]; }
+	bool IsValidRow( int line ) const { return IsValidLine( line ); }
+
+	// adds, moves or removes the row after record has changed
+	void AddServerToList( int id );
+
+	// same for a batch, sorts once if there are many
+	void MergeServers( const CUtlVector<int> &ids );
 
-	bool Sort( int column, bool ascend ) override;
+	// rows are taken from this list, filtered
+	void SetSource( const CServerList *source ) { m_pSource = source; }
+	const CServerList *Source() const { return m_pSource; }
 
-	void SetFilterMap( const char *mapname )
+	// rebuilds rows from source after filter change, no need to query servers again
+	void Refilter( void );
+
+	bool Sort( int column, bool ascend ) override
 	{
-		filterMap = filterMap_t( mapname );
+		// pictures aren't sortable, rows stay in the order they were added
+		if( column == COLUMN_PASSWORD || column == COLUMN_FAVORITE )
+			column = -1;
+
+		return CMenuColumnarModel::Sort( column, ascend );
 	}
 
 	float serversRefreshTime;
-	float filterPing;
-	char filterEmpty;
-	char filterFull;
-	CUtlVector<server_t> servers;
+	serverfilter_t filter;
+
+protected:
+	void FormatCell( int row, int column, char *buf, size_t size ) const override;
+	int CompareRows( int column, int a, int b ) const override;
 
-	filterMap_t filterMap;
-	CUtlVector<filterMap_t> filterMaps;
 private:
+	int AddServer( int id );
+	void RemoveServer( int id );
+	void SyncServer( int row, int id );
+	void Clear( void );
+
 	CMenuServerBrowser *parent;
+	const CServerList *m_pSource;
+
+	CUtlVector<int> m_serverIds;   // row -> server id
+	CUtlVector<int> m_rowOfServer; // server id -> row or -1
+	CUtlVector<int> m_selected;    // Refilter results
 
-	int m_iSortingColumn;
-	bool m_bAscend;
+	HIMAGE m_hLock;
+	HIMAGE m_hFavorite;
 };
 
 class CMenuServerBrowser: public CMenuFramework
 {
 public:
-	CMenuServerBrowser() : CMenuFramework( "CMenuServerBrowser" ), gameListModel( this ), m_iLastRefreshTab( -1 ) { }
+	CMenuServerBrowser() : CMenuFramework( "CMenuServerBrowser" ), gameListModel( this ), m_iLastRefreshTab( -1 ),
+		m_pMapFilterSource( NULL ), m_iMapFilterGeneration( -1 )
+	{
+		for( int i = 0; i < INTERNET_TAB_COUNT; i++ )
+			m_InternetServers[i].SetList( LIST_INTERNET + i );
+		m_LanServers.SetList( LIST_LAN );
+	}
 	void Draw() override;
 	void Show() override;
 	void Hide() override;
@@ -384,7 +887,8 @@ public:
 		m_bLanOnly = lanOnly;
 	}
 	void GetGamesList( void );
-	void ClearList( void );
+	void ApplyFilters( void );
+	void UpdateMapFilter( void );
 	void RefreshList( void );
 	void JoinGame( void );
 	void ResetPing( void )
@@ -394,9 +898,11 @@ public:
 	void ViewGameInfo( void );
 	void OnTabSwitch( void );
 
-	void ParseServerListFromFile( const char *filename, CUtlVector<favlist_entry_t> &list );
-	void SaveServerListToFile( const char *filename, const CUtlVector<favlist_entry_t> &list );
-	void QueryServerList( const CUtlVector<favlist_entry_t> &list );
+	void ParseServerListFromFile( const char *filename, CServerAddressList &list );
+	void SaveServerListToFile( const char *filename, const CServerAddressList &list );
+	void LoadServerCache( void );
+	void SaveServerCache( void );
+	void QueryServerList( const CServerAddressList &list );
 	void FavoriteServer( void );
 	void MaybeEnableFavoriteButton( void );
 	void ToggleFavoriteButton( bool en );
@@ -406,7 +912,10 @@ public:
 	void ShowAddServerBox( void );
 	void AddServer( void );
 
+	// queues response, it's merged on next frame
 	void AddServerToList( netadr_t adr, const char *info );
+	void MergeResponses( void );
+	void RefreshIndices( int id );
 	bool IsAddressInTab( int tab, const netadr_t &adr ) const;
 
 	static void Connect( server_t &server );
@@ -441,17 +950,37 @@ public:
 
 	bool m_bLanOnly;
 
-	CUtlVector<favlist_entry_t> favoritesList;
-	CUtlVector<favlist_entry_t> historyList;
+	CServerAddressList favoritesList;
+	CServerAddressList historyList;
 	int m_iLastRefreshTab;
-	CUtlVector<server_t> m_InternetServers[INTERNET_TAB_COUNT];
-	CUtlVector<server_t> m_LanServers;
+	CServerList m_InternetServers[INTERNET_TAB_COUNT];
+	CServerList m_LanServers;
+	CServerQueryScheduler m_Scheduler;
 private:
+	// engine may deliver hundreds of responses in one frame
+	struct response_t
+	{
+		netadr_t adr;
+		float ping; // measured on arrival
+		int info;   // offset in m_responseInfos
+	};
+
+	int MergeResponse( const response_t &response );
+
+	CUtlVector<response_t> m_responses;
+	CUtlVector<char> m_responseInfos;
+
+	// map dropdown keeps pointers, so names are copied here
+	const CServerList *m_pMapFilterSource;
+	int m_iMapFilterGeneration;
+	char m_szFilterMapNames[FILTER_MAX_MAPS + 1][64];
+	char m_szFilterMapItems[FILTER_MAX_MAPS + 1][80];
+
 	void _Init() override;
 	void _VidInit() override;
 };
 
-static server_t staticServerSelect( netadr_t(), "", false );
+static server_t staticServerSelect( netadr_t(), false );
 static bool staticWaitingPassword = false;
 
 ADD_MENU3( menu_internetgames, CMenuServerBrowser, UI_InternetGames_Menu );
@@ -492,68 +1021,753 @@ void UI_LanGame_Menu( void )
 	UI_ServerBrowser_Menu();
 }
 
-server_t::server_t( netadr_t adr, const char *info, bool is_favorite, bool pending_info ) :
-	adr( adr ), favorite( is_favorite ), pending_info( pending_info ),
-	prevPing( 0.0f ), pingChangedTime( 0.0f ),
-	prevNumcl( 0 ), playersChangedTime( 0.0f ), mapChangedTime( 0.0f )
+server_t::server_t( netadr_t adr, bool is_favorite, bool pending_info ) :
+	adr( adr ), ping( MAX_PING ), numcl( 0 ), maxcl( 0 ),
+	name( 0 ), mapname( 0 ), info( 0 ), infoCapacity( 0 ),
+	favorite( is_favorite ), havePassword( false ), isGoldSrc( false ), pending_info( pending_info ),
+	stale( false ), lists( 0 ), lastSeen( 0 ), version( 0 ), prevNumcl( 0 ), prevPing( 0.0f ), pingChangedTime( 0.0f ),
+	playersChangedTime( 0.0f ), mapChangedTime( 0.0f )
 {
-	Q_strncpy( this->info, info, sizeof( this->info ));
 }
 
-void server_t::UpdateData( void )
+void server_t::SetPing( float ping )
 {
-	Q_strncpy( name, Info_ValueForKey( info, "host" ), sizeof( name ));
-	Q_strncpy( mapname, Info_ValueForKey( info, "map" ), sizeof( mapname ));
-	Q_strncpy( ipstr, EngFuncs::NET_AdrToString( adr ), sizeof( ipstr ));
-	numcl = atoi( Info_ValueForKey( info, "numcl" ));
-	maxcl = atoi( Info_ValueForKey( info, "maxcl" ));
-	snprintf( clientsstr, sizeof( clientsstr ), "%d\\%d", numcl, maxcl );
-	havePassword = !strcmp( Info_ValueForKey( info, "password" ), "1" );
-	isGoldSrc = !strcmp( Info_ValueForKey( info, "gs" ), "1" );
+	this->ping = bound( 0.0f, ping, MAX_PING );
 }
 
-void server_t::SetPing( float ping )
+const char *server_t::Name() const
 {
-	ping = bound( 0.0f, ping, MAX_PING );
+	return s_Servers.String( name );
+}
 
-	this->ping = ping;
-	snprintf( pingstr, sizeof( pingstr ), "%.f ms", ping * 1000 );
+const char *server_t::Map() const
+{
+	return s_Servers.String( mapname );
 }
 
-bool CMenuGameListModel::Sort(int column, bool ascend)
+int CServerStore::Add( netadr_t adr, bool pending_info )
 {
-	m_iSortingColumn = column;
-	if( column == -1 )
-		return false; // disabled
+	int id = m_servers.AddToTail( server_t( adr, false, pending_info ));
 
-	m_bAscend = ascend;
-	switch( column )
-	{
-	case COLUMN_PASSWORD:
-		return false;
-	case COLUMN_NAME:
-		qsort( servers.Base(), servers.Count(), sizeof( server_t ),
-			ascend ? server_t::NameCmpAscend : server_t::NameCmpDescend );
-		return true;
-	case COLUMN_MAP:
-		qsort( servers.Base(), servers.Count(), sizeof( server_t ),
-			ascend ? server_t::MapCmpAscend : server_t::MapCmpDescend );
-		return true;
-	case COLUMN_PLAYERS:
-		qsort( servers.Base(), servers.Count(), sizeof( server_t ),
-			ascend ? server_t::ClientCmpAscend : server_t::ClientCmpDescend );
-		return true;
-	case COLUMN_PING:
-		qsort( servers.Base(), servers.Count(), sizeof( server_t ),
-			ascend ? server_t::PingCmpAscend : server_t::PingCmpDescend );
-		return true;
-	case COLUMN_IP:
-		qsort( servers.Base(), servers.Count(), sizeof( server_t ),
-			ascend ? server_t::AdrCmpAscend : server_t::AdrCmpDescend );
-		return true;
+	m_servers[id].name = m_servers[id].mapname = Intern( infospan_t{ "", 0 } );
+	m_index.Insert( adr, id );
+
+	return id;
+}
+
+int CServerStore::AddPending( netadr_t adr, const char *info, bool is_favorite )
+{
+	int id = Find( adr );
+
+	if( id >= 0 )
+		return id;
+
+	id = Add( adr, true );
+	SetInfo( id, info, CInfoString( info ));
+	m_servers[id].favorite = is_favorite;
+
+	return id;
+}
+
+int CServerStore::Update( netadr_t adr, const char *info, const CInfoString &parsed, float ping )
+{
+	int id = Find( adr );
+
+	if( id < 0 )
+		id = Add( adr, true );
+
+	server_t &server = m_servers[id];
+	bool wasPending = server.pending_info;
+	float oldPing = server.ping;
+	short oldNumcl = server.numcl;
+	int oldMap = server.mapname;
+
+	SetInfo( id, info, parsed );
+	server.SetPing( ping );
+	server.pending_info = false;
+	server.stale = false;
+	server.lastSeen = (unsigned int)time( NULL );
+	server.version++;
+	m_history.Add( id, server.ping, server.numcl );
+
+	if( wasPending )
+		return id;
+
+	float now = EngFuncs::DoubleTime();
+
+	if( fabsf( server.ping - oldPing ) > 0.005f )
+	{
+		server.prevPing = oldPing;
+		server.pingChangedTime = now;
+	}
+
+	if( server.numcl != oldNumcl )
+	{
+		server.prevNumcl = oldNumcl;
+		server.playersChangedTime = now;
+	}
+
+	if( oldMap != server.mapname && String( oldMap )[0] && stricmp( String( oldMap ), server.Map() ))
+		server.mapChangedTime = now;
+
+	return id;
+}
+
+void CServerHistory::Add( int id, float ping, int numcl )
+{
+	while( m_count.Count() <= id )
+	{
+		m_ping.AddMultipleToTail( HISTORY_SAMPLES );
+		m_players.AddMultipleToTail( HISTORY_SAMPLES );
+		m_head.AddToTail( 0 );
+		m_count.AddToTail( 0 );
+		m_median.AddToTail( 0 );
+		m_jitter.AddToTail( 0 );
+	}
+
+	int slot = id * HISTORY_SAMPLES + m_head[id];
+
+	m_ping[slot] = Q_min( (int)( ping * 1000.0f ) / HISTORY_PING_STEP, 255 );
+	m_players[slot] = bound( 0, numcl, 255 );
+	m_head[id] = ( m_head[id] + 1 ) % HISTORY_SAMPLES;
+
+	if( m_count[id] < HISTORY_SAMPLES )
+		m_count[id]++;
+
+	int count = m_count[id];
+	byte sorted[HISTORY_SAMPLES];
+	int delta = 0;
+
+	// insertion sort is fine for 32 bytes
+	for( int i = 0; i < count; i++ )
+	{
+		byte value = m_ping[Slot( id, i )];
+		int j = i;
+
+		for( ; j > 0 && sorted[j - 1] > value; j-- )
+			sorted[j] = sorted[j - 1];
+
+		sorted[j] = value;
+
+		if( i > 0 )
+			delta += abs( value - m_ping[Slot( id, i - 1 )] );
+	}
+
+	m_median[id] = sorted[count / 2] * HISTORY_PING_STEP;
+	m_jitter[id] = count > 1 ? delta * HISTORY_PING_STEP / ( count - 1 ) : 0;
+}
+
+int CServerStore::AddCached( const servercache_record_t &record, const char *strings )
+{
+	int id = Find( record.adr );
+
+	if( id >= 0 )
+		return id;
+
+	// pending, so first answer doesn't flash every cell
+	id = Add( record.adr, true );
+
+	server_t &server = m_servers[id];
+	const char *name = strings + record.name;
+	const char *mapname = strings + record.mapname;
+
+	server.name = Intern( infospan_t{ name, (int)strlen( name ) } );
+	server.mapname = Intern( infospan_t{ mapname, (int)strlen( mapname ) } );
+	server.numcl = record.numcl;
+	server.maxcl = record.maxcl;
+	server.havePassword = FBitSet( record.flags, SERVERCACHE_PASSWORD ) != 0;
+	server.isGoldSrc = FBitSet( record.flags, SERVERCACHE_GOLDSRC ) != 0;
+	server.SetPing( record.ping );
+	server.stale = true;
+	server.lastSeen = record.lastSeen;
+
+	return id;
+}
+
+void CServerStore::SetInfo( int id, const char *info, const CInfoString &parsed )
+{
+	server_t &server = m_servers[id];
+	int len = strlen( info ) + 1;
+
+	if( len > server.infoCapacity )
+	{
+		if( m_iInfoWaste + server.infoCapacity > m_infos.Count() / 2 )
+			CompactInfos();
+
+		// old slot is abandoned
+		m_iInfoWaste += server.infoCapacity;
+		server.info = m_infos.AddMultipleToTail( len );
+		server.infoCapacity = len;
+	}
+
+	memcpy( m_infos.Base() + server.info, info, len );
+
+	server.name = Intern( parsed.Value( CInfoString::KEY_HOST ));
+	server.mapname = Intern( parsed.Value( CInfoString::KEY_MAP ));
+	server.numcl = parsed.Value( CInfoString::KEY_NUMCL ).ToInt();
+	server.maxcl = parsed.Value( CInfoString::KEY_MAXCL ).ToInt();
+	server.havePassword = parsed.Value( CInfoString::KEY_PASSWORD ).Equals( "1" );
+	server.isGoldSrc = parsed.Value( CInfoString::KEY_GS ).Equals( "1" );
+}
+
+void CServerStore::CompactInfos( void )
+{
+	CUtlVector<char> infos;
+
+	infos.EnsureCapacity( m_infos.Count() - m_iInfoWaste );
+
+	FOR_EACH_VEC( m_servers, i )
+	{
+		server_t &server = m_servers[i];
+
+		if( !server.infoCapacity )
+			continue;
+
+		int len = strlen( m_infos.Base() + server.info ) + 1;
+		int pos = infos.AddMultipleToTail( len, m_infos.Base() + server.info );
+
+		server.info = pos;
+		server.infoCapacity = len;
+	}
+
+	m_infos.Swap( infos );
+	m_iInfoWaste = 0;
+}
+
+unsigned int CServerStore::HashSpan( const infospan_t &s )
+{
+	unsigned int hash = 0x811C9DC5u;
+
+	for( int i = 0; i < s.len; i++ )
+		hash = ( hash ^ (byte)s.str[i] ) * 0x01000193u;
+
+	return hash;
+}
+
+int CServerStore::Intern( const infospan_t &s )
+{
+	// keep load factor under a half
+	if( m_iNumStrings * 2 >= m_stringTable.Count() )
+	{
+		CUtlVector<int> table;
+
+		table.SetCount( Q_max( 256, m_stringTable.Count() * 2 ));
+		FOR_EACH_VEC( table, i )
+			table[i] = -1;
+
+		FOR_EACH_VEC( m_stringTable, i )
+		{
+			int handle = m_stringTable[i];
+
+			if( handle < 0 )
+				continue;
+
+			const char *str = String( handle );
+			int mask = table.Count() - 1;
+			int slot = HashSpan( infospan_t{ str, (int)strlen( str ) } ) & mask;
+
+			while( table[slot] >= 0 )
+				slot = ( slot + 1 ) & mask;
+
+			table[slot] = handle;
+		}
+
+		m_stringTable.Swap( table );
+	}
+
+	int mask = m_stringTable.Count() - 1;
+	int slot = HashSpan( s ) & mask;
+
+	for( ; m_stringTable[slot] >= 0; slot = ( slot + 1 ) & mask )
+	{
+		if( s.Equals( String( m_stringTable[slot] )))
+			return m_stringTable[slot];
+	}
+
+	int handle = m_strings.AddMultipleToTail( s.len + 1 );
+
+	memcpy( m_strings.Base() + handle, s.str, s.len );
+	m_strings[handle + s.len] = 0;
+
+	m_stringTable[slot] = handle;
+	m_iNumStrings++;
+
+	return handle;
+}
+
+// same steps as ping filter dropdown, so filtering by it is a union of buckets
+const float CServerFilterIndex::s_flPingBuckets[PING_BUCKETS] =
+{
+	0.02f, 0.05f, 0.1f, 0.2f, 0.5f, MAX_PING
+};
+
+int CServerFilterIndex::PingBucket( float ping )
+{
+	for( int i = 0; i < PING_BUCKETS - 1; i++ )
+	{
+		if( ping <= s_flPingBuckets[i] )
+			return i;
+	}
+
+	return PING_BUCKETS - 1;
+}
+
+void CServerFilterIndex::SetBit( CUtlVector<unsigned int> &bits, int id, bool value )
+{
+	if( value )
+		SetBits( bits[id >> 5], BIT( id & 31 ));
+	else ClearBits( bits[id >> 5], BIT( id & 31 ));
+}
+
+void CServerFilterIndex::Insert( int id )
+{
+	if( id >= m_entries.Count() )
+	{
+		int first = m_entries.AddMultipleToTail( id + 1 - m_entries.Count() );
+
+		for( int i = first; i < m_entries.Count(); i++ )
+		{
+			m_entries[i].member = false;
+			m_entries[i].map = -1;
+		}
+
+		int words = ( id >> 5 ) + 1;
+
+		while( m_member.Count() < words )
+		{
+			m_member.AddToTail( 0 );
+			m_empty.AddToTail( 0 );
+			m_full.AddToTail( 0 );
+
+			for( int b = 0; b < PING_BUCKETS; b++ )
+				m_ping[b].AddToTail( 0 );
+		}
+	}
+
+	const server_t &server = s_Servers[id];
+	entry_t &entry = m_entries[id];
+
+	if( entry.member )
+		SetBit( m_ping[entry.bucket], id, false );
+	else SetBit( m_member, id, true );
+
+	entry.member = true;
+	entry.bucket = PingBucket( server.ping );
+	SetBit( m_ping[entry.bucket], id, true );
+	SetBit( m_empty, id, server.IsEmpty( ));
+	SetBit( m_full, id, server.IsFull( ));
+
+	if( entry.map >= 0 && m_maps[entry.map].name == server.mapname && entry.players == server.numcl )
+		return;
+
+	Unlink( id );
+	Link( id, server.mapname, server.numcl );
+	m_iMapsGeneration++;
+}
+
+void CServerFilterIndex::RemoveAll()
+{
+	m_entries.RemoveAll();
+	m_member.RemoveAll();
+	m_empty.RemoveAll();
+	m_full.RemoveAll();
+
+	for( int b = 0; b < PING_BUCKETS; b++ )
+		m_ping[b].RemoveAll();
+
+	m_maps.RemoveAll();
+	m_mapIndex.RemoveAll();
+	m_iMapsGeneration++;
+}
+
+void CServerFilterIndex::Link( int id, int name, int players )
+{
+	int i = m_mapIndex.Find( name );
+	int slot;
+
+	if( m_mapIndex.IsValidIndex( i ))
+	{
+		slot = m_mapIndex[i];
+	}
+	else
+	{
+		slot = m_maps.AddToTail();
+		m_maps[slot].name = name;
+		m_maps[slot].head = -1;
+		m_maps[slot].servers = 0;
+		m_maps[slot].players = 0;
+		m_mapIndex.Insert( name, slot );
+	}
+
+	entry_t &entry = m_entries[id];
+	mapstat_t &map = m_maps[slot];
+
+	entry.map = slot;
+	entry.players = players;
+	entry.prevInMap = -1;
+	entry.nextInMap = map.head;
+
+	if( map.head >= 0 )
+		m_entries[map.head].prevInMap = id;
+
+	map.head = id;
+	map.servers++;
+	map.players += players;
+}
+
+void CServerFilterIndex::Unlink( int id )
+{
+	entry_t &entry = m_entries[id];
+
+	if( entry.map < 0 )
+		return;
+
+	mapstat_t &map = m_maps[entry.map];
+
+	if( entry.prevInMap >= 0 )
+		m_entries[entry.prevInMap].nextInMap = entry.nextInMap;
+	else map.head = entry.nextInMap;
+
+	if( entry.nextInMap >= 0 )
+		m_entries[entry.nextInMap].prevInMap = entry.prevInMap;
+
+	map.servers--;
+	map.players -= entry.players;
+	entry.map = -1;
+}
+
+bool CServerFilterIndex::Test( int id, const serverfilter_t &filter, int lastBucket ) const
+{
+	const entry_t &entry = m_entries[id];
+
+	if( entry.bucket > lastBucket )
+		return false;
+
+	// only the last bucket may have servers above the limit
+	if( entry.bucket == lastBucket && s_Servers[id].ping > filter.ping )
+		return false;
+
+	if( filter.empty && GetBit( m_empty, id ) != ( filter.empty == '1' ))
+		return false;
+
+	if( filter.full && GetBit( m_full, id ) != ( filter.full == '1' ))
+		return false;
+
+	return true;
+}
+
+void CServerFilterIndex::Select( const serverfilter_t &filter, CUtlVector<int> &out ) const
+{
+	int lastBucket = PingBucket( filter.ping );
+
+	out.RemoveAll();
+
+	// walk only servers on that map
+	if( filter.map[0] )
+	{
+		FOR_EACH_VEC( m_maps, i )
+		{
+			if( colorstricmp( filter.map, MapName( i )) != 0 )
+				continue;
+
+			for( int id = m_maps[i].head; id >= 0; id = m_entries[id].nextInMap )
+			{
+				if( Test( id, filter, lastBucket ))
+					out.AddToTail( id );
+			}
+		}
+
+		return;
+	}
+
+	FOR_EACH_VEC( m_member, w )
+	{
+		unsigned int mask = 0;
+
+		for( int b = 0; b <= lastBucket; b++ )
+			mask |= m_ping[b][w];
+
+		mask &= m_member[w];
+		mask &= FlagMask( m_empty[w], filter.empty );
+		mask &= FlagMask( m_full[w], filter.full );
+
+		for( int bit = 0; mask; bit++, mask >>= 1 )
+		{
+			if( !( mask & 1 ))
+				continue;
+
+			int id = ( w << 5 ) + bit;
+
+			if( m_entries[id].bucket == lastBucket && s_Servers[id].ping > filter.ping )
+				continue;
+
+			out.AddToTail( id );
+		}
+	}
+}
+
+bool CServerFilterIndex::LessPopular( int a, int b ) const
+{
+	if( m_maps[a].players != m_maps[b].players )
+		return m_maps[a].players < m_maps[b].players;
+
+	// first seen map wins
+	return a > b;
+}
+
+void CServerFilterIndex::SiftDown( CUtlVector<int> &heap, int i, int count ) const
+{
+	while( true )
+	{
+		int least = i;
+		int l = i * 2 + 1;
+		int r = l + 1;
+
+		if( l < count && LessPopular( heap[l], heap[least] ))
+			least = l;
+		if( r < count && LessPopular( heap[r], heap[least] ))
+			least = r;
+
+		if( least == i )
+			return;
+
+		SwapItems( heap, i, least );
+		i = least;
+	}
+}
+
+void CServerFilterIndex::TopMaps( int count, CUtlVector<int> &out ) const
+{
+	out.RemoveAll();
+
+	// min-heap of best maps so far, root is the first to be dropped
+	FOR_EACH_VEC( m_maps, i )
+	{
+		if( !m_maps[i].servers || !MapName( i )[0] )
+			continue;
+
+		if( out.Count() < count )
+		{
+			int child = out.AddToTail( i );
+
+			while( child > 0 )
+			{
+				int parent = ( child - 1 ) / 2;
+
+				if( !LessPopular( out[child], out[parent] ))
+					break;
+
+				SwapItems( out, child, parent );
+				child = parent;
+			}
+		}
+		else if( count > 0 && LessPopular( out[0], i ))
+		{
+			out[0] = i;
+			SiftDown( out, 0, out.Count() );
+		}
+	}
+
+	// moving root to the end leaves most popular in front
+	for( int n = out.Count() - 1; n > 0; n-- )
+	{
+		SwapItems( out, 0, n );
+		SiftDown( out, 0, n );
+	}
+}
+
+#define QUERY_TIMEOUT 2.5 // seconds before query is sent again
+
+void CServerQueryScheduler::Queue( const favlist_entry_t &entry, const netadr_t &adr, bool favorite )
+{
+	int i = m_index.Find( adr );
+
+	if( !m_index.IsValidIndex( i ))
+	{
+		int query = m_queries.AddToTail( query_t( entry, adr, favorite ));
+
+		m_index.Insert( adr, query );
+		Push( query );
+		return;
+	}
+
+	query_t &query = m_queries[m_index[i]];
+
+	if( query.state == QUERY_WAITING )
+		return;
+
+	query.entry = entry;
+	query.favorite = favorite;
+	query.retries = 0;
+	query.state = QUERY_WAITING;
+	Push( m_index[i] );
+}
+
+void CServerQueryScheduler::Push( int i )
+{
+	m_queues[m_queries[i].favorite ? QUEUE_FAVORITES : QUEUE_OTHER].AddToTail( i );
+}
+
+void CServerQueryScheduler::RemoveAll()
+{
+	m_queries.RemoveAll();
+	m_index.RemoveAll();
+	m_inFlight.RemoveAll();
+
+	for( int i = 0; i < QUEUE_COUNT; i++ )
+	{
+		m_queues[i].RemoveAll();
+		m_iQueueHead[i] = 0;
+	}
+}
+
+double CServerQueryScheduler::Answered( const netadr_t &adr )
+{
+	int i = m_index.Find( adr );
+
+	if( !m_index.IsValidIndex( i ))
+		return -1.0;
+
+	query_t &query = m_queries[m_index[i]];
+
+	if( query.state != QUERY_SENT && query.state != QUERY_TIMEDOUT )
+		return -1.0;
+
+	query.state = QUERY_ANSWERED;
+	return query.sendTime;
+}
+
+bool CServerQueryScheduler::Send( int i, double now )
+{
+	query_t &query = m_queries[i];
+
+	if( query.state != QUERY_WAITING )
+		return false;
+
+	query.entry.QueryServer();
+	query.sendTime = now;
+	query.state = QUERY_SENT;
+	m_inFlight.AddToTail( i );
+
+	return true;
+}
+
+void CServerQueryScheduler::Frame( const CUtlVector<int> &visible )
+{
+	double now = EngFuncs::DoubleTime();
+	int budget = Q_max( 1, (int)ui_maxqueries->value );
+
+	// resend lost queries, give up after few tries
+	for( int j = m_inFlight.Count() - 1; j >= 0; j-- )
+	{
+		query_t &query = m_queries[m_inFlight[j]];
+
+		if( query.state == QUERY_SENT && now - query.sendTime < QUERY_TIMEOUT )
+			continue;
+
+		if( query.state == QUERY_SENT )
+		{
+			if( query.retries < QUERY_RETRIES )
+			{
+				query.retries++;
+				query.state = QUERY_WAITING;
+				Push( m_inFlight[j] );
+			}
+			else query.state = QUERY_TIMEDOUT; // late answer is still accepted
+		}
+
+		m_inFlight.FastRemove( j );
+	}
+
+	// rows user is looking at
+	FOR_EACH_VEC( visible, j )
+	{
+		if( budget <= 0 )
+			return;
+
+		int i = m_index.Find( s_Servers[visible[j]].adr );
+
+		if( m_index.IsValidIndex( i ) && Send( m_index[i], now ))
+			budget--;
+	}
+
+	for( int queue = 0; queue < QUEUE_COUNT; queue++ )
+	{
+		CUtlVector<int> &q = m_queues[queue];
+		int &head = m_iQueueHead[queue];
+
+		while( budget > 0 && head < q.Count() )
+		{
+			if( Send( q[head++], now ))
+				budget--;
+		}
+
+		if( head == q.Count() )
+		{
+			q.RemoveAll();
+			head = 0;
+		}
+	}
+}
+
+void CMenuGameListModel::FormatCell( int row, int column, char *buf, size_t size ) const
+{
+	switch( column )
+	{
+	case COLUMN_PLAYERS:
+		snprintf( buf, size, "%d\\%d", GetInt( row, column ) >> 16, GetInt( row, column ) & 0xFFFF );
+		break;
+	case COLUMN_PING:
+		snprintf( buf, size, "%.f ms", GetFloat( row, column ) * 1000 );
+		break;
+	default:
+		CMenuColumnarModel::FormatCell( row, column, buf, size );
+		break;
 	}
+}
+
+int CMenuGameListModel::CompareRows( int column, int a, int b ) const
+{
+	// text would put 10.0.0.1 before 9.0.0.1
+	if( column == COLUMN_IP )
+		return s_Servers[m_serverIds[a]].AdrCmp( s_Servers[m_serverIds[b]] );
+
+	// players sort by count, then by slots, history by jitter, then by median ping
+	return CMenuColumnarModel::CompareRows( column, a, b );
+}
+
+// ping sparkline, bars are plain fills, so they're batched
+void CMenuGameListModel::DrawCell( int line, int column, Point pos, Size size, unsigned int color )
+{
+	const CServerHistory &history = s_Servers.History();
+	int id = ServerId( line );
+	int count = history.Count( id );
+
+	if( column != COLUMN_HISTORY || !count || size.w <= 0 )
+		return;
+
+	int barWidth = Q_max( 1, size.w / HISTORY_SAMPLES );
+	int scale = 100; // ms, low pings shouldn't fill the cell
+
+	for( int i = 0; i < count; i++ )
+		scale = Q_max( scale, history.PingMs( id, i ));
+
+	// newest sample is at the right edge
+	int x = pos.x + size.w - count * barWidth;
+
+	// bars touch, so a run of equal heights is one fill
+	for( int i = 0; i < count; )
+	{
+		int h = Q_max( 1, size.h * history.PingMs( id, i ) / scale );
+		int run = 1;
 
-	return false;
+		while( i + run < count && Q_max( 1, size.h * history.PingMs( id, i + run ) / scale ) == h )
+			run++;
+
+		UI_FillRect( x, pos.y + size.h - h, run * barWidth, h, color );
+		x += run * barWidth;
+		i += run;
+	}
 }
 
 /*
@@ -563,135 +1777,155 @@ CMenuServerBrowser::GetGamesList
 */
 void CMenuGameListModel::Update( void )
 {
-	int		i;
+	PROFILE_SCOPE( "CMenuGameListModel::Update" );
+
+	if( GetRows() )
+	{
+		parent->joinGame->SetGrayed( false );
+		parent->MaybeEnableFavoriteButton();
+		parent->OnChangeSelectedServer();
+	}
+
+	Resort();
+}
+
+void CMenuGameListModel::OnActivateEntry( int line )
+{
+	CMenuServerBrowser::Connect( Server( line ));
+}
+
+int CMenuGameListModel::AddServer( int id )
+{
+	int row = AddRow();
+
+	m_serverIds.AddToTail( id );
+
+	while( m_rowOfServer.Count() <= id )
+		m_rowOfServer.AddToTail( -1 );
+
+	m_rowOfServer[id] = row;
+	SetBits( s_Servers[id].lists, BIT( LIST_VIEW ));
+	SyncServer( row, id );
+
+	return row;
+}
+
+void CMenuGameListModel::RemoveServer( int id )
+{
+	int row = m_rowOfServer[id];
 
-	// regenerate table data
-	for( i = 0; i < servers.Count(); i++ )
-		servers[i].UpdateData();
+	RemoveRow( row );
+	m_serverIds.FastRemove( row );
 
-	if( servers.Count() )
-	{
-		parent->joinGame->SetGrayed( false );
-		parent->MaybeEnableFavoriteButton();
-		parent->OnChangeSelectedServer();
-		if( m_iSortingColumn != -1 )
-			Sort( m_iSortingColumn, m_bAscend );
-	}
+	// last row took its place
+	if( m_serverIds.IsValidIndex( row ))
+		m_rowOfServer[m_serverIds[row]] = row;
+
+	m_rowOfServer[id] = -1;
+	ClearBits( s_Servers[id].lists, BIT( LIST_VIEW ));
 }
 
-void CMenuGameListModel::OnActivateEntry( int line )
+void CMenuGameListModel::SyncServer( int row, int id )
 {
-	CMenuServerBrowser::Connect( servers[line] );
+	const server_t &s = s_Servers[id];
+	const CServerHistory &history = s_Servers.History();
+
+	if( !m_hLock )
+		m_hLock = EngFuncs::PIC_Load( ART_BANNER_LOCK );
+	if( !m_hFavorite )
+		m_hFavorite = EngFuncs::PIC_Load( ART_BANNER_FAVORITE );
+
+	SetImage( row, COLUMN_PASSWORD, s.havePassword ? m_hLock : 0 );
+	SetImage( row, COLUMN_FAVORITE, s.favorite ? m_hFavorite : 0 );
+	SetString( row, COLUMN_NAME, s.Name() );
+	SetString( row, COLUMN_MAP, s.Map() );
+	SetInt( row, COLUMN_PLAYERS, Q_max( 0, s.numcl ) << 16 | ( s.maxcl & 0xFFFF ));
+	SetFloat( row, COLUMN_PING, s.ping );
+	SetInt( row, COLUMN_HISTORY, Q_min( history.Jitter( id ), 0x7FFF ) << 16 | Q_min( history.MedianPing( id ), 0xFFFF ));
+	SetString( row, COLUMN_IP, EngFuncs::NET_AdrToString( s.adr ));
 }
 
-void CMenuGameListModel::AddServerToList( netadr_t adr, const char *info, bool is_favorite )
+void CMenuGameListModel::Clear( void )
 {
-	int i;
-	int pos = -1;
-
-	for( i = 0; i < servers.Count(); i++ )
+	FOR_EACH_VEC( m_serverIds, i )
 	{
-		if( !EngFuncs::NET_CompareAdr( &servers[i].adr, &adr ))
-		{
-			pos = i;
-			break;
-		}
+		ClearBits( s_Servers[m_serverIds[i]].lists, BIT( LIST_VIEW ));
+		m_rowOfServer[m_serverIds[i]] = -1;
 	}
 
-	// update existing entry's ping/info in place; skip filter re-check
-	if( pos >= 0 )
-	{
-		float oldPing = servers[pos].ping;
-		int oldNumcl = servers[pos].numcl;
-		char oldMap[sizeof( servers[pos].mapname )];
-		Q_strncpy( oldMap, servers[pos].mapname, sizeof( oldMap ));
-		bool wasPending = servers[pos].pending_info;
+	m_serverIds.RemoveAll();
+	RemoveAll();
+}
 
-		Q_strncpy( servers[pos].info, info, sizeof( servers[pos].info ));
-		servers[pos].UpdateData();
-		servers[pos].SetPing( EngFuncs::DoubleTime() - serversRefreshTime );
-		servers[pos].pending_info = false;
+void CMenuGameListModel::AddServerToList( int id )
+{
+	server_t &server = s_Servers[id];
+	bool visible = filter.Matches( server );
 
-		if( !wasPending )
+	if( server.IsInList( LIST_VIEW ))
+	{
+		if( visible )
 		{
-			float now = EngFuncs::DoubleTime();
+			int row = m_rowOfServer[id];
 
-			if( fabsf( servers[pos].ping - oldPing ) > 0.005f )
-			{
-				servers[pos].prevPing = oldPing;
-				servers[pos].pingChangedTime = now;
-			}
-			if( servers[pos].numcl != oldNumcl )
-			{
-				servers[pos].prevNumcl = oldNumcl;
-				servers[pos].playersChangedTime = now;
-			}
-			if( oldMap[0] && stricmp( servers[pos].mapname, oldMap ) != 0 )
-				servers[pos].mapChangedTime = now;
+			SyncServer( row, id );
+			Reposition( row );
+			return;
 		}
 
-		if( m_iSortingColumn != -1 )
-			Sort( m_iSortingColumn, m_bAscend );
-		return;
+		RemoveServer( id );
 	}
+	else if( visible )
+	{
+		Reposition( AddServer( id ));
+	}
+}
 
-	server_t server( adr, info, is_favorite );
-
-	server.UpdateData();
-	server.SetPing( EngFuncs::DoubleTime() - serversRefreshTime );
-
-	if( server.ping > filterPing )
-		return;
-
-	if( filterEmpty == '1' && !server.IsEmpty( ))
-		return;
-	if( filterEmpty == '0' && server.IsEmpty( ))
-		return;
-
-	if( filterFull == '1' && !server.IsFull( ))
-		return;
-	if( filterFull == '0' && server.IsFull( ))
-		return;
-
-	if( filterMap.name[0] && colorstricmp( filterMap.name, server.mapname ) != 0 )
+void CMenuGameListModel::MergeServers( const CUtlVector<int> &ids )
+{
+	// binary insertion is cheaper until batch gets big
+	if( ids.Count() < 32 )
+	{
+		FOR_EACH_VEC( ids, i )
+			AddServerToList( ids[i] );
 		return;
+	}
 
-	if( server.mapname[0] != 0 )
+	FOR_EACH_VEC( ids, i )
 	{
-		bool foundMap = false;
+		int id = ids[i];
+		server_t &server = s_Servers[id];
+		bool visible = filter.Matches( server );
 
-		for( int i = 0; i < filterMaps.Count(); ++i )
+		if( server.IsInList( LIST_VIEW ))
 		{
-			foundMap = filterMaps[i] == server.mapname;
-
-			if( foundMap )
-			{
-				filterMaps[i].AddCount( server.numcl );
-				break;
-			}
+			if( visible )
+				SyncServer( m_rowOfServer[id], id );
+			else RemoveServer( id );
 		}
-
-		if( !foundMap )
+		else if( visible )
 		{
-			filterMaps.AddToTail( filterMap_t( server.mapname, server.numcl ) );
+			AddServer( id );
+		}
+	}
 
-			// sort by players count
-			filterMaps.Sort( filterMap_t::CmpCountInvert );
+	Resort();
+}
 
-			parent->filterMap.Clear();
-			for( int i = Q_min( FILTER_MAX_MAPS, filterMaps.Count() ); i--; )
-				parent->filterMap.AddItem( filterMaps[i].GetDisplay(), filterMaps[i].name );
-			parent->filterMap.AddItem( L( "any map" ), "" );
+void CMenuGameListModel::Refilter( void )
+{
+	PROFILE_SCOPE( "CMenuGameListModel::Refilter" );
 
-			if( !filterMap.name[0] )
-				parent->filterMap.SelectLast( false );
-		}
-	}
+	Clear();
+
+	if( m_pSource )
+		m_pSource->Index().Select( filter, m_selected );
+	else m_selected.RemoveAll();
 
-	servers.AddToTail( server );
+	FOR_EACH_VEC( m_selected, i )
+		AddServer( m_selected[i] );
 
-	if( m_iSortingColumn != -1 )
-		Sort( m_iSortingColumn, m_bAscend );
+	Resort();
 }
 
 void CMenuServerBrowser::Connect( server_t &server )
@@ -728,21 +1962,10 @@ void CMenuServerBrowser::Connect( server_t &server )
 
 	if( menu_internetgames->m_bLanOnly == false )
 	{
-		bool serverExists = false;
-
-		for( int i = 0; i < menu_internetgames->historyList.Count(); ++i )
-		{
-			if( strcmp( menu_internetgames->historyList[i].sadr, sadr ) == 0 && strcmp( menu_internetgames->historyList[i].prot, prot ) == 0 )
-			{
-				serverExists = true;
-				break;
-			}
-		}
-
-		if( !serverExists )
+		if( menu_internetgames->historyList.Find( sadr, prot ) < 0 )
 		{
 			if( menu_internetgames->historyList.Count() > 20 ) // FIXME: make configurable
-				menu_internetgames->historyList.FastRemove( 0 );
+				menu_internetgames->historyList.Remove( 0 );
 			menu_internetgames->historyList.AddToTail( favlist_entry_t( sadr, prot, true ) );
 
 
@@ -762,6 +1985,9 @@ CMenuServerBrowser::JoinGame
 */
 void CMenuServerBrowser::JoinGame()
 {
+	if( !gameListModel.IsValidRow( gameList.GetCurrentIndex( )))
+		return;
+
 	gameListModel.OnActivateEntry( gameList.GetCurrentIndex() );
 }
 
@@ -769,13 +1995,15 @@ void CMenuServerBrowser::FavoriteServer()
 {
 	int i = gameList.GetCurrentIndex();
 
-	if( !gameListModel.servers.IsValidIndex( i ))
+	if( !gameListModel.IsValidRow( i ))
 		return;
 
-	server_t &serv = gameListModel.servers[i];
+	server_t &serv = gameListModel.Server( i );
 	const char *sadr = EngFuncs::NET_AdrToString( serv.adr );
 
 	serv.favorite = !serv.favorite;
+	serv.version++;
+	gameListModel.AddServerToList( gameListModel.ServerId( i ));
 
 	ToggleFavoriteButton( !serv.favorite );
 
@@ -786,14 +2014,10 @@ void CMenuServerBrowser::FavoriteServer()
 	}
 	else
 	{
-		FOR_EACH_VEC( favoritesList, i )
-		{
-			if( !strcmp( favoritesList[i].sadr, sadr ))
-			{
-				favoritesList.FastRemove( i );
-				break;
-			}
-		}
+		int fav = favoritesList.Find( sadr );
+
+		if( fav >= 0 )
+			favoritesList.Remove( fav );
 	}
 }
 
@@ -818,35 +2042,89 @@ void CMenuServerBrowser::ToggleFavoriteButton( bool en )
 	}
 }
 
-void CMenuServerBrowser::ClearList()
+void CMenuServerBrowser::ApplyFilters()
+{
+	gameListModel.Refilter();
+
+	bool empty = gameListModel.GetRows() == 0;
+
+	joinGame->SetGrayed( empty );
+	viewGameInfo->SetGrayed( empty );
+
+	if( empty )
+	{
+		favorite->SetGrayed( true );
+		return;
+	}
+
+	MaybeEnableFavoriteButton();
+	OnChangeSelectedServer();
+}
+
+void CMenuServerBrowser::UpdateMapFilter()
 {
+	const CServerList *source = gameListModel.Source();
+
+	if( !source )
+		return;
+
+	const CServerFilterIndex &index = source->Index();
+
+	if( source == m_pMapFilterSource && index.MapsGeneration() == m_iMapFilterGeneration )
+		return;
+
+	m_pMapFilterSource = source;
+	m_iMapFilterGeneration = index.MapsGeneration();
+
+	CUtlVector<int> top;
+	index.TopMaps( FILTER_MAX_MAPS, top );
+
+	const char *current = gameListModel.filter.map;
+	int selected = -1;
+
 	filterMap.Clear();
-	if( gameListModel.filterMap.name[0] )
-		filterMap.AddItem( gameListModel.filterMap.GetDisplay(), gameListModel.filterMap.name );
+
+	// list opens up, so most popular map is at the bottom
+	for( int i = top.Count(); i--; )
+	{
+		Q_strncpy( m_szFilterMapNames[i], index.MapName( top[i] ), sizeof( m_szFilterMapNames[i] ));
+		snprintf( m_szFilterMapItems[i], sizeof( m_szFilterMapItems[i] ), "(%d) %s", index.MapPlayers( top[i] ), m_szFilterMapNames[i] );
+
+		filterMap.AddItem( m_szFilterMapItems[i], m_szFilterMapNames[i] );
+
+		if( current[0] && !colorstricmp( current, m_szFilterMapNames[i] ))
+			selected = filterMap.GetCount() - 1;
+	}
+
+	// keep selected map even if nobody plays it anymore
+	if( current[0] && selected < 0 )
+	{
+		Q_strncpy( m_szFilterMapNames[FILTER_MAX_MAPS], current, sizeof( m_szFilterMapNames[FILTER_MAX_MAPS] ));
+		snprintf( m_szFilterMapItems[FILTER_MAX_MAPS], sizeof( m_szFilterMapItems[FILTER_MAX_MAPS] ), "(0) %s", current );
+
+		filterMap.AddItem( m_szFilterMapItems[FILTER_MAX_MAPS], m_szFilterMapNames[FILTER_MAX_MAPS] );
+		selected = filterMap.GetCount() - 1;
+	}
+
 	filterMap.AddItem( L( "any map" ), "" );
 
-	gameListModel.Flush();
-	joinGame->SetGrayed( true );
-	viewGameInfo->SetGrayed( true );
-	favorite->SetGrayed( true );
+	if( selected >= 0 )
+		filterMap.SelectItem( selected, false );
+	else filterMap.SelectLast( false );
 }
 
-void CMenuServerBrowser::ParseServerListFromFile( const char *filename, CUtlVector<favlist_entry_t> &list )
+void CMenuServerBrowser::ParseServerListFromFile( const char *filename, CServerAddressList &list )
 {
 	byte *pfile = EngFuncs::COM_LoadFile( filename );
-	char *afile = (char *)pfile;
+	CTokenizer tokens( (const char *)pfile );
+	tokenspan_t sadr, prot;
 
-	while( true )
+	while( tokens.Next( sadr ) && tokens.Next( prot ))
 	{
 		favlist_entry_t entry( "", "", true );
 
-		afile = EngFuncs::COM_ParseFile( afile, entry.sadr, sizeof( entry.sadr ));
-		if( !afile )
-			break;
-
-		afile = EngFuncs::COM_ParseFile( afile, entry.prot, sizeof( entry.prot ));
-		if( !afile )
-			break;
+		sadr.Copy( entry.sadr, sizeof( entry.sadr ));
+		prot.Copy( entry.prot, sizeof( entry.prot ));
 
 		// ignore legacy protocol
 		if( !strcmp( entry.prot, "48" ))
@@ -858,7 +2136,7 @@ void CMenuServerBrowser::ParseServerListFromFile( const char *filename, CUtlVect
 	EngFuncs::COM_FreeFile( pfile );
 }
 
-void CMenuServerBrowser::SaveServerListToFile( const char *filename, const CUtlVector<favlist_entry_t> &list )
+void CMenuServerBrowser::SaveServerListToFile( const char *filename, const CServerAddressList &list )
 {
 	CUtlString s;
 
@@ -879,7 +2157,131 @@ void CMenuServerBrowser::SaveServerListToFile( const char *filename, const CUtlV
 	EngFuncs::COM_SaveFile( filename, s.Get( ), s.Length( ));
 }
 
-void CMenuServerBrowser::QueryServerList( const CUtlVector<favlist_entry_t> &list )
+void CMenuServerBrowser::LoadServerCache( void )
+{
+	int length = 0;
+	byte *pfile = EngFuncs::COM_LoadFile( SERVER_CACHE_FILE, &length );
+
+	if( !pfile )
+		return;
+
+	const servercache_header_t *header = (const servercache_header_t *)pfile;
+	size_t total = 0;
+
+	if( length < (int)sizeof( *header ) || memcmp( header->ident, "MUSC", 4 ) ||
+		header->version != SERVER_CACHE_VERSION || header->adrSize != sizeof( netadr_t ) ||
+		header->recordSize != sizeof( servercache_record_t ) || header->stringsSize <= 0 )
+	{
+		Con_Printf( "%s: outdated or broken, ignored\n", SERVER_CACHE_FILE );
+		EngFuncs::COM_FreeFile( pfile );
+		return;
+	}
+
+	// no count can be more than fits in the file, so the sum can't wrap
+	for( int i = 0; i < INTERNET_TAB_COUNT; i++ )
+	{
+		if( header->counts[i] < 0 || (size_t)header->counts[i] > (size_t)length / sizeof( servercache_record_t ))
+		{
+			Con_Printf( "%s: outdated or broken, ignored\n", SERVER_CACHE_FILE );
+			EngFuncs::COM_FreeFile( pfile );
+			return;
+		}
+
+		total += header->counts[i];
+	}
+
+	const servercache_record_t *records = (const servercache_record_t *)( header + 1 );
+	const char *strings = (const char *)( records + total );
+
+	if( (size_t)length != sizeof( *header ) + total * sizeof( *records ) + (size_t)header->stringsSize ||
+		strings[header->stringsSize - 1] != 0 )
+	{
+		Con_Printf( "%s: truncated, ignored\n", SERVER_CACHE_FILE );
+		EngFuncs::COM_FreeFile( pfile );
+		return;
+	}
+
+	unsigned int now = (unsigned int)time( NULL );
+
+	for( int tab = 0; tab < INTERNET_TAB_COUNT; tab++ )
+	{
+		for( int i = 0; i < header->counts[tab]; i++, records++ )
+		{
+			if( now - records->lastSeen > SERVER_CACHE_MAX_AGE )
+				continue;
+
+			if( (unsigned int)records->name >= (unsigned int)header->stringsSize ||
+				(unsigned int)records->mapname >= (unsigned int)header->stringsSize )
+				continue;
+
+			m_InternetServers[tab].Add( s_Servers.AddCached( *records, strings ));
+		}
+	}
+
+	EngFuncs::COM_FreeFile( pfile );
+}
+
+void CMenuServerBrowser::SaveServerCache( void )
+{
+	servercache_header_t header;
+	CUtlVector<servercache_record_t> records;
+	CUtlVector<char> strings;
+	unsigned int now = (unsigned int)time( NULL );
+
+	memset( &header, 0, sizeof( header ));
+	memcpy( header.ident, "MUSC", 4 );
+	header.version = SERVER_CACHE_VERSION;
+	header.adrSize = sizeof( netadr_t );
+	header.recordSize = sizeof( servercache_record_t );
+
+	// empty string for records without name
+	strings.AddToTail( 0 );
+
+	for( int tab = 0; tab < INTERNET_TAB_COUNT; tab++ )
+	{
+		const CServerList &list = m_InternetServers[tab];
+
+		for( int i = 0; i < list.Count(); i++ )
+		{
+			const server_t &server = s_Servers[list[i]];
+
+			// dummy entries of favorites that never answered
+			if( server.pending_info && !server.stale )
+				continue;
+
+			if( now - server.lastSeen > SERVER_CACHE_MAX_AGE )
+				continue;
+
+			servercache_record_t &record = records[records.AddToTail()];
+			const char *name = server.Name();
+			const char *mapname = server.Map();
+
+			memset( &record, 0, sizeof( record ));
+			record.adr = server.adr;
+			record.ping = server.ping;
+			record.numcl = server.numcl;
+			record.maxcl = server.maxcl;
+			record.name = name[0] ? strings.AddMultipleToTail( strlen( name ) + 1, name ) : 0;
+			record.mapname = mapname[0] ? strings.AddMultipleToTail( strlen( mapname ) + 1, mapname ) : 0;
+			record.lastSeen = server.lastSeen;
+			record.flags = ( server.isGoldSrc ? SERVERCACHE_GOLDSRC : 0 ) | ( server.havePassword ? SERVERCACHE_PASSWORD : 0 );
+
+			header.counts[tab]++;
+		}
+	}
+
+	header.stringsSize = strings.Count();
+
+	CUtlVector<byte> file;
+
+	file.AddMultipleToTail( sizeof( header ), (const byte *)&header );
+	file.AddMultipleToTail( records.Count() * sizeof( servercache_record_t ), (const byte *)records.Base() );
+	file.AddMultipleToTail( strings.Count(), (const byte *)strings.Base() );
+
+	EngFuncs::COM_SaveFile( SERVER_CACHE_FILE, file.Base(), file.Count() );
+}
+
+void CMenuServerBrowser::QueryServerList( const CServerAddressList &list )
 {
 	int curTab = tabSwitch.GetState();
 	if( curTab < 0 || curTab >= INTERNET_TAB_COUNT )
@@ -892,34 +2294,20 @@ void CMenuServerBrowser::QueryServerList( const CUtlVector<favlist_entry_t> &lis
 		if( !EngFuncs::textfuncs.pNetAPI->StringToAdr( (char *)list[i].sadr, &adr ))
 			continue;
 
-		bool found = false;
-
-		FOR_EACH_VEC( m_InternetServers[curTab], j )
-		{
-			if( !EngFuncs::NET_CompareAdr( &m_InternetServers[curTab][j].adr, &adr ))
-			{
-				found = true;
-				break;
-			}
-		}
-
-		if( !found )
+		if( !m_InternetServers[curTab].Contains( adr ))
 		{
 			CUtlString fakeInfoString;
 			list[i].GenerateDummyInfoString( fakeInfoString );
 
-			server_t serv( adr, fakeInfoString, list[i].favorited, true );
-			serv.UpdateData();
-			serv.SetPing( 9.999f );
-
 			// store dummy entry into per-tab buffer
-			m_InternetServers[curTab].AddToTail( serv );
+			int id = s_Servers.AddPending( adr, fakeInfoString, list[i].favorited );
+			m_InternetServers[curTab].Add( id );
 
 			// if this tab is currently visible, show the placeholder only when the
 			// visible model is empty (avoid flashing many dummy entries on each refresh)
 			if( curTab == tabSwitch.GetState() && gameListModel.GetRows() == 0 )
 			{
-				gameListModel.AddServerToList( adr, fakeInfoString, list[i].favorited );
+				gameListModel.AddServerToList( id );
 				joinGame->SetGrayed( false );
 				viewGameInfo->SetGrayed( false );
 				MaybeEnableFavoriteButton();
@@ -927,7 +2315,7 @@ void CMenuServerBrowser::QueryServerList( const CUtlVector<favlist_entry_t> &lis
 			}
 		}
 
-		list[i].QueryServer();
+		m_Scheduler.Queue( list[i], adr, favoritesList.Find( list[i].sadr ) >= 0 );
 	}
 
 	UI_MenuResetPing_f();
@@ -954,32 +2342,8 @@ void CMenuServerBrowser::RefreshList()
 			QueryServerList( historyList );
 		else
 		{
-			char filter[128] = "";
-			char *buf = filter;
-			int remaining = sizeof(filter);
-
-			if( filterEmpty.GetItem( ) )
-			{
-				int n = snprintf(buf, remaining, "\\empty\\%c", (char) filterEmpty.GetItem( ) );
-				remaining -= n;
-				buf += n;
-			}
-
-			if( filterFull.GetItem( ) )
-			{
-				int n = snprintf(buf, remaining, "\\full\\%c", (char) filterFull.GetItem( ) );
-				remaining -= n;
-				buf += n;
-			}
-
-			if( filterMap.GetItem( )[0] )
-			{
-				int n = snprintf(buf, remaining, "\\map\\%s", filterMap.GetItem( ) );
-				remaining -= n;
-				buf += n;
-			}
-
-			EngFuncs::ClientCmdF( false, "internetservers %s\n", filter );
+			// filters are applied locally, so they can change without asking master again
+			EngFuncs::ClientCmd( false, "internetservers\n" );
 		}
 
 		refreshTime2 = uiStatic.realTime + (EngFuncs::GetCvarFloat("cl_nat") ? 4000:1000);
@@ -996,7 +2360,7 @@ void CMenuServerBrowser::ViewGameInfo()
 	if( idx < 0 || idx >= gameListModel.GetRows( ))
 		return;
 
-	UI_ServerInfo_Menu( gameListModel.servers[idx].adr, gameListModel.servers[idx].name );
+	UI_ServerInfo_Menu( gameListModel.Server( idx ).adr, gameListModel.Server( idx ).Name() );
 }
 
 void CMenuServerBrowser::OnTabSwitch()
@@ -1014,16 +2378,13 @@ void CMenuServerBrowser::OnTabSwitch()
 		break;
 	}
 
-	ClearList();
 	// populate visible model from per-tab buffer so user sees cached results instantly
 	int newTab = tabSwitch.GetState();
 	if( newTab < 0 || newTab >= INTERNET_TAB_COUNT )
 		newTab = 0;  // Safety: default to Direct tab if invalid
-	for( int i = 0; i < m_InternetServers[newTab].Count(); ++i )
-	{
-		// re-add entries via model to apply filters and update UI controls
-		gameListModel.AddServerToList( m_InternetServers[newTab][i].adr, m_InternetServers[newTab][i].info, m_InternetServers[newTab][i].favorite );
-	}
+
+	gameListModel.SetSource( &m_InternetServers[newTab] );
+	ApplyFilters();
 	RefreshList();
 }
 
@@ -1031,10 +2392,10 @@ void CMenuServerBrowser::OnChangeSelectedServer( void )
 {
 	int i = gameList.GetCurrentIndex();
 
-	if( !gameListModel.servers.IsValidIndex( i ))
+	if( !gameListModel.IsValidRow( i ))
 		return;
 
-	bool fav = gameListModel.servers[i].favorite;
+	bool fav = gameListModel.Server( i ).favorite;
 	ToggleFavoriteButton( !fav );
 }
 
@@ -1071,14 +2432,10 @@ void CMenuServerBrowser::AddServer( void )
 	// FIXME: for now we can only show custom servers at favorites tab
 
 	// Check for duplicates in favorites list
-	FOR_EACH_VEC( favoritesList, i )
+	if( favoritesList.Find( addressField.GetBuffer(), proto ) >= 0 )
 	{
-		if( !strcmp( favoritesList[i].sadr, addressField.GetBuffer() ) &&
-		    !strcmp( favoritesList[i].prot, proto ))
-		{
-			UI_ShowMessageBox( L( "Server already in favorites" ));
-			return;
-		}
+		UI_ShowMessageBox( L( "Server already in favorites" ));
+		return;
 	}
 
 	favlist_entry_t entry( addressField.GetBuffer(), proto, false );
@@ -1093,16 +2450,14 @@ void CMenuServerBrowser::AddServer( void )
 	CUtlString fakeInfoString;
 	entry.GenerateDummyInfoString( fakeInfoString );
 
-	server_t serv( adr, fakeInfoString, false, true );
-	serv.UpdateData();
-	serv.SetPing( MAX_PING );
-	m_InternetServers[2].AddToTail( serv );
+	int id = s_Servers.AddPending( adr, fakeInfoString, false );
+	m_InternetServers[2].Add( id );
 	if( tabSwitch.GetState() == 2 )
 	{
-		gameListModel.AddServerToList( adr, fakeInfoString, false );
+		gameListModel.AddServerToList( id );
 	}
 
-	entry.QueryServer();
+	m_Scheduler.Queue( entry, adr, true );
 	UI_MenuResetPing_f();
 }
 
@@ -1113,6 +2468,10 @@ UI_Background_Ownerdraw
 */
 void CMenuServerBrowser::Draw( void )
 {
+	// list must be current before it's drawn, not a frame later
+	MergeResponses();
+	UpdateMapFilter();
+
 	CMenuFramework::Draw();
 
 	if( uiStatic.realTime > refreshTime )
@@ -1125,6 +2484,14 @@ void CMenuServerBrowser::Draw( void )
 	{
 		refresh->SetGrayed( false );
 	}
+
+	CUtlVector<int> visible;
+	int top = gameList.GetTopIndex();
+
+	for( int i = top; i < top + gameList.GetVisibleRows() && gameListModel.IsValidRow( i ); i++ )
+		visible.AddToTail( gameListModel.ServerId( i ));
+
+	m_Scheduler.Frame( visible );
 }
 
 bool CMenuServerBrowser::KeyUp( int key )
@@ -1182,6 +2549,7 @@ void CMenuServerBrowser::_Init( void )
 	gameList.SetupColumn( COLUMN_MAP, L( "GameUI_Map" ), 0.25f );
 	gameList.SetupColumn( COLUMN_PLAYERS, L( "Players" ), 100.0f, true );
 	gameList.SetupColumn( COLUMN_PING, L( "Ping" ), 120.0f, true );
+	gameList.SetupColumn( COLUMN_HISTORY, L( "Ping history" ), 0, true );
 	gameList.SetupColumn( COLUMN_IP, L( "IP" ), 0, true );
 	gameList.SetModel( &gameListModel );
 	gameList.bFramedHintText = true;
@@ -1278,9 +2646,8 @@ void CMenuServerBrowser::_Init( void )
 		CMenuDropDownFloat *self = (CMenuDropDownFloat*)pSelf;
 		CMenuServerBrowser *parent = (CMenuServerBrowser*)self->Parent();
 
-		parent->gameListModel.filterPing = self->GetItem( ) / 1000.0f;
-		parent->ClearList();
-		parent->RefreshList();
+		parent->gameListModel.filter.ping = self->GetItem( ) / 1000.0f;
+		parent->ApplyFilters();
 	});
 
 	filterEmpty.AddItem( L( "empty" ), '1' );
@@ -1297,9 +2664,8 @@ void CMenuServerBrowser::_Init( void )
 		CMenuDropDownInt *self = (CMenuDropDownInt*)pSelf;
 		CMenuServerBrowser *parent = (CMenuServerBrowser*)self->Parent();
 
-		parent->gameListModel.filterEmpty = self->GetItem( );
-		parent->ClearList();
-		parent->RefreshList();
+		parent->gameListModel.filter.empty = self->GetItem( );
+		parent->ApplyFilters();
 	});
 
 	filterFull.AddItem( L( "full" ), '1' );
@@ -1316,9 +2682,8 @@ void CMenuServerBrowser::_Init( void )
 		CMenuDropDownInt *self = (CMenuDropDownInt*)pSelf;
 		CMenuServerBrowser *parent = (CMenuServerBrowser*)self->Parent();
 
-		parent->gameListModel.filterFull = self->GetItem( );
-		parent->ClearList();
-		parent->RefreshList();
+		parent->gameListModel.filter.full = self->GetItem( );
+		parent->ApplyFilters();
 	});
 
 	filterMap.AddItem( L( "any map" ), "" );
@@ -1332,9 +2697,8 @@ void CMenuServerBrowser::_Init( void )
 		CMenuDropDownStr *self = (CMenuDropDownStr*)pSelf;
 		CMenuServerBrowser *parent = (CMenuServerBrowser*)self->Parent();
 
-		parent->gameListModel.SetFilterMap( self->GetItem( ) );
-		parent->ClearList();
-		parent->RefreshList();
+		Q_strncpy( parent->gameListModel.filter.map, self->GetItem( ), sizeof( parent->gameListModel.filter.map ));
+		parent->ApplyFilters();
 	});
 
 	AddItem( gameList );
@@ -1353,6 +2717,8 @@ CMenuServerBrowser::VidInit
 */
 void CMenuServerBrowser::_VidInit()
 {
+	gameList.SetColumnWidth( COLUMN_HISTORY, ui_serverhistory->value ? 100.0f : 0.0f, true );
+
 	refreshTime = uiStatic.realTime + 500; // delay before update 0.5 sec
 	refreshTime2 = uiStatic.realTime + 500;
 
@@ -1387,13 +2753,7 @@ bool CMenuServerBrowser::IsAddressInTab( int tab, const netadr_t &adr ) const
 	if( tab < 0 || tab >= INTERNET_TAB_COUNT )
 		return false;
 
-	FOR_EACH_VEC( m_InternetServers[tab], i )
-	{
-		if( !EngFuncs::NET_CompareAdr( &m_InternetServers[tab][i].adr, &adr ))
-			return true;
-	}
-
-	return false;
+	return m_InternetServers[tab].Contains( adr );
 }
 
 void CMenuServerBrowser::Show()
@@ -1420,6 +2780,14 @@ void CMenuServerBrowser::Show()
 			ParseServerListFromFile( "favorite_servers.lst", favoritesList );
 		if( EngFuncs::FileExists( "history_servers.lst", true ) )
 			ParseServerListFromFile( "history_servers.lst", historyList );
+
+		// first time this session, show what we had last time until servers answer
+		bool haveServers = false;
+		for( int i = 0; i < INTERNET_TAB_COUNT; i++ )
+			haveServers |= m_InternetServers[i].Count() != 0;
+
+		if( !haveServers )
+			LoadServerCache();
 	}
 
 	RealignButtons();
@@ -1435,111 +2803,122 @@ void CMenuServerBrowser::Show()
 	// restore cached servers for current tab if they were already loaded
 	if( m_bLanOnly )
 	{
-		for( int i = 0; i < m_LanServers.Count(); ++i )
-		{
-			gameListModel.AddServerToList( m_LanServers[i].adr, m_LanServers[i].info, m_LanServers[i].favorite );
-		}
+		gameListModel.SetSource( &m_LanServers );
 	}
 	else
 	{
 		int curTab = tabSwitch.GetState();
 		if( curTab < 0 || curTab >= INTERNET_TAB_COUNT )
 			curTab = 0;  // Safety: default to Direct tab if invalid
-		for( int i = 0; i < m_InternetServers[curTab].Count(); ++i )
-		{
-			gameListModel.AddServerToList( m_InternetServers[curTab][i].adr, m_InternetServers[curTab][i].info, m_InternetServers[curTab][i].favorite );
-		}
+		gameListModel.SetSource( &m_InternetServers[curTab] );
 	}
+	ApplyFilters();
 	m_iLastRefreshTab = -1;
 }
 
 void CMenuServerBrowser::SaveLists()
 {
-	// TODO: we can actually cache master server response, so every time
-	// player opens up this menu, they instantly get server list at first
-	// and then re-sync with master server is just delayed
-	// ... but I'm tired with this, so let's do it next time :)
-
 	if( m_bLanOnly )
 		return;
 
 	SaveServerListToFile( "favorite_servers.lst", favoritesList );
 	SaveServerListToFile( "history_servers.lst", historyList );
+	SaveServerCache();
 }
 
 void CMenuServerBrowser::Hide()
 {
+	MergeResponses();
+	m_Scheduler.RemoveAll();
 	SaveLists();
 	CMenuFramework::Hide();
 }
 
 void CMenuServerBrowser::AddServerToList( netadr_t adr, const char *info )
 {
-#ifndef XASH_ALL_SERVERS
-	if( stricmp( gMenu.m_gameinfo.gamefolder, Info_ValueForKey( info, "gamedir" )) != 0 )
-		return;
-#endif
-
 	if( !WasInit() )
 		return;
 
 	if( !IsVisible() )
 		return;
 
-	const char *s = EngFuncs::NET_AdrToString( adr );
-	bool is_favorite = false;
+	response_t &response = m_responses[m_responses.AddToTail()];
+	int len = strlen( info ) + 1;
 
-	FOR_EACH_VEC( favoritesList, i )
+	// queried by us, not by master server response
+	double sendTime = m_Scheduler.Answered( adr );
+
+	response.adr = adr;
+	response.ping = EngFuncs::DoubleTime() - ( sendTime >= 0.0 ? sendTime : gameListModel.serversRefreshTime );
+	response.info = m_responseInfos.AddMultipleToTail( len, info );
+}
+
+void CMenuServerBrowser::MergeResponses( void )
+{
+	if( !m_responses.Count() )
+		return;
+
+	PROFILE_SCOPE( "CMenuServerBrowser::MergeResponses" );
+
+	CUtlVector<int> visible;
+
+	FOR_EACH_VEC( m_responses, i )
 	{
-		if( !strcmp( favoritesList[i].sadr, s ))
-		{
-			is_favorite = favoritesList[i].favorited;
-			break;
-		}
+		int id = MergeResponse( m_responses[i] );
+
+		if( id >= 0 )
+			visible.AddToTail( id );
 	}
 
+	m_responses.RemoveAll();
+	m_responseInfos.RemoveAll();
+
+	if( !visible.Count() )
+		return;
+
+	gameListModel.MergeServers( visible );
+
+	joinGame->SetGrayed( false );
+	viewGameInfo->SetGrayed( false );
+	MaybeEnableFavoriteButton();
+	OnChangeSelectedServer();
+}
+
+// returns server id if it belongs to visible list
+int CMenuServerBrowser::MergeResponse( const response_t &response )
+{
+	const netadr_t &adr = response.adr;
+	const char *info = m_responseInfos.Base() + response.info;
+	CInfoString parsed( info );
+
+#ifndef XASH_ALL_SERVERS
+	char gamedir[64];
+	parsed.Value( CInfoString::KEY_GAMEDIR ).Copy( gamedir, sizeof( gamedir ));
+
+	if( stricmp( gMenu.m_gameinfo.gamefolder, gamedir ) != 0 )
+		return -1;
+#endif
+
+	const char *s = EngFuncs::NET_AdrToString( adr );
+	int fav = favoritesList.Find( s );
+	bool is_favorite = fav >= 0 && favoritesList[fav].favorited;
+	float ping = response.ping;
+
 	// Handle LAN servers separately
 	if( m_bLanOnly )
 	{
-		CUtlVector<server_t> &buf = m_LanServers;
-		int pos = -1;
-		for( int i = 0; i < buf.Count(); ++i )
-		{
-			if( !EngFuncs::NET_CompareAdr( &buf[i].adr, &adr ))
-			{
-				pos = i;
-				break;
-			}
-		}
-
-		if( pos >= 0 )
-		{
-			Q_strncpy( buf[pos].info, info, sizeof( buf[pos].info ));
-			buf[pos].UpdateData();
-			buf[pos].SetPing( EngFuncs::DoubleTime() - gameListModel.serversRefreshTime );
-			buf[pos].pending_info = false;
-		}
-		else
-		{
-			server_t serv( adr, info, false );
-			serv.UpdateData();
-			serv.SetPing( EngFuncs::DoubleTime() - gameListModel.serversRefreshTime );
-			buf.AddToTail( serv );
-		}
+		int id = s_Servers.Update( adr, info, parsed, ping );
+		m_LanServers.Add( id );
+		RefreshIndices( id );
 
 		// Always update visible model for LAN
-		gameListModel.AddServerToList( adr, info, false );
-		joinGame->SetGrayed( false );
-		viewGameInfo->SetGrayed( false );
-		MaybeEnableFavoriteButton();
-		OnChangeSelectedServer();
-		return;
+		return id;
 	}
 
 	// Internet games logic
 	int curTabVisible = tabSwitch.GetState();
 	if( curTabVisible < 0 || curTabVisible >= INTERNET_TAB_COUNT )
-		return;  // Safety: invalid tab index
+		return -1;  // Safety: invalid tab index
 
 	int targetTab = -1;
 
@@ -1566,70 +2945,31 @@ void CMenuServerBrowser::AddServerToList( netadr_t adr, const char *info )
 
 	if( targetTab == 2 ) // Favorites
 	{
-		bool found = false;
-		FOR_EACH_VEC( favoritesList, j )
-		{
-			if( !strcmp( favoritesList[j].sadr, s ))
-			{
-				found = true;
-				break;
-			}
-		}
-		if( !found )
-			return;
+		if( fav < 0 )
+			return -1;
 	}
 	else if( targetTab == 3 ) // History
 	{
-		bool found = false;
-		FOR_EACH_VEC( historyList, j )
-		{
-			if( !strcmp( historyList[j].sadr, s ))
-			{
-				found = true;
-				break;
-			}
-		}
-		if( !found )
-			return;
-	}
-
-	// Add or update entry in per-tab buffer
-	CUtlVector<server_t> &buf = m_InternetServers[targetTab];
-	int pos = -1;
-	for( int i = 0; i < buf.Count(); ++i )
-	{
-		if( !EngFuncs::NET_CompareAdr( &buf[i].adr, &adr ))
-		{
-			pos = i;
-			break;
-		}
+		if( historyList.Find( s ) < 0 )
+			return -1;
 	}
 
-	if( pos >= 0 )
-	{
-		Q_strncpy( buf[pos].info, info, sizeof( buf[pos].info ));
-		buf[pos].UpdateData();
-		buf[pos].SetPing( EngFuncs::DoubleTime() - gameListModel.serversRefreshTime );
-		buf[pos].pending_info = false;
-	}
-	else
-	{
-		server_t serv( adr, info, is_favorite );
-		serv.UpdateData();
-		serv.SetPing( EngFuncs::DoubleTime() - gameListModel.serversRefreshTime );
-		buf.AddToTail( serv );
-	}
+	// Add or update shared record and put it into per-tab buffer
+	int id = s_Servers.Update( adr, info, parsed, ping );
+	s_Servers[id].favorite = is_favorite; // row version is already bumped by update
+	m_InternetServers[targetTab].Add( id );
+	RefreshIndices( id );
 
 	// If this response belongs to the currently visible tab, update visible model
-	if( targetTab == curTabVisible )
-	{
-		gameListModel.AddServerToList( adr, info, is_favorite );
+	return targetTab == curTabVisible ? id : -1;
+}
 
-		joinGame->SetGrayed( false );
-		viewGameInfo->SetGrayed( false );
-		MaybeEnableFavoriteButton();
-		OnChangeSelectedServer();
-	}
+void CMenuServerBrowser::RefreshIndices( int id )
+{
+	for( int i = 0; i < INTERNET_TAB_COUNT; i++ )
+		m_InternetServers[i].Refresh( id );
+
+	m_LanServers.Refresh( id );
 }
 
 /*
@@ -22,10 +22,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "Table.h"
 #include "Action.h"
 #include "PicButton.h"
+#include "CheckBox.h"
+#include "ColumnarModel.h"
 #include "utlvector.h"
 #include "utlstring.h"
 
 #define ART_BANNER "gfx/shell/head_multi"
+#define MAX_INFO_PLAYERS 256 // player indices above are ignored
 
 enum
 {
@@ -38,130 +41,192 @@ enum
 	COLUMN_VALUE
 };
 
-struct player_entry_t
+// offsets in CMenuServerRuleModel arena
+struct server_rule_t
 {
-	player_entry_t( int index, const char *name, int frags, float time ) :
-		index( index ), name( name ), frags( frags ), time( time )
+	int rule;
+	int value;
+};
+
+// rows live across refreshes and are updated in place
+class CMenuPlayerListModel : public CMenuColumnarModel
+{
+public:
+	CMenuPlayerListModel()
 	{
-		index_str.Format( "%i", index );
-		frags_str.Format( "%i", frags );
+		AddColumn( COLUMN_TYPE_INT );    // COLUMN_POSITION
+		AddColumn( COLUMN_TYPE_STRING ); // COLUMN_NAME
+		AddColumn( COLUMN_TYPE_INT );    // COLUMN_FRAGS
+		AddColumn( COLUMN_TYPE_INT );    // COLUMN_TIME, seconds
 
-		int hours = time / 3600;
-		int minutes = ( time - hours * 3600 ) / 60;
-		int seconds = ( time - hours * 3600 - minutes * 60 );
+		SetSecondarySort( COLUMN_NAME, true );
+	}
 
-		if( hours != 0 )
-			time_str.Format( "%02i:%02i:%02i", hours, minutes, seconds );
-		else
-			time_str.Format( "%02i:%02i", minutes, seconds );
+	void Update() override { }
+
+	bool IsCellAnimated( int line, int column ) const override
+	{
+		float changedTime = ChangedTime( Row( line ), column );
+
+		return changedTime > 0.0f && EngFuncs::DoubleTime() - changedTime < FLASH_FADE_TIME;
 	}
 
-	CUtlString index_str;
-	int index;
+	bool GetCellColors( int line, int column, unsigned int &textColor, bool &force ) const override
+	{
+		int row = Row( line );
+		float changedTime = ChangedTime( row, column );
+
+		if( changedTime <= 0.0f )
+			return false;
 
-	CUtlString name;
+		unsigned int flashColor = FlashColor( column == COLUMN_NAME || GetInt( row, COLUMN_FRAGS ) > players[row].prevFrags );
 
-	CUtlString frags_str;
-	int frags;
+		if( !FadeFlashColor( EngFuncs::DoubleTime() - changedTime, flashColor, uiPromptTextColor, textColor ))
+			return false;
 
-	CUtlString time_str;
-	float time;
+		force = true;
+		return true;
+	}
 
-	int IndexCmp( const player_entry_t &other ) const
+	void RemoveAll()
 	{
-		if( index > other.index ) return 1;
-		else if( index < other.index ) return -1;
-		return 0;
+		CMenuColumnarModel::RemoveAll();
+		players.RemoveAll();
 	}
 
-	int NameCmp( const player_entry_t &other ) const
+	void Merge( const infoplayer_t *decoded, int count, bool flash );
+
+protected:
+	void FormatCell( int row, int column, char *buf, size_t size ) const override
 	{
-		return colorstricmp( name.String(), other.name.String() );
+		if( column != COLUMN_TIME )
+		{
+			CMenuColumnarModel::FormatCell( row, column, buf, size );
+			return;
+		}
+
+		int time = GetInt( row, column );
+		int hours = time / 3600;
+		int minutes = ( time - hours * 3600 ) / 60;
+		int seconds = ( time - hours * 3600 - minutes * 60 );
+
+		if( hours != 0 )
+			snprintf( buf, size, "%02i:%02i:%02i", hours, minutes, seconds );
+		else
+			snprintf( buf, size, "%02i:%02i", minutes, seconds );
 	}
 
-	int FragsCmp( const player_entry_t &other ) const
+private:
+	// what's not shown in the table, by row
+	struct player_t
+	{
+		bool seen; // matched by current response
+		int prevFrags;
+		float fragsChangedTime;
+		float joinedTime;
+	};
+
+	float ChangedTime( int row, int column ) const
 	{
-		if( frags > other.frags ) return 1;
-		else if( frags < other.frags ) return -1;
-		return 0;
+		switch( column )
+		{
+		case COLUMN_NAME: return players[row].joinedTime;
+		case COLUMN_FRAGS: return players[row].fragsChangedTime;
+		}
+		return 0.0f;
 	}
 
-	int TimeCmp( const player_entry_t &other ) const
+	bool HasName( int row, const char *name ) const
 	{
-		if( time > other.time ) return 1;
-		else if( time < other.time ) return -1;
-		return 0;
+		return !strcmp( GetString( row, COLUMN_NAME ), name );
 	}
 
-#define GENERATE_COMPAR_FN( method ) \
-	static int method ## Ascend( const player_entry_t *a, const player_entry_t *b ) \
-	{\
-		return a->method( *b );\
-	}\
-	static int method ## Descend( const player_entry_t *a, const player_entry_t *b ) \
-	{\
-		return b->method( *a );\
-	}\
-
-	GENERATE_COMPAR_FN( IndexCmp )
-	GENERATE_COMPAR_FN( NameCmp )
-	GENERATE_COMPAR_FN( FragsCmp )
-	GENERATE_COMPAR_FN( TimeCmp )
-
-#undef GENERATE_COMPAR_FN
-};
+	int FindByName( const char *name ) const
+	{
+		for( int row = 0; row < RowCount(); row++ )
+		{
+			if( !players[row].seen && HasName( row, name ))
+				return row;
+		}
+		return -1;
+	}
 
-struct server_rule_t
-{
-	CUtlString rule;
-	CUtlString value;
+	CUtlVector<player_t> players;
+	short m_rowByIndex[MAX_INFO_PLAYERS]; // previous response index to row, rebuilt by Merge
 };
 
-class CMenuPlayerListModel : public CMenuBaseModel
-{
-public:
-	CMenuPlayerListModel() : CMenuBaseModel() {}
+/*
+=================
+CMenuPlayerListModel::Merge
 
-	void Update() override { }
+Players are matched to existing rows by index, or by name if
+someone left and indices shifted. Only changed rows are touched
+and moved, so sort order and table row cache stay intact.
+=================
+*/
+void CMenuPlayerListModel::Merge( const infoplayer_t *decoded, int count, bool flash )
+{
+	float now = EngFuncs::DoubleTime();
 
-	int GetColumns() const override { return 4;	}
-	int GetRows() const override { return players.Count(); }
+	for( int i = 0; i < MAX_INFO_PLAYERS; i++ )
+		m_rowByIndex[i] = -1;
 
-	bool Sort( int column, bool ascend ) override
+	for( int row = 0; row < RowCount(); row++ )
 	{
-		switch( column )
-		{
-		case COLUMN_POSITION:
-			players.Sort( ascend ? player_entry_t::IndexCmpAscend : player_entry_t::IndexCmpDescend );
-			return true;
-		case COLUMN_NAME:
-			players.Sort( ascend ? player_entry_t::NameCmpAscend : player_entry_t::NameCmpDescend );
-			return true;
-		case COLUMN_FRAGS:
-			players.Sort( ascend ? player_entry_t::FragsCmpAscend : player_entry_t::FragsCmpDescend );
-			return true;
-		case COLUMN_TIME:
-			players.Sort( ascend ? player_entry_t::TimeCmpAscend : player_entry_t::TimeCmpDescend );
-			return true;
-		}
+		int index = GetInt( row, COLUMN_POSITION );
 
-		return false;
+		players[row].seen = false;
+		if( index < MAX_INFO_PLAYERS )
+			m_rowByIndex[index] = row;
 	}
 
-	const char *GetCellText( int line, int column ) override
+	for( int i = 0; i < count; i++ )
 	{
-		switch( column )
+		const infoplayer_t &d = decoded[i];
+		char name[128];
+		int row = m_rowByIndex[i];
+
+		d.name.Copy( name, sizeof( name ));
+
+		if( row < 0 || players[row].seen || !HasName( row, name ))
+			row = FindByName( name );
+
+		if( row < 0 )
 		{
-		case COLUMN_POSITION: return players[line].index_str.String();
-		case COLUMN_NAME: return players[line].name.String();
-		case COLUMN_FRAGS: return players[line].frags_str.String();
-		case COLUMN_TIME: return players[line].time_str.String();
+			row = AddRow();
+			player_t &p = players[players.AddToTail()];
+
+			p.prevFrags = d.frags;
+			p.fragsChangedTime = 0.0f;
+			p.joinedTime = flash ? now : 0.0f;
+
+			SetString( row, COLUMN_NAME, name );
 		}
-		return nullptr;
+		else if( GetInt( row, COLUMN_FRAGS ) != d.frags )
+		{
+			players[row].prevFrags = GetInt( row, COLUMN_FRAGS );
+			players[row].fragsChangedTime = now;
+		}
+
+		players[row].seen = true;
+
+		// time is sent with fractions, row changes only once per second
+		SetInt( row, COLUMN_POSITION, i );
+		SetInt( row, COLUMN_FRAGS, d.frags );
+		SetInt( row, COLUMN_TIME, (int)d.time );
+
+		Reposition( row );
 	}
 
-	CUtlVector<player_entry_t> players;
-};
+	for( int row = RowCount() - 1; row >= 0; row-- )
+	{
+		if( players[row].seen )
+			continue;
+
+		RemoveRow( row );
+		players.FastRemove( row );
+	}
+}
 
 class CMenuServerRuleModel : public CMenuBaseModel
 {
@@ -175,13 +240,41 @@ public:
 	{
 		switch( column )
 		{
-		case COLUMN_RULE: return rules[line].rule.String();
-		case COLUMN_VALUE: return rules[line].value.String();
+		case COLUMN_RULE: return arena.Base() + rules[line].rule;
+		case COLUMN_VALUE: return arena.Base() + rules[line].value;
 		}
 		return nullptr;
 	}
 
+	void RemoveAll()
+	{
+		rules.RemoveAll();
+		arena.RemoveAll();
+	}
+
+	void AddRule( const infospan_t &rule, const infospan_t &value )
+	{
+		server_rule_t &r = rules[rules.AddToTail()];
+
+		r.rule = AddString( rule );
+		r.value = AddString( value );
+	}
+
 	CUtlVector<server_rule_t> rules;
+
+private:
+	int AddString( const infospan_t &s )
+	{
+		int offset = arena.AddMultipleToTail( s.len + 1 );
+
+		memcpy( arena.Base() + offset, s.str, s.len );
+		arena[offset + s.len] = 0;
+
+		return offset;
+	}
+
+	// all strings of all rules, one allocation for whole response
+	CUtlVector<char> arena;
 };
 
 class CMenuServerInfo : public CMenuFramework
@@ -202,8 +295,10 @@ public:
 
 	void Show() override;
 	void Hide() override;
+	void Draw() override;
 
 	void DoNetworkRequests();
+	void CancelNetworkRequests();
 
 	void PingResponse( net_response_t *resp );
 	void PlayersResponse( net_response_t *resp );
@@ -225,6 +320,7 @@ private:
 	CMenuAction server_pingtime;
 
 	CMenuPicButton done;
+	CMenuCheckBox autoRefresh;
 
 	CMenuTable players_list;
 	CMenuTable rules_list;
@@ -239,6 +335,15 @@ private:
 	int32_t ping_context;
 	int32_t players_context;
 	int32_t rules_context;
+
+	infoplayer_t decoded_players[MAX_INFO_PLAYERS];
+	bool players_received; // later responses flash changed rows
+
+	float ping;             // -1 until first answer
+	float ping_changed_time;
+	bool ping_better;
+
+	int refresh_time; // in uiStatic.realTime
 };
 
 ADD_MENU( menu_serverinfo, CMenuServerInfo, UI_ServerInfo_Menu )
@@ -258,7 +363,17 @@ void CMenuServerInfo::PingResponse( net_response_t *resp )
 	if( resp->response == nullptr )
 		return;
 
-	snprintf( ping_str, sizeof( ping_str ), "%.f ms.", resp->ping * 1000.0f );
+	float newPing = resp->ping * 1000.0f;
+
+	// flash only if rounded value has changed
+	if( ping >= 0.0f && (int)( newPing + 0.5f ) != (int)( ping + 0.5f ))
+	{
+		ping_changed_time = EngFuncs::DoubleTime();
+		ping_better = newPing < ping;
+	}
+
+	ping = newPing;
+	snprintf( ping_str, sizeof( ping_str ), "%.f ms.", ping );
 	server_pingtime.szName = ping_str;
 }
 
@@ -270,32 +385,10 @@ void CMenuServerInfo::PlayersResponse( net_response_t *resp )
 	if( resp->response == nullptr )
 		return;
 
-	char *s = (char *)resp->response;
-
-	int count = atoi( Info_ValueForKey( s, "players" ));
-	players_model.players.EnsureCapacity( count );
-
-	for( int i = 0; i < count; i++ )
-	{
-		char temp[64];
-		const char *name;
-		int frags;
-		float time;
-
-		snprintf( temp, sizeof( temp ), "p%ifrags", i );
-		frags = atoi( Info_ValueForKey( s, temp ));
-
-		snprintf( temp, sizeof( temp ), "p%itime", i );
-		time = atof( Info_ValueForKey( s, temp ));
+	int count = Info_DecodePlayers( (const char *)resp->response, decoded_players, MAX_INFO_PLAYERS );
 
-		// keep last so pointer returned by Info_ValueForKey won't be rewritten
-		snprintf( temp, sizeof( temp ), "p%iname", i );
-		name = Info_ValueForKey( s, temp );
-
-		player_entry_t entry( i, name, frags, time );
-
-		players_model.players.AddToTail( entry );
-	}
+	players_model.Merge( decoded_players, count, players_received );
+	players_received = true;
 }
 
 void CMenuServerInfo::RulesResponse( net_response_t *resp )
@@ -306,31 +399,24 @@ void CMenuServerInfo::RulesResponse( net_response_t *resp )
 	if( resp->response == nullptr )
 		return;
 
-	char *s = (char *)resp->response;
-	int count = atoi( Info_ValueForKey( s, "rules" ));
-	char *p;
-
-	rules_model.rules.EnsureCapacity( count );
+	CInfoStringReader reader( (const char *)resp->response );
+	infospan_t key, value;
 
-	p = strtok( s, "\\" );
+	// rules rarely change, rebuilding them reuses the arena
+	rules_model.RemoveAll();
 
-	do
+	while( reader.Next( key, value ))
 	{
-		server_rule_t rule;
-
-		if( p == nullptr )
-			break;
-		rule.rule.SetValue( p );
-
-		if(( p = strtok( nullptr, "\\" )) == nullptr )
-			break;
-		rule.value.SetValue( p );
-
-		if( rule.rule != "rules" )
-			rules_model.rules.AddToTail( rule );
+		if( CInfoString::LookupKey( key.str, key.len ) == CInfoString::KEY_RULES )
+		{
+			// only a hint from the server, don't let it pick allocation size
+			int hint = value.ToInt();
+			rules_model.rules.EnsureCapacity( bound( 0, hint, CInfoString::MAX_PAIRS ));
+			continue;
+		}
 
-		p = strtok( nullptr, "\\" );
-	} while( true );
+		rules_model.AddRule( key, value );
+	}
 }
 
 void CMenuServerInfo::PingResponseFunc( net_response_t *resp )
@@ -362,29 +448,61 @@ void CMenuServerInfo::DoNetworkRequests()
 
 	rules_context = EngFuncs::RandomLong( 0, 0x7fffffff );
 	EngFuncs::textfuncs.pNetAPI->SendRequest( rules_context, NETAPI_REQUEST_RULES, flags, timeout, &m_adr, CMenuServerInfo::RulesResponseFunc );
+
+	refresh_time = uiStatic.realTime + Q_max( 1.0f, ui_serverinfo_refresh->value ) * 1000;
+}
+
+void CMenuServerInfo::CancelNetworkRequests()
+{
+	EngFuncs::textfuncs.pNetAPI->CancelRequest( rules_context );
+	EngFuncs::textfuncs.pNetAPI->CancelRequest( players_context );
+	EngFuncs::textfuncs.pNetAPI->CancelRequest( ping_context );
+
+	ping_context = players_context = rules_context = -1;
 }
 
 void CMenuServerInfo::Show()
 {
 	CMenuFramework::Show();
 
-	players_model.players.RemoveAll();
-	rules_model.rules.RemoveAll();
+	players_model.RemoveAll();
+	rules_model.RemoveAll();
+	players_received = false;
+
+	ping = -1.0f;
+	ping_changed_time = 0.0f;
+	server_pingtime.szName = "??? ms.";
+	server_pingtime.colorBase = uiColorWhite;
 
 	players_list.SetSortingColumn( COLUMN_POSITION, true );
 }
 
 void CMenuServerInfo::Hide()
 {
-	EngFuncs::textfuncs.pNetAPI->CancelRequest( rules_context );
-	EngFuncs::textfuncs.pNetAPI->CancelRequest( players_context );
-	EngFuncs::textfuncs.pNetAPI->CancelRequest( ping_context );
-
-	ping_context = players_context = rules_context = -1;
+	CancelNetworkRequests();
 
 	CMenuFramework::Hide();
 }
 
+void CMenuServerInfo::Draw()
+{
+	if( autoRefresh.bChecked && uiStatic.realTime > refresh_time )
+	{
+		// previous answers are late, drop them
+		CancelNetworkRequests();
+		DoNetworkRequests();
+	}
+
+	unsigned int pingColor = uiColorWhite;
+
+	if( ping_changed_time > 0.0f )
+		FadeFlashColor( EngFuncs::DoubleTime() - ping_changed_time, FlashColor( ping_better ), uiColorWhite, pingColor );
+
+	server_pingtime.colorBase = pingColor;
+
+	CMenuFramework::Draw();
+}
+
 void CMenuServerInfo::_Init()
 {
 	banner.SetPicture( ART_BANNER );
@@ -427,6 +545,9 @@ void CMenuServerInfo::_Init()
 	done.onReleased = VoidCb( &CMenuServerInfo::Hide );
 	done.SetCoord( 72, 650 );
 
+	autoRefresh.SetNameAndStatus( L( "Refresh automatically" ), L( "Update ping, players and rules every few seconds" ));
+	autoRefresh.SetCoord( 72, 700 );
+
 	players_list.bAllowSorting = true;
 	players_list.SetModel( &players_model );
 	players_list.SetCharSize( QM_SMALLFONT );
@@ -449,6 +570,7 @@ void CMenuServerInfo::_Init()
 	AddItem( server_pingtime_hint );
 	AddItem( server_pingtime );
 	AddItem( done );
+	AddItem( autoRefresh );
 	AddItem( players_list );
 	AddItem( rules_list );
 }
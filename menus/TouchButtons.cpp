@@ -66,6 +66,7 @@ public:
 	} model;
 
 	void Confirm();
+	void SelectCommand( const char *cmd );
 
 	CMenuTouchButtons *pCaller;
 	CMenuAction title;
@@ -202,6 +203,8 @@ void CMenuTouchButtons::CButtonListModel::AddButtonToList( const char *name, con
 
 void CMenuTouchButtons::CButtonListModel::Update()
 {
+	PROFILE_SCOPE( "CButtonListModel::Update" );
+
 	if( !initialized )
 		return;
 
@@ -605,6 +608,7 @@ void CMenuTouchButtons::FileDialogCallback( bool success )
 void CMenuTouchButtons::OpenCommandPicker()
 {
 	cmdPicker.Show();
+	cmdPicker.SelectCommand( command.GetBuffer() );
 }
 
 void CMenuTouchButtons::OnCommandPicked( const char *cmd )
@@ -624,6 +628,14 @@ void CMenuCommandPickerDialog::Confirm()
 	Hide();
 }
 
+void CMenuCommandPickerDialog::SelectCommand( const char *cmd )
+{
+	int line = model.FindAction( cmd );
+
+	if( line >= 0 )
+		list.SetCurrentIndex( line );
+}
+
 void CMenuCommandPickerDialog::_Init()
 {
 	title.szName = L( "Pick command" );
@@ -89,6 +89,8 @@ public:
 
 void CMenuTouchOptions::CProfiliesListModel::Update( void )
 {
+	PROFILE_SCOPE( "CProfiliesListModel::Update" );
+
 	char **filenames;
 	int numFiles;
 	const char *curprofile;
@@ -134,6 +134,8 @@ public:
 
 void CMenuVidModesModel::Update()
 {
+	PROFILE_SCOPE( "CMenuVidModesModel::Update" );
+
 	m_szModes.Purge();
 
 	for( int i = 0; ; i++ )
@@ -149,6 +151,8 @@ void CMenuVidModesModel::Update()
 
 void CMenuRenderersModel::Update()
 {
+	PROFILE_SCOPE( "CMenuRenderersModel::Update" );
+
 	const char *r_refdll_loaded = EngFuncs::GetCvarString( "r_refdll_loaded" );
 	m_refs.Purge();
 
@@ -70,7 +70,7 @@ public:
 	static void ListItemCvarWriteCb( CMenuBaseItem *pSelf, void *pExtra );
 	static void ListItemCvarGetCb( CMenuBaseItem *pSelf, void *pExtra );
 
-	scrvardef_t *m_pVars;
+	CScriptCvarTable m_vars;
 
 private:
 	CMenuSpinControl pageSelector;
@@ -81,7 +81,6 @@ private:
 	void _Init() override;
 
 	const char *m_szConfig;
-	int m_iVarsCount;
 	int m_iPagesIndex;
 	int m_iPagesCount;
 	int m_iCurrentPage;
@@ -126,14 +125,13 @@ void CMenuScriptConfigPage::Save()
 }
 
 CMenuScriptConfig::CMenuScriptConfig() : CMenuFramework( "ScriptConfig" ),
-	m_pVars(), m_szConfig(), m_iVarsCount(), m_iPagesIndex(), m_iPagesCount(), m_iCurrentPage(), m_bIsSettingsConfig()
+	m_szConfig(), m_iPagesIndex(), m_iPagesCount(), m_iCurrentPage(), m_bIsSettingsConfig()
 {
 
 }
 
 CMenuScriptConfig::~CMenuScriptConfig()
 {
-	CSCR_FreeList( m_pVars );
 	for( int i = m_iPagesIndex; i < m_iPagesIndex + m_iPagesCount; i++ )
 	{
 		delete m_pItems[i];
@@ -144,32 +142,31 @@ void CMenuScriptConfig::ListItemCvarWriteCb(CMenuBaseItem *pSelf, void *pExtra)
 {
 	CMenuSpinControl *self = (CMenuSpinControl*)pSelf;
 	scrvarlist_t *list = (scrvarlist_t*)pExtra;
-	scrvarlistentry_t *entry = list->pEntries;
-
 	int entryNum = (int)self->GetCurrentValue();
-	for( int i = 0; i < entryNum; i++, entry = entry->next );
 
-	EngFuncs::CvarSetValue( self->CvarName(), entry->flValue );
+	if( entryNum < 0 || entryNum >= list->iCount )
+		return;
+
+	EngFuncs::CvarSetValue( self->CvarName(), list->pEntries[entryNum].flValue );
 }
 
 void CMenuScriptConfig::ListItemCvarGetCb(CMenuBaseItem *pSelf, void *pExtra)
 {
 	CMenuSpinControl *self = (CMenuSpinControl*)pSelf;
 	scrvarlist_t *list = (scrvarlist_t*)pExtra;
-	scrvarlistentry_t *entry = list->pEntries;
 
 	float value = EngFuncs::GetCvarFloat( self->CvarName() );
 	int i;
-	for( i = 0; entry; entry = entry->next, i++ )
+	for( i = 0; i < list->iCount; i++ )
 	{
-		if( entry->flValue == value )
+		if( list->pEntries[i].flValue == value )
 		{
 			self->SetCurrentValue( i );
 			break;
 		}
 	}
 
-	if( entry )
+	if( i < list->iCount )
 	{
 		self->SetCvarValue( i );
 	}
@@ -186,17 +183,17 @@ static void ScriptCvarGetNoSync( CMenuBaseItem *pSelf, void *pExtra )
 	{
 	case T_BOOL:
 	{
-		self->SetOriginalValue( ( var->value[0] == '1' ) ? 1.0f : 0.0f );
+		self->SetOriginalValue( ( var->value.String()[0] == '1' ) ? 1.0f : 0.0f );
 		break;
 	}
 	case T_NUMBER:
 	{
-		self->SetOriginalValue( (float)atof( var->value ) );
+		self->SetOriginalValue( (float)atof( var->value.String() ) );
 		break;
 	}
 	case T_STRING:
 	{
-		self->SetOriginalString( var->value );
+		self->SetOriginalString( var->value.String() );
 		break;
 	}
 	default:
@@ -216,7 +213,7 @@ static void ScriptCvarGetSync( CMenuBaseItem *pSelf, void *pExtra )
 	case T_BOOL:
 	{
 		float eng = EngFuncs::GetCvarFloat( var->name );
-		float scr = ( var->value[0] == '1' ) ? 1.0f : 0.0f;
+		float scr = ( var->value.String()[0] == '1' ) ? 1.0f : 0.0f;
 		if( eng != scr ) self->SetOriginalValue( eng );
 		else self->SetOriginalValue( scr );
 		break;
@@ -224,7 +221,7 @@ static void ScriptCvarGetSync( CMenuBaseItem *pSelf, void *pExtra )
 	case T_NUMBER:
 	{
 		float eng = EngFuncs::GetCvarFloat( var->name );
-		float scr = (float)atof( var->value );
+		float scr = (float)atof( var->value.String() );
 		if( eng != scr ) self->SetOriginalValue( eng );
 		else self->SetOriginalValue( scr );
 		break;
@@ -232,10 +229,10 @@ static void ScriptCvarGetSync( CMenuBaseItem *pSelf, void *pExtra )
 	case T_STRING:
 	{
 		const char *eng = EngFuncs::GetCvarString( var->name );
-		if( eng && strcmp( eng, var->value ) )
+		if( eng && strcmp( eng, var->value.String() ) )
 			self->SetOriginalString( eng );
 		else
-			self->SetOriginalString( var->value );
+			self->SetOriginalString( var->value.String() );
 		break;
 	}
 	default:
@@ -255,21 +252,18 @@ static void ScriptCvarWriteNoSync( CMenuBaseItem *pSelf, void *pExtra )
 	case T_BOOL:
 	{
 		int v = (int)self->CvarValue();
-		Q_strncpy( var->value, v ? "1" : "0", sizeof( var->value ) );
+		var->value = v ? "1" : "0";
 		break;
 	}
 	case T_NUMBER:
 	{
-		char tmp[64];
-		snprintf( tmp, sizeof( tmp ), "%g", self->CvarValue() );
-		Q_strncpy( var->value, tmp, sizeof( var->value ) );
+		var->value.Format( "%g", self->CvarValue() );
 		break;
 	}
 	case T_STRING:
 	{
 		const char *s = self->CvarString();
-		if( s ) Q_strncpy( var->value, s, sizeof( var->value ) );
-		else var->value[0] = '\0';
+		var->value = s ? s : "";
 		break;
 	}
 	default:
@@ -289,24 +283,21 @@ static void ScriptCvarWriteSync( CMenuBaseItem *pSelf, void *pExtra )
 	case T_BOOL:
 	{
 		int v = (int)self->CvarValue();
-		Q_strncpy( var->value, v ? "1" : "0", sizeof( var->value ) );
+		var->value = v ? "1" : "0";
 		EngFuncs::CvarSetValue( var->name, (float)v );
 		break;
 	}
 	case T_NUMBER:
 	{
-		char tmp[64];
-		snprintf( tmp, sizeof( tmp ), "%g", self->CvarValue() );
-		Q_strncpy( var->value, tmp, sizeof( var->value ) );
+		var->value.Format( "%g", self->CvarValue() );
 		EngFuncs::CvarSetValue( var->name, self->CvarValue() );
 		break;
 	}
 	case T_STRING:
 	{
 		const char *s = self->CvarString();
-		if( s ) Q_strncpy( var->value, s, sizeof( var->value ) );
-		else var->value[0] = '\0';
-		EngFuncs::CvarSetString( var->name, var->value );
+		var->value = s ? s : "";
+		EngFuncs::CvarSetString( var->name, var->value.String() );
 		break;
 	}
 	default:
@@ -320,7 +311,7 @@ void CMenuScriptConfig::_Init( void )
 	AddButton( L( "Done" ), nullptr, PC_DONE, VoidCb( &CMenuScriptConfig::SaveAndPopMenu ) );
 	AddButton( L( "GameUI_Cancel" ), nullptr, PC_CANCEL, VoidCb( &CMenuScriptConfig::Hide ) );
 
-	if( !m_pVars )
+	if( !m_vars.Count() )
 		return;
 
 	// RemoveItem( unavailable );
@@ -337,8 +328,9 @@ void CMenuScriptConfig::_Init( void )
 	m_iPagesIndex = m_pItems.Count();
 	AddItem( page );
 
-	for( scrvardef_t *var = m_pVars; var; var = var->next )
+	for( int i = 0; i < m_vars.Count(); i++ )
 	{
+		scrvardef_t *var = &m_vars[i];
 		CMenuEditable *editable;
 		CMenuEditable::cvarType_e cvarType;
 
@@ -451,16 +443,13 @@ void CMenuScriptConfig::_Init( void )
 
 void CMenuScriptConfig::SetScriptConfig(const char *path, bool bIsSettings, bool earlyInit)
 {
-	if( m_szConfig && m_pVars && !stricmp( m_szConfig, path ) )
+	if( m_szConfig && m_vars.Count() && !stricmp( m_szConfig, path ) )
 		return; // do nothing
 
 	m_szConfig = path;
 	m_bIsSettingsConfig = bIsSettings;
 
-	if( m_pVars )
-		CSCR_FreeList( m_pVars );
-
-	m_pVars = CSCR_LoadDefaultCVars( m_szConfig, &m_iVarsCount );
+	m_vars.Load( m_szConfig );
 }
 
 void CMenuScriptConfig::FlipMenu( void )
@@ -502,66 +491,60 @@ void UI_LoadScriptConfig()
 
 void UI_SaveScriptConfig()
 {
-	if( menu_serveroptions && menu_serveroptions->m_pVars )
-		CSCR_SaveToFile( "settings.scr", "SERVER_OPTIONS", menu_serveroptions->m_pVars );
-	if( menu_useroptions && menu_useroptions->m_pVars )
-		CSCR_SaveToFile( "user.scr", "INFO_OPTIONS", menu_useroptions->m_pVars );
+	if( menu_serveroptions && menu_serveroptions->m_vars.Count() )
+		menu_serveroptions->m_vars.Save( "settings.scr", "SERVER_OPTIONS" );
+	if( menu_useroptions && menu_useroptions->m_vars.Count() )
+		menu_useroptions->m_vars.Save( "user.scr", "INFO_OPTIONS" );
 }
 
 void UI_ApplyServerSettings()
 {
-	int count = 0;
-	scrvardef_t *vars = CSCR_LoadDefaultCVars( "settings.scr", &count );
-
-	if( !vars || count <= 0 )
-	{
-		if( vars )
-			CSCR_FreeList( vars );
+	CScriptCvarTable file;
+	const CScriptCvarTable *vars = &file;
+
+	// server options menu loads settings.scr on init and saves it back,
+	// so file is read again only if menu doesn't have it
+	if( menu_serveroptions && menu_serveroptions->m_vars.Count() )
+		vars = &menu_serveroptions->m_vars;
+	else if( !file.Load( "settings.scr" ))
 		return;
-	}
 
-	for( scrvardef_t *var = vars; var; var = var->next )
+	for( int i = 0; i < vars->Count(); i++ )
 	{
-		EngFuncs::CvarSetString( var->name, var->value );
+		const scrvardef_t &var = (*vars)[i];
+		EngFuncs::CvarSetString( var.name, var.value.String() );
 	}
-
-	CSCR_FreeList( vars );
 }
 
 const char *UI_GetScriptCvar( const char *name )
 {
-	if( menu_serveroptions && menu_serveroptions->m_pVars )
+	if( menu_serveroptions )
 	{
-		for( scrvardef_t *var = menu_serveroptions->m_pVars; var; var = var->next )
-		{
-			if( !strcmp( var->name, name ) )
-				return var->value;
-		}
+		const scrvardef_t *var = menu_serveroptions->m_vars.Find( name );
+
+		if( var )
+			return var->value.String();
 	}
 	return EngFuncs::GetCvarString( name );
 }
 
 void UI_SetScriptCvar( const char *name, const char *value )
 {
-	if( menu_serveroptions && menu_serveroptions->m_pVars )
+	if( menu_serveroptions )
 	{
-		for( scrvardef_t *var = menu_serveroptions->m_pVars; var; var = var->next )
-		{
-			if( !strcmp( var->name, name ) )
-			{
-				Q_strncpy( var->value, value, sizeof( var->value ) );
-				return;
-			}
-		}
+		scrvardef_t *var = menu_serveroptions->m_vars.Find( name );
+
+		if( var )
+			var->value = value;
 	}
 }
 
 bool UI_AdvUserOptions_IsAvailable()
 {
-	return menu_useroptions->m_pVars != NULL;
+	return menu_useroptions->m_vars.Count() > 0;
 }
 
 bool UI_AdvServerOptions_IsAvailable()
 {
-	return menu_serveroptions->m_pVars != NULL;
+	return menu_serveroptions->m_vars.Count() > 0;
 }
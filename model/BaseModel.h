@@ -24,6 +24,7 @@ enum ECellType
 	CELL_IMAGE_ADDITIVE,
 	CELL_IMAGE_TRANS,
 	CELL_IMAGE_HOLES,
+	CELL_CUSTOM, // drawn by model's DrawCell
 	// CELL_ITEM,
 };
 
@@ -43,13 +44,27 @@ public:
 	virtual void OnActivateEntry( int line ) { }
 	virtual unsigned int GetAlignmentForColumn( int column ) const { return QM_LEFT; }
 	virtual ECellType GetCellType( int line, int column ) { return CELL_TEXT; }
+	// picture of image cell, 0 means it's loaded by path returned from GetCellText
+	virtual HIMAGE GetCellImage( int line, int column ) { return 0; }
 	virtual bool GetLineColor( int line, unsigned int &fillColor, bool &force ) const { return false; }
 	virtual bool GetCellColors( int line, int column, unsigned int &textColor, bool &force ) const { return false; }
 	virtual bool IsCellTextWrapped( int line, int column ) { return true; }
+	virtual void DrawCell( int line, int column, Point pos, Size size, unsigned int color ) { }
+
+	// row caching, table keeps formatted cells while key and version are the same
+	// model must bump version whenever anything in the row changes
+	virtual bool GetRowVersion( int line, int &key, int &version ) const { return false; }
+	// colors of this cell depend on time, they're requested every frame even for cached row
+	virtual bool IsCellAnimated( int line, int column ) const { return false; }
 	// virtual CMenuBaseItem *GetCellItem( int line, int column ) { return NULL; }
 
 	// sorting
 	virtual bool Sort( int column, bool ascend ) { return false; } // false means no sorting support for column
+
+	// type-ahead search, first line after given one which text starts with prefix, or -1
+	virtual int FindNext( const char *prefix, int line ) { return -1; }
+	// table takes letter keys for search only then, otherwise they're button hotkeys
+	virtual bool IsSearchable() const { return false; }
 };
 
 #endif // BASE_MODEL_H
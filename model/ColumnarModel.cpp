@@ -0,0 +1,544 @@
+/*
+ColumnarModel.cpp -- model with typed columns
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "extdll_menu.h"
+#include "BaseMenu.h"
+#include "ColumnarModel.h"
+#include "Utils.h"
+
+// formatted text of removed and changed cells, compacted past this
+#define MAX_TEXT_WASTE 4096
+
+CMenuColumnarModel::CMenuColumnarModel() :
+	m_iLastVersion( 0 ), m_iSortingColumn( -1 ), m_bAscend( true ), m_iSecondaryColumn( -1 ), m_bSecondaryAscend( true ),
+	m_iTextWaste( 0 ), m_iSearchColumn( -1 )
+{
+	RemoveAll();
+}
+
+int CMenuColumnarModel::AddColumn( EColumnType type, ECellType cellType )
+{
+	int i = m_columns.AddToTail();
+
+	m_columns[i].type = type;
+	m_columns[i].cellType = cellType;
+
+	return i;
+}
+
+const char *CMenuColumnarModel::GetCellText( int line, int column )
+{
+	int row = m_order[line];
+	const column_t &col = m_columns[column];
+
+	if( col.cellType == CELL_CUSTOM )
+		return "";
+
+	switch( col.type )
+	{
+	case COLUMN_TYPE_STRING:
+		return GetString( row, column );
+	case COLUMN_TYPE_IMAGE:
+		return GetImage( row, column ) ? "" : NULL;
+	default:
+		break;
+	}
+
+	int &offset = m_cellText[row * m_columns.Count() + column];
+
+	if( offset >= 0 )
+		return m_text.Base() + offset;
+
+	if( m_iTextWaste > MAX_TEXT_WASTE && m_iTextWaste > m_text.Count() / 2 )
+	{
+		// visible rows are formatted again on next frame
+		FOR_EACH_VEC( m_cellText, i )
+			m_cellText[i] = -1;
+
+		m_text.RemoveAll();
+		m_iTextWaste = 0;
+	}
+
+	char buf[64];
+	FormatCell( row, column, buf, sizeof( buf ));
+
+	int len = strlen( buf );
+	offset = m_text.AddMultipleToTail( len + 1 );
+	memcpy( m_text.Base() + offset, buf, len + 1 );
+
+	return m_text.Base() + offset;
+}
+
+ECellType CMenuColumnarModel::GetCellType( int line, int column )
+{
+	return m_columns[column].cellType;
+}
+
+HIMAGE CMenuColumnarModel::GetCellImage( int line, int column )
+{
+	if( m_columns[column].type != COLUMN_TYPE_IMAGE )
+		return 0;
+
+	return GetImage( m_order[line], column );
+}
+
+bool CMenuColumnarModel::GetRowVersion( int line, int &key, int &version ) const
+{
+	key = m_order[line];
+	version = m_versions[key];
+	return true;
+}
+
+void CMenuColumnarModel::FormatCell( int row, int column, char *buf, size_t size ) const
+{
+	if( m_columns[column].type == COLUMN_TYPE_FLOAT )
+		snprintf( buf, size, "%g", GetFloat( row, column ));
+	else snprintf( buf, size, "%i", GetInt( row, column ));
+}
+
+int CMenuColumnarModel::CompareRows( int column, int a, int b ) const
+{
+	const value_t &va = Value( a, column );
+	const value_t &vb = Value( b, column );
+
+	switch( m_columns[column].type )
+	{
+	case COLUMN_TYPE_FLOAT:
+		return ( va.f > vb.f ) - ( va.f < vb.f );
+	case COLUMN_TYPE_STRING:
+		return CompareStrings( va.i, vb.i );
+	default:
+		return ( va.i > vb.i ) - ( va.i < vb.i );
+	}
+}
+
+int CMenuColumnarModel::CompareStrings( int a, int b ) const
+{
+	// same index is the same string
+	if( a == b )
+		return 0;
+
+	const stringinfo_t &sa = m_stringInfo[a];
+	const stringinfo_t &sb = m_stringInfo[b];
+
+	// most names differ in first letters
+	if( sa.prefix != sb.prefix )
+		return sa.prefix < sb.prefix ? -1 : 1;
+
+	return strcmp( m_strings.Base() + sa.key, m_strings.Base() + sb.key );
+}
+
+int CMenuColumnarModel::Compare( int a, int b ) const
+{
+	if( m_iSortingColumn < 0 )
+		return a - b;
+
+	int cmp = CompareRows( m_iSortingColumn, a, b );
+
+	if( !m_bAscend )
+		cmp = -cmp;
+
+	if( !cmp && m_iSecondaryColumn >= 0 && m_iSecondaryColumn != m_iSortingColumn )
+	{
+		cmp = CompareRows( m_iSecondaryColumn, a, b );
+
+		if( !m_bSecondaryAscend )
+			cmp = -cmp;
+	}
+
+	return cmp;
+}
+
+void CMenuColumnarModel::SetSecondarySort( int column, bool ascend )
+{
+	if( column >= m_columns.Count() )
+		column = -1;
+
+	m_iSecondaryColumn = column;
+	m_bSecondaryAscend = ascend;
+}
+
+/*
+=================
+CMenuColumnarModel::Sort
+
+Bottom-up merge sort of the permutation, equal rows keep their
+current order, so sorting by one column and then by another
+gives rows ordered by both. Rows are compared by values and
+precomputed string keys, row data itself never moves.
+=================
+*/
+bool CMenuColumnarModel::Sort( int column, bool ascend )
+{
+	if( column < 0 || column >= m_columns.Count() )
+		column = -1;
+
+	m_iSortingColumn = column;
+	m_bAscend = ascend;
+
+	int count = m_order.Count();
+	int i;
+
+	// most resorts happen after a few changes
+	for( i = 1; i < count; i++ )
+	{
+		if( Compare( m_order[i - 1], m_order[i] ) > 0 )
+			break;
+	}
+
+	if( i >= count )
+		return column >= 0;
+
+	m_sortTemp.SetCount( count );
+
+	int *src = m_order.Base();
+	int *dst = m_sortTemp.Base();
+
+	for( int width = 1; width < count; width *= 2 )
+	{
+		for( int lo = 0; lo < count; lo += width * 2 )
+		{
+			int mid = Q_min( lo + width, count );
+			int hi = Q_min( lo + width * 2, count );
+			int a = lo, b = mid, out = lo;
+
+			while( a < mid && b < hi )
+				dst[out++] = Compare( src[b], src[a] ) < 0 ? src[b++] : src[a++];
+
+			while( a < mid )
+				dst[out++] = src[a++];
+
+			while( b < hi )
+				dst[out++] = src[b++];
+		}
+
+		int *temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if( src != m_order.Base() )
+		memcpy( m_order.Base(), src, count * sizeof( int ));
+
+	UpdateLines( 0, count - 1 );
+
+	return column >= 0;
+}
+
+void CMenuColumnarModel::UpdateLines( int first, int last )
+{
+	for( int i = first; i <= last; i++ )
+		m_lines[m_order[i]] = i;
+}
+
+void CMenuColumnarModel::SetSearchColumn( int column )
+{
+	m_iSearchColumn = column;
+	m_search.Invalidate();
+}
+
+int CMenuColumnarModel::FindNext( const char *prefix, int line )
+{
+	if( m_iSearchColumn < 0 )
+		return -1;
+
+	if( !m_search.IsValid() )
+	{
+		m_search.Clear();
+
+		for( int row = 0; row < RowCount(); row++ )
+			m_search.Add( row, GetString( row, m_iSearchColumn ));
+	}
+
+	return m_search.FindNext( prefix, line, m_order.Count(), m_lines.Base() );
+}
+
+int CMenuColumnarModel::AddRow( void )
+{
+	int row = m_versions.AddToTail( ++m_iLastVersion );
+
+	FOR_EACH_VEC( m_columns, i )
+	{
+		CUtlVector<value_t> &values = m_columns[i].values;
+
+		values[values.AddToTail()].i = 0; // zero int and float, empty string, no image
+	}
+
+	int text = m_cellText.AddMultipleToTail( m_columns.Count() );
+
+	for( int i = 0; i < m_columns.Count(); i++ )
+		m_cellText[text + i] = -1;
+
+	m_lines.AddToTail( m_order.AddToTail( row ));
+
+	return row;
+}
+
+void CMenuColumnarModel::RemoveRow( int row )
+{
+	int last = RowCount() - 1;
+	int columns = m_columns.Count();
+
+	DropText( row );
+	m_search.Remove( row );
+
+	int line = m_lines[row];
+	m_order.Remove( line );
+	UpdateLines( line, m_order.Count() - 1 );
+
+	if( row != last )
+	{
+		FOR_EACH_VEC( m_columns, i )
+			m_columns[i].values[row] = m_columns[i].values[last];
+
+		for( int i = 0; i < columns; i++ )
+			m_cellText[row * columns + i] = m_cellText[last * columns + i];
+
+		// another row now, table must not reuse cached cells
+		m_versions[row] = ++m_iLastVersion;
+		m_order[m_lines[last]] = row;
+		m_lines[row] = m_lines[last];
+		m_search.Renumber( last, row );
+	}
+
+	FOR_EACH_VEC( m_columns, i )
+		m_columns[i].values.Remove( last );
+
+	m_cellText.RemoveMultiple( last * columns, columns );
+	m_versions.Remove( last );
+	m_lines.Remove( last );
+}
+
+void CMenuColumnarModel::RemoveAll( void )
+{
+	FOR_EACH_VEC( m_columns, i )
+		m_columns[i].values.RemoveAll();
+
+	m_versions.RemoveAll();
+	m_order.RemoveAll();
+	m_lines.RemoveAll();
+	m_search.Invalidate();
+	m_cellText.RemoveAll();
+	m_text.RemoveAll();
+	m_iTextWaste = 0;
+
+	m_strings.RemoveAll();
+	m_strings.AddToTail( 0 );
+	m_stringTable.RemoveAll();
+	m_stringInfo.RemoveAll();
+
+	stringinfo_t &empty = m_stringInfo[m_stringInfo.AddToTail()];
+	empty.text = empty.key = 0;
+	empty.prefix = 0;
+}
+
+void CMenuColumnarModel::SetValue( int row, int column, value_t value )
+{
+	value_t &old = m_columns[column].values[row];
+
+	// compare bits, so float that didn't change doesn't bump version
+	if( old.i == value.i )
+		return;
+
+	// new rows have empty strings, which aren't in the index
+	if( column == m_iSearchColumn && old.i )
+		m_search.Remove( row );
+
+	old = value;
+	Touch( row );
+
+	if( column == m_iSearchColumn )
+		m_search.Add( row, GetString( row, column ));
+}
+
+void CMenuColumnarModel::SetInt( int row, int column, int value )
+{
+	value_t v;
+	v.i = value;
+	SetValue( row, column, v );
+}
+
+void CMenuColumnarModel::SetFloat( int row, int column, float value )
+{
+	value_t v;
+	v.f = value;
+	SetValue( row, column, v );
+}
+
+void CMenuColumnarModel::SetString( int row, int column, const char *value )
+{
+	value_t v;
+	v.i = Intern( value );
+	SetValue( row, column, v );
+}
+
+void CMenuColumnarModel::SetImage( int row, int column, HIMAGE value )
+{
+	value_t v;
+	v.i = value;
+	SetValue( row, column, v );
+}
+
+void CMenuColumnarModel::Touch( int row )
+{
+	m_versions[row] = ++m_iLastVersion;
+	DropText( row );
+}
+
+void CMenuColumnarModel::DropText( int row )
+{
+	int columns = m_columns.Count();
+
+	for( int i = row * columns; i < ( row + 1 ) * columns; i++ )
+	{
+		if( m_cellText[i] < 0 )
+			continue;
+
+		m_iTextWaste += strlen( m_text.Base() + m_cellText[i] ) + 1;
+		m_cellText[i] = -1;
+	}
+}
+
+void CMenuColumnarModel::Reposition( int row )
+{
+	if( m_iSortingColumn < 0 )
+		return;
+
+	int line = m_lines[row];
+	int last = m_order.Count() - 1;
+
+	// most changes don't affect the order
+	if(( line == 0 || Compare( m_order[line - 1], row ) <= 0 ) &&
+		( line == last || Compare( row, m_order[line + 1] ) <= 0 ))
+		return;
+
+	m_order.Remove( line );
+
+	int lo = 0, hi = m_order.Count();
+
+	// after all rows that are equal to it
+	while( lo < hi )
+	{
+		int mid = ( lo + hi ) / 2;
+
+		if( Compare( m_order[mid], row ) <= 0 )
+			lo = mid + 1;
+		else hi = mid;
+	}
+
+	m_order.InsertBefore( lo, row );
+	UpdateLines( Q_min( line, lo ), Q_max( line, lo ));
+}
+
+static unsigned int HashString( const char *s )
+{
+	unsigned int hash = 0x811C9DC5u;
+
+	for( ; *s; s++ )
+		hash = ( hash ^ (byte)*s ) * 0x01000193u;
+
+	return hash;
+}
+
+/*
+=================
+CMenuColumnarModel::Intern
+
+New string gets its sort key once, so sorting by text columns
+doesn't strip color codes and fold case on every comparison.
+=================
+*/
+int CMenuColumnarModel::Intern( const char *s )
+{
+	if( !s || !*s )
+		return 0;
+
+	// keep load factor under a half
+	if( m_stringInfo.Count() * 2 >= m_stringTable.Count() )
+	{
+		CUtlVector<int> table;
+
+		table.SetCount( Q_max( 64, m_stringTable.Count() * 2 ));
+		FOR_EACH_VEC( table, i )
+			table[i] = -1;
+
+		FOR_EACH_VEC( m_stringTable, i )
+		{
+			int index = m_stringTable[i];
+
+			if( index < 0 )
+				continue;
+
+			int mask = table.Count() - 1;
+			int slot = HashString( m_strings.Base() + m_stringInfo[index].text ) & mask;
+
+			while( table[slot] >= 0 )
+				slot = ( slot + 1 ) & mask;
+
+			table[slot] = index;
+		}
+
+		m_stringTable.Swap( table );
+	}
+
+	int mask = m_stringTable.Count() - 1;
+	int slot = HashString( s ) & mask;
+
+	for( ; m_stringTable[slot] >= 0; slot = ( slot + 1 ) & mask )
+	{
+		if( !strcmp( s, m_strings.Base() + m_stringInfo[m_stringTable[slot]].text ))
+			return m_stringTable[slot];
+	}
+
+	// text and key next to each other, key is never longer
+	int len = strlen( s );
+	int text = m_strings.AddMultipleToTail( len * 2 + 2 );
+	char *key = m_strings.Base() + text + len + 1;
+	int keyLen = 0;
+
+	memcpy( m_strings.Base() + text, s, len + 1 );
+
+	for( ; *s; s++ )
+	{
+		if( IsColorString( s ))
+		{
+			s++;
+			continue;
+		}
+
+		char c = *s;
+
+		if( c >= 'a' && c <= 'z' )
+			c -= 'a' - 'A';
+
+		key[keyLen++] = c;
+	}
+
+	key[keyLen] = 0;
+
+	int index = m_stringInfo.AddToTail();
+	stringinfo_t &info = m_stringInfo[index];
+
+	info.text = text;
+	info.key = text + len + 1;
+	info.prefix = 0;
+
+	for( int i = 0; i < 4; i++ )
+		info.prefix = info.prefix << 8 | ( i < keyLen ? (byte)key[i] : 0 );
+
+	m_stringTable[slot] = index;
+
+	return index;
+}
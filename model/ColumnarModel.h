@@ -0,0 +1,166 @@
+/*
+ColumnarModel.h -- model with typed columns
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef COLUMNAR_MODEL_H
+#define COLUMNAR_MODEL_H
+
+#include "BaseModel.h"
+#include "SearchIndex.h"
+#include "utlvector.h"
+
+enum EColumnType
+{
+	COLUMN_TYPE_INT = 0,
+	COLUMN_TYPE_FLOAT,
+	COLUMN_TYPE_STRING, // interned, same strings are stored once with their sort key
+	COLUMN_TYPE_IMAGE,  // picture handle, 0 draws nothing
+};
+
+/*
+ * Values are kept per column, so numbers stay numbers until the table
+ * asks for the cell. Formatted text is kept until the row changes.
+ * Any column can be sorted, lines are a stable sorted permutation of rows.
+ *
+ * Row is an index in storage and stays the same while lines move.
+ * RemoveRow moves the last row in place of removed one, just like
+ * CUtlVector::FastRemove, so subclass keeping its own per-row data
+ * should remove it with FastRemove too.
+ */
+class CMenuColumnarModel : public CMenuBaseModel
+{
+public:
+	CMenuColumnarModel();
+
+	// all columns are added before any rows, returns column index
+	int AddColumn( EColumnType type, ECellType cellType = CELL_TEXT );
+
+	int GetColumns() const override { return m_columns.Count(); }
+	int GetRows() const override { return m_order.Count(); }
+
+	// numbers are formatted on first request, text is valid until next call
+	const char *GetCellText( int line, int column ) override;
+	ECellType GetCellType( int line, int column ) override;
+	HIMAGE GetCellImage( int line, int column ) override;
+	bool GetRowVersion( int line, int &key, int &version ) const override;
+
+	// -1 restores the order rows were added in
+	bool Sort( int column, bool ascend ) override;
+
+	// orders rows that are equal in sorting column, -1 keeps their order
+	void SetSecondarySort( int column, bool ascend );
+
+	// searches in string column set by SetSearchColumn
+	int FindNext( const char *prefix, int line ) override;
+	bool IsSearchable() const override { return m_iSearchColumn >= 0; }
+	void SetSearchColumn( int column );
+
+	// new row is the last line, call Reposition after setting its values
+	int AddRow( void );
+	void RemoveRow( int row );
+	void RemoveAll( void );
+
+	int RowCount( void ) const { return m_versions.Count(); }
+	int Row( int line ) const { return m_order[line]; }
+	int Line( int row ) const { return m_lines[row]; }
+	bool IsValidLine( int line ) const { return m_order.IsValidIndex( line ); }
+
+	// row version is bumped only when value is different
+	void SetInt( int row, int column, int value );
+	void SetFloat( int row, int column, float value );
+	void SetString( int row, int column, const char *value );
+	void SetImage( int row, int column, HIMAGE value );
+
+	int GetInt( int row, int column ) const { return Value( row, column ).i; }
+	float GetFloat( int row, int column ) const { return Value( row, column ).f; }
+	const char *GetString( int row, int column ) const { return m_strings.Base() + m_stringInfo[Value( row, column ).i].text; }
+	HIMAGE GetImage( int row, int column ) const { return Value( row, column ).i; }
+
+	// moves changed row to its place, rows equal to it are not passed
+	void Reposition( int row );
+
+	// sorts again after many changes, lines already in order don't move
+	void Resort( void ) { Sort( m_iSortingColumn, m_bAscend ); }
+
+	int GetSortingColumn( void ) const { return m_iSortingColumn; }
+	bool IsAscend( void ) const { return m_bAscend; }
+
+protected:
+	// int and float cells, "%i" and "%g" by default
+	virtual void FormatCell( int row, int column, char *buf, size_t size ) const;
+
+	// negative if row a goes before b in ascending order
+	virtual int CompareRows( int column, int a, int b ) const;
+
+	// for changes of data that isn't stored in columns but affects the text
+	void Touch( int row );
+
+private:
+	union value_t
+	{
+		int i;
+		float f;
+	};
+
+	struct stringinfo_t
+	{
+		int text; // offsets in m_strings
+		int key;  // without color codes and in upper case, compared like colorstricmp
+		unsigned int prefix; // first four bytes of key, most significant first
+	};
+
+	struct column_t
+	{
+		EColumnType type;
+		ECellType cellType;
+		CUtlVector<value_t> values;
+	};
+
+	const value_t &Value( int row, int column ) const { return m_columns[column].values[row]; }
+	void SetValue( int row, int column, value_t value );
+	void DropText( int row );
+	int Compare( int a, int b ) const;
+	int CompareStrings( int a, int b ) const;
+	void UpdateLines( int first, int last );
+	int Intern( const char *s );
+
+	CUtlVector<column_t> m_columns;
+	CUtlVector<int> m_versions; // per row
+	int m_iLastVersion;
+
+	CUtlVector<int> m_order; // line -> row
+	CUtlVector<int> m_lines; // row -> line
+	CUtlVector<int> m_sortTemp;
+	int m_iSortingColumn;
+	bool m_bAscend;
+	int m_iSecondaryColumn;
+	bool m_bSecondaryAscend;
+
+	// formatted cells, offset in m_text per row and column or -1
+	CUtlVector<int> m_cellText;
+	CUtlVector<char> m_text;
+	int m_iTextWaste;
+
+	// interned strings, values of string cells are indices in m_stringInfo
+	// open addressing table of the same indices, empty string is always 0
+	CUtlVector<char> m_strings;
+	CUtlVector<stringinfo_t> m_stringInfo;
+	CUtlVector<int> m_stringTable;
+
+	// filled on first search, then follows the changes
+	CMenuSearchIndex m_search;
+	int m_iSearchColumn;
+};
+
+#endif // COLUMNAR_MODEL_H
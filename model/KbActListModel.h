@@ -17,9 +17,12 @@ GNU General Public License for more details.
 #define KBACTLISTMODEL_H
 
 #include "BaseModel.h"
+#include "SearchIndex.h"
+#include "ParsedFile.h"
 #include "Utils.h"
 #include "enginecallback_menu.h"
 #include "utlvector.h"
+#include "utlhashmap.h"
 
 // Shared model over gfx/shell/kb_act.lst, the list of game actions used
 // for the keyboard configuration screen and (read-only) the touch button
@@ -44,31 +47,37 @@ public:
 		char bind[64];     // empty when entry is a separator
 		char first[20];    // formatted first bound key  (VIEW_BINDINGS only)
 		char second[20];   // formatted second bound key (VIEW_BINDINGS only)
+		int keys[2];       // same keys, -1 if not bound (VIEW_BINDINGS only)
 	};
 
 	void Update() override
 	{
+		PROFILE_SCOPE( "CMenuKbActListModel::Update" );
+
 		entries.RemoveAll();
+		m_actions.RemoveAll();
+		m_search.Invalidate();
 
 		if( m_view == VIEW_PICKER )
 			AddVirtualCommands();
 
-		char *afile = (char *)EngFuncs::COM_LoadFile( "gfx/shell/kb_act.lst", NULL );
-		if( !afile )
+		const CParsedFile *file = UI_LoadParsedFile( "gfx/shell/kb_act.lst" );
+		if( !file )
 			return;
 
-		char *pfile = afile;
-		char token[64];
+		CTokenReader reader( file );
+		const char *token;
 
-		while(( pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ))) != NULL )
+		while(( token = reader.Next( )) != NULL )
 		{
 			entry_t e = { 0 };
+			e.keys[0] = e.keys[1] = -1;
 
 			if( !stricmp( token, "blank" ))
 			{
 				// separator: next token is the label
-				pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ));
-				if( !pfile )
+				token = reader.Next();
+				if( !token )
 					break;
 
 				FormatLabel( token, e.display, sizeof( e.display ));
@@ -77,25 +86,93 @@ public:
 			{
 				Q_strncpy( e.bind, token, sizeof( e.bind ));
 
-				pfile = EngFuncs::COM_ParseFile( pfile, token, sizeof( token ));
-				if( !pfile )
+				token = reader.Next();
+				if( !token )
 					break;
 
 				FormatLabel( token, e.display, sizeof( e.display ));
-
-				if( m_view == VIEW_BINDINGS )
-				{
-					int keys[2];
-					LookupBoundKeys( e.bind, keys );
-					FormatKey( keys[0], e.first, sizeof( e.first ));
-					FormatKey( keys[1], e.second, sizeof( e.second ));
-				}
 			}
 
 			entries.AddToTail( e );
 		}
 
-		EngFuncs::COM_FreeFile( afile );
+		// entries don't move anymore, names can be keys
+		FOR_EACH_VEC( entries, i )
+		{
+			if( IsLineUsable( i ) && !m_actions.HasElement( entries[i].bind ))
+				m_actions.Insert( entries[i].bind, i );
+		}
+
+		if( m_view == VIEW_BINDINGS )
+			UpdateBindings();
+	}
+
+	/*
+	 * Reads bindings of all keys in one pass, so every action gets its
+	 * keys without walking the keys again. Call after many bindings were
+	 * changed at once, for one key there is UpdateKey.
+	 */
+	void UpdateBindings()
+	{
+		m_keyLines.RemoveAll();
+
+		for( int key = 0; ; key++ )
+		{
+			if( !strcmp( EngFuncs::KeynumToString( key ), "<OUT OF RANGE>" ))
+				break;
+
+			m_keyLines.AddToTail( FindAction( EngFuncs::KEY_GetBinding( key )));
+		}
+
+		FOR_EACH_VEC( entries, i )
+			CollectKeys( i );
+	}
+
+	// binding of this key has changed, updates action it was bound to and the new one
+	void UpdateKey( int key )
+	{
+		if( !m_keyLines.IsValidIndex( key ))
+			return;
+
+		int oldLine = m_keyLines[key];
+		int newLine = FindAction( EngFuncs::KEY_GetBinding( key ));
+
+		m_keyLines[key] = newLine;
+
+		if( oldLine >= 0 )
+			CollectKeys( oldLine );
+
+		if( newLine >= 0 && newLine != oldLine )
+			CollectKeys( newLine );
+	}
+
+	// line of action with this command, or -1
+	int FindAction( const char *command ) const
+	{
+		if( !command || !command[0] )
+			return -1;
+
+		int i = m_actions.Find( command );
+
+		return m_actions.IsValidIndex( i ) ? m_actions[i] : -1;
+	}
+
+	// line of action the key is bound to, or -1
+	int GetKeyLine( int key ) const
+	{
+		return m_keyLines.IsValidIndex( key ) ? m_keyLines[key] : -1;
+	}
+
+	// walks all keys bound to the action, starting after given key, -1 at the end
+	int NextBoundKey( int line, int key ) const
+	{
+		for( key++; key < m_keyLines.Count(); key++ )
+		{
+			if( m_keyLines[key] == line )
+				return key;
+		}
+
+		return -1;
 	}
 
 	int GetColumns() const override { return m_view == VIEW_BINDINGS ? 3 : 2; }
@@ -121,40 +198,28 @@ public:
 		return IsLineUsable( line );
 	}
 
-	bool IsLineUsable( int line ) const
-	{
-		return entries.IsValidIndex( line ) && entries[line].bind[0] != 0;
-	}
-
-	// Walk all keys, return up to two bound to `command` (in input order, then swapped).
-	static void LookupBoundKeys( const char *command, int twoKeys[2] )
+	// searches action names, separators are skipped
+	int FindNext( const char *prefix, int line ) override
 	{
-		twoKeys[0] = twoKeys[1] = -1;
-
-		for( int i = 0, count = 0; ; i++ )
+		if( !m_search.IsValid() )
 		{
-			const char *str = EngFuncs::KeynumToString( i );
-			if( !strcmp( str, "<OUT OF RANGE>" ))
-				break;
-
-			const char *b = EngFuncs::KEY_GetBinding( i );
-			if( !b )
-				continue;
+			m_search.Clear();
 
-			if( !stricmp( command, b ))
+			FOR_EACH_VEC( entries, i )
 			{
-				twoKeys[count++] = i;
-				if( count == 2 )
-					break;
+				if( IsLineUsable( i ))
+					m_search.Add( i, entries[i].display );
 			}
 		}
 
-		if( twoKeys[0] != -1 && twoKeys[1] != -1 )
-		{
-			int tmp = twoKeys[1];
-			twoKeys[1] = twoKeys[0];
-			twoKeys[0] = tmp;
-		}
+		return m_search.FindNext( prefix, line, entries.Count() );
+	}
+
+	bool IsSearchable() const override { return true; }
+
+	bool IsLineUsable( int line ) const
+	{
+		return entries.IsValidIndex( line ) && entries[line].bind[0] != 0;
 	}
 
 	CUtlVector<entry_t> entries;
@@ -162,7 +227,33 @@ public:
 protected:
 	EView m_view;
 
+	CMenuSearchIndex m_search;
+
+	// bind command -> line
+	// key -> line of action it's bound to or -1 (VIEW_BINDINGS only)
+	CUtlHashMap<const char *, int, CaselessStringEqualFunctor, CaselessStringHashFunctor> m_actions;
+	CUtlVector<int> m_keyLines;
+
 private:
+	// first two keys bound to the action, second one shown first
+	void CollectKeys( int line )
+	{
+		entry_t &e = entries[line];
+
+		e.keys[0] = e.keys[1] = -1;
+
+		for( int key = NextBoundKey( line, -1 ); key >= 0 && e.keys[1] < 0; key = NextBoundKey( line, key ))
+		{
+			if( e.keys[0] >= 0 )
+				e.keys[1] = e.keys[0];
+
+			e.keys[0] = key;
+		}
+
+		FormatKey( e.keys[0], e.first, sizeof( e.first ));
+		FormatKey( e.keys[1], e.second, sizeof( e.second ));
+	}
+
 	void AddVirtualCommands()
 	{
 		// Engine-side virtual commands handled directly by Touch_SetCommand:
@@ -182,6 +273,7 @@ private:
 	void AddLabel( const char *label )
 	{
 		entry_t e = { 0 };
+		e.keys[0] = e.keys[1] = -1;
 		FormatLabel( label, e.display, sizeof( e.display ));
 		entries.AddToTail( e );
 	}
@@ -189,6 +281,7 @@ private:
 	void AddVirtualCommand( const char *bind, const char *label )
 	{
 		entry_t e = { 0 };
+		e.keys[0] = e.keys[1] = -1;
 		Q_strncpy( e.bind, bind, sizeof( e.bind ));
 		FormatLabel( label, e.display, sizeof( e.display ));
 		entries.AddToTail( e );
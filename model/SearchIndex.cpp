@@ -0,0 +1,257 @@
+/*
+SearchIndex.cpp -- type-ahead search over one column of a model
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "extdll_menu.h"
+#include "BaseMenu.h"
+#include "SearchIndex.h"
+
+// text of removed entries, index is dropped past this and filled again
+#define MAX_TEXT_WASTE 4096
+
+static inline bool IsWordChar( char c )
+{
+	// bytes of multibyte characters are letters too
+	return (byte)c >= 0x80 || ( c >= '0' && c <= '9' ) || ( c >= 'a' && c <= 'z' );
+}
+
+/*
+=================
+CMenuSearchIndex::Normalize
+
+Strips color codes and lowers case, same rules colorstricmp uses.
+=================
+*/
+int CMenuSearchIndex::Normalize( const char *in, char *out, int size )
+{
+	int len = 0;
+
+	while( *in && len < size - 1 )
+	{
+		if( IsColorString( in ))
+		{
+			in += 2;
+			continue;
+		}
+
+		char c = *in++;
+
+		if( c >= 'A' && c <= 'Z' )
+			c += 'a' - 'A';
+
+		out[len++] = c;
+	}
+
+	out[len] = 0;
+	return len;
+}
+
+void CMenuSearchIndex::Invalidate( void )
+{
+	Clear();
+	m_bValid = false;
+}
+
+void CMenuSearchIndex::Clear( void )
+{
+	m_text.RemoveAll();
+	m_entries.RemoveAll();
+	m_iSorted = 0;
+	m_iWaste = 0;
+	m_bValid = true;
+}
+
+void CMenuSearchIndex::Add( int id, const char *text )
+{
+	// owner fills everything again anyway
+	if( !m_bValid || !text )
+		return;
+
+	char buf[256];
+	int len = Normalize( text, buf, sizeof( buf ));
+
+	if( !len )
+		return;
+
+	int offset = m_text.AddMultipleToTail( len + 1 );
+	memcpy( m_text.Base() + offset, buf, len + 1 );
+
+	for( int i = 0; i < len; i++ )
+	{
+		if( !IsWordChar( buf[i] ) || ( i > 0 && IsWordChar( buf[i - 1] )))
+			continue;
+
+		entry_t &e = m_entries[m_entries.AddToTail()];
+		e.text = offset + i;
+		e.id = id;
+		e.whole = i == 0;
+	}
+}
+
+void CMenuSearchIndex::Remove( int id )
+{
+	if( !m_bValid )
+		return;
+
+	int count = 0;
+	int sorted = m_iSorted;
+
+	FOR_EACH_VEC( m_entries, i )
+	{
+		const entry_t &e = m_entries[i];
+
+		if( e.id != id )
+		{
+			m_entries[count++] = e;
+			continue;
+		}
+
+		if( e.whole )
+			m_iWaste += strlen( m_text.Base() + e.text ) + 1;
+
+		if( i < sorted )
+			m_iSorted--;
+	}
+
+	m_entries.SetCount( count );
+
+	if( m_iWaste > MAX_TEXT_WASTE && m_iWaste > m_text.Count() / 2 )
+		Invalidate();
+}
+
+void CMenuSearchIndex::Renumber( int from, int to )
+{
+	FOR_EACH_VEC( m_entries, i )
+	{
+		if( m_entries[i].id == from )
+			m_entries[i].id = to;
+	}
+}
+
+void CMenuSearchIndex::Merge( const entry_t *src, entry_t *dst, int lo, int mid, int hi ) const
+{
+	const char *text = m_text.Base();
+	int a = lo, b = mid, out = lo;
+
+	while( a < mid && b < hi )
+		dst[out++] = strcmp( text + src[b].text, text + src[a].text ) < 0 ? src[b++] : src[a++];
+
+	while( a < mid )
+		dst[out++] = src[a++];
+
+	while( b < hi )
+		dst[out++] = src[b++];
+}
+
+/*
+=================
+CMenuSearchIndex::SortPending
+
+Sorts entries added since last lookup and merges them with the rest,
+so adding one row costs one pass instead of sorting everything again.
+=================
+*/
+void CMenuSearchIndex::SortPending( void )
+{
+	int count = m_entries.Count();
+	int sorted = m_iSorted;
+
+	if( sorted >= count )
+		return;
+
+	m_temp.SetCount( count );
+
+	entry_t *src = m_entries.Base();
+	entry_t *dst = m_temp.Base();
+
+	for( int width = 1; width < count - sorted; width *= 2 )
+	{
+		for( int lo = sorted; lo < count; lo += width * 2 )
+			Merge( src, dst, lo, Q_min( lo + width, count ), Q_min( lo + width * 2, count ));
+
+		entry_t *temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if( src != m_entries.Base() )
+		memcpy( m_entries.Base() + sorted, src + sorted, ( count - sorted ) * sizeof( entry_t ));
+
+	if( sorted > 0 )
+	{
+		Merge( m_entries.Base(), m_temp.Base(), 0, sorted, count );
+		m_entries.Swap( m_temp );
+	}
+
+	m_iSorted = count;
+}
+
+int CMenuSearchIndex::LowerBound( const char *prefix, int len, bool inside ) const
+{
+	const char *text = m_text.Base();
+	int lo = 0, hi = m_entries.Count();
+
+	// first entry starting with prefix, or first entry past them
+	while( lo < hi )
+	{
+		int mid = ( lo + hi ) / 2;
+		int cmp = strncmp( text + m_entries[mid].text, prefix, len );
+
+		if( cmp < 0 || ( inside && cmp == 0 ))
+			lo = mid + 1;
+		else hi = mid;
+	}
+
+	return lo;
+}
+
+int CMenuSearchIndex::FindNext( const char *prefix, int line, int lines, const int *lineOfId )
+{
+	if( !m_bValid || lines <= 0 )
+		return -1;
+
+	char buf[64];
+	int len = Normalize( prefix, buf, sizeof( buf ));
+
+	if( !len )
+		return -1;
+
+	SortPending();
+
+	int first = LowerBound( buf, len, false );
+	int last = LowerBound( buf, len, true );
+	int best = -1, bestDist = lines;
+	bool bestWhole = false;
+
+	for( int i = first; i < last; i++ )
+	{
+		const entry_t &e = m_entries[i];
+		int l = lineOfId ? lineOfId[e.id] : e.id;
+
+		if( l < 0 || l >= lines )
+			continue;
+
+		// distance from current line, going down and wrapping around
+		int dist = (( l - line - 1 ) % lines + lines ) % lines;
+
+		if(( e.whole && !bestWhole ) || ( e.whole == bestWhole && dist < bestDist ))
+		{
+			best = l;
+			bestDist = dist;
+			bestWhole = e.whole;
+		}
+	}
+
+	return best;
+}
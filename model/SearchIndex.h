@@ -0,0 +1,76 @@
+/*
+SearchIndex.h -- type-ahead search over one column of a model
+Copyright (C) 2026 a1batross
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+#pragma once
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include "utlvector.h"
+
+/*
+ * Keeps text of every entry without color codes and in lower case,
+ * and a sorted array of its word beginnings. Text starting with the
+ * prefix is a contiguous range there, so lookup is a binary search.
+ * Matching a word beginning makes "dust" find "de_dust2".
+ *
+ * Id is whatever owner uses to address entries, usually a row.
+ * Added entries are sorted in on next lookup.
+ */
+class CMenuSearchIndex
+{
+public:
+	CMenuSearchIndex() : m_iSorted( 0 ), m_iWaste( 0 ), m_bValid( false ) { }
+
+	// invalid index must be filled again by owner before next lookup
+	bool IsValid( void ) const { return m_bValid; }
+	void Invalidate( void );
+
+	// empty and valid, ready for adding
+	void Clear( void );
+
+	void Add( int id, const char *text );
+	void Remove( int id );
+
+	// for owners moving the last entry in place of removed one
+	void Renumber( int from, int to );
+
+	/*
+	 * Returns line of first match after given one, wrapping around,
+	 * or -1. Matches from the start of text go before word matches.
+	 * lineOfId maps ids to lines, NULL if they're the same.
+	 */
+	int FindNext( const char *prefix, int line, int lines, const int *lineOfId = NULL );
+
+private:
+	struct entry_t
+	{
+		int text;  // offset of word in m_text
+		int id;
+		bool whole; // word is the beginning of text
+	};
+
+	static int Normalize( const char *in, char *out, int size );
+	void SortPending( void );
+	void Merge( const entry_t *src, entry_t *dst, int lo, int mid, int hi ) const;
+	int LowerBound( const char *prefix, int len, bool inside ) const;
+
+	CUtlVector<char> m_text;
+	CUtlVector<entry_t> m_entries;
+	CUtlVector<entry_t> m_temp;
+	int m_iSorted; // entries past this are added after last lookup
+	int m_iWaste;  // text of removed entries
+	bool m_bValid;
+};
+
+#endif // SEARCHINDEX_H